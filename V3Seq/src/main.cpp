@@ -6,24 +6,204 @@
 #include <cmath>
 #include <cstring>
 
+#include "seq_common.h"
+
 // V3Seq: Single 3-output CV sequencer
 // - Clock and Reset inputs
 // - 3 CV outputs with configurable voltage ranges (0-5V, 0-10V, -5V to +5V, -10V to +10V)
 // - 3 MIDI CC outputs
-// - 32 steps with 3 values per step
+// - 32-128 steps with 3 values per step (Max Steps specification), stored in DRAM
 // - First Step and Last Step parameters define active sequence range
 // - Direction control: Forward, Backward, Pingpong
 // - Section looping with configurable repeats
 // - Clock division and multiplication (31 options)
 // - UI with page-based bar display (one page per CV output)
 // - Coarse (25 steps) and Fine (500 steps) adjustment modes
+// - Follows a CV clock, 24 PPQN MIDI clock, or either
+// - MIDI Start/Stop/Continue and Song Position Pointer
+// - Per-output glide (linear or exponential), on every step or only on marked steps
+// - Live CV recording into the steps, sampled on the exact frame of each clock edge
+// - Audio-rate mode: clocked from an oscillator, per-sample steps with polyBLEP jumps
+// - CV address mode: an input voltage picks the step directly (Buchla-style)
+
+// Glide state of one output.
+// A glide is set up once per step change with its per-sample increment (linear)
+// or per-sample decay (exponential), then rendered four frames at a time.
+struct Glide {
+    float value;                // Output voltage at the end of the last rendered frame
+    float target;               // Voltage of the current step
+    int remaining;              // Samples left in the glide (0 = settled on target)
+    bool exponential;           // Shape of the glide in progress
+    float increment;            // Linear: volts per sample
+    float decay[4];             // Exponential: k, k^2, k^3, k^4 for one 4-frame chunk
+    
+    Glide() {
+        value = 0.0f;
+        target = 0.0f;
+        remaining = 0;
+        exponential = false;
+        increment = 0.0f;
+        for (int i = 0; i < 4; i++) decay[i] = 0.0f;
+    }
+    
+    // Jump straight to a voltage
+    void set(float v) {
+        value = v;
+        target = v;
+        remaining = 0;
+    }
+    
+    // Glide from the current value to v over the given number of samples
+    void start(float v, int samples, bool expShape) {
+        target = v;
+        remaining = samples;
+        exponential = expShape;
+        increment = (target - value) / samples;
+        
+        // Exponential: fall to e^-7 (0.1%) of the distance by the end, then snap
+        float k = expf(-7.0f / samples);
+        decay[0] = k;
+        decay[1] = k * k;
+        decay[2] = decay[1] * k;
+        decay[3] = decay[2] * k;
+    }
+    
+    // The step's value changed while gliding (edit, range change): keep the time left
+    void retarget(float v) {
+        target = v;
+        if (remaining > 0) increment = (target - value) / remaining;
+    }
+    
+    // Write numFrames frames (a block, or the part of one between two steps).
+    // Settled outputs take the plain fill path.
+    void render(float* out, int numFrames) {
+        int frame = 0;
+        
+        if (remaining > 0) {
+            // Whole 4-frame chunks of the glide
+            int chunks = remaining / 4;
+            if (chunks > numFrames / 4) chunks = numFrames / 4;
+            if (exponential) {
+                float d = value - target;
+                for (int i = 0; i < chunks; i++, frame += 4) {
+                    out[frame + 0] = target + (d * decay[0]);
+                    out[frame + 1] = target + (d * decay[1]);
+                    out[frame + 2] = target + (d * decay[2]);
+                    out[frame + 3] = target + (d * decay[3]);
+                    d *= decay[3];
+                }
+                value = target + d;
+            } else {
+                float y = value;
+                float inc = increment;
+                for (int i = 0; i < chunks; i++, frame += 4) {
+                    out[frame + 0] = y + inc;
+                    out[frame + 1] = y + (2.0f * inc);
+                    out[frame + 2] = y + (3.0f * inc);
+                    out[frame + 3] = y + (4.0f * inc);
+                    y += 4.0f * inc;
+                }
+                value = y;
+            }
+            remaining -= chunks * 4;
+            
+            // Last few samples of the glide, one at a time
+            while (remaining > 0 && frame < numFrames) {
+                value = exponential ? target + ((value - target) * decay[0]) : value + increment;
+                out[frame++] = value;
+                remaining--;
+            }
+            if (remaining == 0) value = target;  // Land exactly
+        }
+        
+        for (; frame < numFrames; frame++) {
+            out[frame] = value;
+        }
+    }
+    
+    // Move through a block without writing it
+    void skip(int numFrames) {
+        if (remaining <= 0) return;
+        int n = (numFrames < remaining) ? numFrames : remaining;
+        value = exponential ? target + ((value - target) * powf(decay[0], (float)n)) : value + (increment * n);
+        remaining -= n;
+        if (remaining == 0) value = target;
+    }
+};
+
+// Real-time safe edits of the step values.
+// The UI queues relative edits (encoder turns) in a single-producer/single-consumer
+// log and publishes them with one index store; step() applies them at the start of
+// a block. step() is then the only writer of stepValues, so a recorded step and a
+// UI edit can never overwrite each other half-way.
+struct StepEdit {
+    uint8_t step;
+    uint8_t out;
+    int32_t delta;              // Added to the value, then clamped
+};
+
+struct EditLog {
+    StepEdit edits[64];         // Ring buffer, size is a power of two
+    uint32_t pending;           // UI write position (not yet visible to step())
+    uint32_t published;         // Written by the UI only
+    uint32_t applied;           // Written by step() only
+    
+    EditLog() : pending(0), published(0), applied(0) {}
+    
+    // UI side: queue an edit. Returns false (edit dropped) if step() is 64 edits behind.
+    bool add(int step, int out, int32_t delta) {
+        if (pending - __atomic_load_n(&applied, __ATOMIC_ACQUIRE) >= 64) return false;
+        StepEdit& e = edits[pending & 63];
+        e.step = (uint8_t)step;
+        e.out = (uint8_t)out;
+        e.delta = delta;
+        pending++;
+        return true;
+    }
+    
+    // UI side: hand everything added so far to step() in one store
+    void publish() {
+        __atomic_store_n(&published, pending, __ATOMIC_RELEASE);
+    }
+};
+
+// Modulation targets: the playback setting a modulation input moves. The first
+// four are in the order of their parameters (Clock Div .. Last Step).
+enum {
+    kModClockDiv,
+    kModDirection,
+    kModFirstStep,
+    kModLastStep,
+    kModTranspose,      // Added to every output, 1V/octave at 100% depth
+    kNumModTargets
+};
 
 struct V3Seq : public _NT_algorithm {
-    // Sequencer data: 32 steps × 3 outputs
-    int16_t stepValues[32][3];
+    // Sequencer data: maxSteps steps × 3 outputs, in DRAM (calculateRequirements
+    // sizes it from the specification)
+    int maxSteps;
+    int16_t (*stepValues)[3];
+    
+    // Preset loads: deserialise fills loadValues (after stepValues in DRAM) and sets
+    // loadPending; step() copies them in, so a load never writes the playing steps
+    int16_t (*loadValues)[3];
+    uint32_t loadPending;
+    uint32_t glideSteps[3][kMaxSteps / 32];  // Per output, bit n of word n/32 = glide into step n (Glide Steps = Marked)
+    
+    // The playing step's values, copied out of DRAM. Reloaded only when the step
+    // moves or a write lands (stepsVersion changes), so the per-block reads in
+    // step() stay in SRAM.
+    int16_t playingValues[3];
+    int playingStep;            // Step held in playingValues (-1 = none)
+    uint32_t playingVersion;    // stepsVersion when it was copied
+    
+    // Step value writes happen only in step(). stepsVersion is odd while a write is in
+    // progress, so readers outside the audio thread (serialise) can take a consistent copy.
+    EditLog editLog;            // UI edits on their way to step()
+    uint32_t stepsVersion;
     
     // Sequencer state
-    int currentStep;            // Current step (0-31)
+    int currentStep;            // Current step (0 to maxSteps-1)
     bool pingpongForward;       // Direction state for pingpong mode
     int section1Counter;        // Track section 1 repeat count
     int section2Counter;        // Track section 2 repeat count
@@ -33,20 +213,63 @@ struct V3Seq : public _NT_algorithm {
     int lastClockPeriod;        // Samples between last two clocks (for multiplication)
     int samplesSinceLastClock;  // Sample counter since last clock
     
+    // Glide
+    Glide glide[3];
+    int shownStep;              // Step output in the previous block, to spot step changes
+    
+    // Audio-rate mode
+    bool audioRateActive;       // Levels below are valid (mode was on last block)
+    float blepLevel[3];         // Naive output level (current step voltage)
+    float blepHeld[3];          // Next sample to write; outputs run one sample late for the BLEP
+    
     // Edge detection
     float lastClockIn;
     float lastResetIn;
     
+    // MIDI clock input
+    MidiClockFollower midiClock;
+    bool transportRunning;      // Cleared by MIDI Stop, set by Start/Continue
+    
+    // Internal clock
+    InternalClock internalClock;
+    uint32_t sampleTime;        // Samples processed since construction
+    uint32_t lastExternalTime;  // Block start of the last CV/MIDI clock
+    int externalPeriod;         // Samples between the last two external clocks
+    bool externalSeen;          // An external clock has arrived at least once
+    int clockOutCounter;        // Remaining samples of the Clock Out pulse
+    
     // UI state
-    int selectedStep;           // 0-31
+    int selectedStep;           // 0 to maxSteps-1
     int selectedPage;           // 0-2 (CV1, CV2, CV3)
     int lastSelectedStep;       // Track when step changes to update pots
     uint16_t lastEncoderRButton; // For debouncing right encoder button
+    uint16_t lastEncoderLButton; // For debouncing left encoder button
     bool potCaught[3];          // Track if each pot has caught the step value
     bool pagePotCaught;         // Track if middle pot has caught page position
     bool fineAdjustMode;        // Fine (true) vs coarse (false) adjustment mode
     
-    V3Seq() {
+    // Modulation inputs. While any is assigned, modded holds this block's Clock
+    // Div, Direction, First Step and Last Step with their offsets folded in (and
+    // transposeVolts the Transpose ones), and played() reads them; the
+    // parameters themselves are never written.
+    ModInput mods[kNumModInputs];
+    bool modulated;
+    int16_t modded[4];
+    float transposeVolts;
+    
+    V3Seq(int stepCapacity, int16_t (*stepMemory)[3]) {
+        maxSteps = stepCapacity;
+        stepValues = stepMemory;
+        loadValues = stepMemory + stepCapacity;
+        loadPending = 0;
+        for (int step = 0; step < maxSteps; step++) {
+            for (int out = 0; out < 3; out++) {
+                stepValues[step][out] = 0;
+            }
+        }
+        playingStep = -1;
+        playingVersion = 0;
+        
         // Initialize sequencer state
         currentStep = 0;
         pingpongForward = true;
@@ -57,6 +280,18 @@ struct V3Seq : public _NT_algorithm {
         internalClockCounter = 0;
         lastClockPeriod = 0;
         samplesSinceLastClock = 0;
+        shownStep = -1;
+        stepsVersion = 0;
+        audioRateActive = false;
+        for (int i = 0; i < 3; i++) {
+            blepLevel[i] = 0.0f;
+            blepHeld[i] = 0.0f;
+        }
+        for (int i = 0; i < 3; i++) {
+            for (int w = 0; w < kMaxSteps / 32; w++) {
+                glideSteps[i][w] = 0;
+            }
+        }
         
         // Initialize edge detection
         lastClockIn = 0.0f;
@@ -67,15 +302,95 @@ struct V3Seq : public _NT_algorithm {
         selectedPage = 0;
         lastSelectedStep = -1;
         lastEncoderRButton = 0;
+        lastEncoderLButton = 0;
         pagePotCaught = false;
         fineAdjustMode = false;
         for (int i = 0; i < 3; i++) {
             potCaught[i] = false;
         }
+        
+        transportRunning = true;
+        sampleTime = 0;
+        lastExternalTime = 0;
+        externalPeriod = 4800;
+        externalSeen = false;
+        clockOutCounter = 0;
+        modulated = false;
+        transposeVolts = 0.0f;
     }
     
     void advanceSequencer(int direction, int firstStep, int lastStep, int splitPoint, 
                           int sec1Reps, int sec2Reps);
+    
+    // Audio side: bracket every write to stepValues
+    void beginStepsWrite() {
+        __atomic_store_n(&stepsVersion, stepsVersion + 1, __ATOMIC_RELEASE);
+    }
+    void endStepsWrite() {
+        __atomic_store_n(&stepsVersion, stepsVersion + 1, __ATOMIC_RELEASE);
+    }
+    
+    // Audio side: the playing step's three values (see playingValues)
+    const int16_t* playingRow() {
+        if (playingStep != currentStep || playingVersion != stepsVersion) {
+            for (int out = 0; out < 3; out++) {
+                playingValues[out] = stepValues[currentStep][out];
+            }
+            playingStep = currentStep;
+            playingVersion = stepsVersion;
+        }
+        return playingValues;
+    }
+    
+    bool glideMarked(int out, int step) const {
+        return (glideSteps[out][step >> 5] >> (step & 31)) & 1u;
+    }
+    
+    // Audio side: apply every edit the UI has published (called at the start of step())
+    void applyEdits() {
+        uint32_t end = __atomic_load_n(&editLog.published, __ATOMIC_ACQUIRE);
+        if (end == editLog.applied) return;
+        beginStepsWrite();
+        for (uint32_t i = editLog.applied; i != end; i++) {
+            const StepEdit& e = editLog.edits[i & 63];
+            int32_t newValue = (int32_t)stepValues[e.step][e.out] + e.delta;
+            if (newValue < -32768) newValue = -32768;
+            if (newValue > 32767) newValue = 32767;
+            stepValues[e.step][e.out] = (int16_t)newValue;
+        }
+        endStepsWrite();
+        __atomic_store_n(&editLog.applied, end, __ATOMIC_RELEASE);
+    }
+    
+    // Audio side: take a preset load deserialise has staged (called after
+    // applyEdits, so edits made before the load don't land on top of it)
+    void applyLoad() {
+        if (!__atomic_load_n(&loadPending, __ATOMIC_ACQUIRE)) return;
+        beginStepsWrite();
+        memcpy(stepValues, loadValues, maxSteps * sizeof(stepValues[0]));
+        endStepsWrite();
+        __atomic_store_n(&loadPending, 0, __ATOMIC_RELAXED);
+    }
+    
+    void recordStep(int step, const float* busFrames, int numFrames, int frame);
+    void stepAudioRate(float* busFrames, int numFrames);
+    int addressedStep(float volts, int startIndex, float stepsPerVolt, int stepCount);
+    void fillSegment(float* busFrames, int numFrames, int fromFrame, int toFrame, int step);
+    void clampStep(int startIndex, int endIndex);
+    void updateOutputs();
+    void renderOutputs(float* busFrames, int numFrames, int fromFrame, int toFrame);
+    void resetSequencer();
+    
+    // Modulation inputs
+    int16_t played(int p) const;
+    void applyModulation(const float* busFrames, int numFrames);
+    float playedVoltage(int16_t value, int voltageRange) const;
+    
+    // MIDI transport
+    void transportStart();
+    void transportStop();
+    void transportContinue();
+    void seekToPosition(uint32_t position);
 };
 
 // =============================================================================
@@ -96,11 +411,48 @@ enum {
     kParamSection1Reps,
     kParamSection2Reps,
     kParamVoltageRange,
+    kParamClockSource,
+    kParamInternalClock,
+    kParamBpm,
+    kParamPpqn,
+    kParamTakeover,
+    kParamClockOut,
+    kParamGlideTime1,
+    kParamGlideTime2,
+    kParamGlideTime3,
+    kParamGlideShape1,
+    kParamGlideShape2,
+    kParamGlideShape3,
+    kParamGlideSteps1,
+    kParamGlideSteps2,
+    kParamGlideSteps3,
+    kParamRecMode,
+    kParamRecIn1,
+    kParamRecIn2,
+    kParamRecIn3,
+    kParamRecThreshold,
+    kParamRecQuantize,
+    kParamAudioRate,
+    kParamStepSelect,
+    kParamAddressIn,
+    // Modulation inputs (3 params per input: In, Target, Depth)
+    kParamMod1In,
+    kParamMod1Target,
+    kParamMod1Depth,
+    kParamMod4Depth = kParamMod1In + 11,
     kNumParameters
 };
 
 static _NT_parameter parameters[kNumParameters];
 
+// Value of a playback parameter as played this block: the parameter plus any
+// modulation aimed at it. Only the audio side reads this; the UI and presets see
+// the parameter as set.
+inline int16_t V3Seq::played(int p) const {
+    if (modulated && p >= kParamClockDiv && p <= kParamLastStep) return modded[p - kParamClockDiv];
+    return v[p];
+}
+
 // Parameter name strings
 static char clockInName[] = "Clock In";
 static char resetInName[] = "Reset In";
@@ -115,6 +467,31 @@ static char splitPointName[] = "Split Point";
 static char section1RepsName[] = "Section 1 Reps";
 static char section2RepsName[] = "Section 2 Reps";
 static char voltageRangeName[] = "Voltage Range";
+static char clockSourceName[] = "Clock Source";
+static char internalClockName[] = "Int Clock";
+static char bpmName[] = "BPM";
+static char ppqnName[] = "PPQN";
+static char takeoverName[] = "Takeover";
+static char clockOutName[] = "Clock Out";
+static char glideTime1Name[] = "Glide 1 Time";
+static char glideTime2Name[] = "Glide 2 Time";
+static char glideTime3Name[] = "Glide 3 Time";
+static char glideShape1Name[] = "Glide 1 Shape";
+static char glideShape2Name[] = "Glide 2 Shape";
+static char glideShape3Name[] = "Glide 3 Shape";
+static char glideSteps1Name[] = "Glide 1 Steps";
+static char glideSteps2Name[] = "Glide 2 Steps";
+static char glideSteps3Name[] = "Glide 3 Steps";
+static char recModeName[] = "Record";
+static char recIn1Name[] = "Rec In 1";
+static char recIn2Name[] = "Rec In 2";
+static char recIn3Name[] = "Rec In 3";
+static char recThresholdName[] = "Rec Threshold";
+static char recQuantizeName[] = "Rec Quantize";
+static char audioRateName[] = "Audio Rate";
+static char stepSelectName[] = "Step Select";
+static char addressInName[] = "Address In";
+static char modNames[kNumModInputs][3][16];
 
 // Voltage range strings
 static const char* const voltageRangeStrings[] = {
@@ -131,7 +508,43 @@ static const char* const directionStrings[] = {
     "Forward", "Backward", "Pingpong", NULL
 };
 
-void initParameters(_NT_algorithm* self) {
+static const char* const clockSourceStrings[] = {
+    "CV", "MIDI", "CV+MIDI", NULL
+};
+
+static const char* const internalClockStrings[] = {
+    "Off", "Auto", "On", NULL
+};
+
+static const char* const glideShapeStrings[] = {
+    "Linear", "Exponential", NULL
+};
+
+static const char* const glideStepsStrings[] = {
+    "All", "Marked", NULL
+};
+
+static const char* const recModeStrings[] = {
+    "Off", "Overwrite", "Threshold", NULL
+};
+
+static const char* const recQuantizeStrings[] = {
+    "Off", "Semitone", NULL
+};
+
+static const char* const offOnStrings[] = {
+    "Off", "On", NULL
+};
+
+static const char* const modTargetStrings[] = {
+    "Clock Div", "Direction", "First Step", "Last Step", "Transpose", NULL
+};
+
+static const char* const stepSelectStrings[] = {
+    "Clock", "CV Address", NULL
+};
+
+void initParameters(V3Seq* alg) {
     // Clock and Reset inputs
     parameters[kParamClockIn].name = clockInName;
     parameters[kParamClockIn].min = 0;
@@ -248,20 +661,197 @@ void initParameters(_NT_algorithm* self) {
     parameters[kParamVoltageRange].scaling = kNT_scalingNone;
     parameters[kParamVoltageRange].enumStrings = voltageRangeStrings;
     
-    self->parameters = parameters;
+    parameters[kParamClockSource].name = clockSourceName;
+    parameters[kParamClockSource].min = 0;
+    parameters[kParamClockSource].max = 2;  // CV, MIDI, CV+MIDI
+    parameters[kParamClockSource].def = 0;  // CV
+    parameters[kParamClockSource].unit = kNT_unitEnum;
+    parameters[kParamClockSource].scaling = kNT_scalingNone;
+    parameters[kParamClockSource].enumStrings = clockSourceStrings;
+    
+    parameters[kParamInternalClock].name = internalClockName;
+    parameters[kParamInternalClock].min = 0;
+    parameters[kParamInternalClock].max = 2;  // Off, Auto, On
+    parameters[kParamInternalClock].def = 0;  // Off
+    parameters[kParamInternalClock].unit = kNT_unitEnum;
+    parameters[kParamInternalClock].scaling = kNT_scalingNone;
+    parameters[kParamInternalClock].enumStrings = internalClockStrings;
+    
+    parameters[kParamBpm].name = bpmName;
+    parameters[kParamBpm].min = 200;   // 20.0 BPM
+    parameters[kParamBpm].max = 3000;  // 300.0 BPM
+    parameters[kParamBpm].def = 1200;  // 120.0 BPM
+    parameters[kParamBpm].unit = kNT_unitBPM;
+    parameters[kParamBpm].scaling = kNT_scaling10;
+    
+    parameters[kParamPpqn].name = ppqnName;
+    parameters[kParamPpqn].min = 1;
+    parameters[kParamPpqn].max = 24;
+    parameters[kParamPpqn].def = 4;    // 16th notes
+    parameters[kParamPpqn].unit = kNT_unitNone;
+    parameters[kParamPpqn].scaling = kNT_scalingNone;
+    
+    parameters[kParamTakeover].name = takeoverName;
+    parameters[kParamTakeover].min = 1;
+    parameters[kParamTakeover].max = 16;  // Missed external clock periods before Auto takes over
+    parameters[kParamTakeover].def = 4;
+    parameters[kParamTakeover].unit = kNT_unitNone;
+    parameters[kParamTakeover].scaling = kNT_scalingNone;
+    
+    parameters[kParamClockOut].name = clockOutName;
+    parameters[kParamClockOut].min = 0;
+    parameters[kParamClockOut].max = 28;
+    parameters[kParamClockOut].def = 0;   // None
+    parameters[kParamClockOut].unit = kNT_unitCvOutput;
+    parameters[kParamClockOut].scaling = kNT_scalingNone;
+    
+    // Glide per output
+    const char* glideTimeNames[] = {glideTime1Name, glideTime2Name, glideTime3Name};
+    const char* glideShapeNames[] = {glideShape1Name, glideShape2Name, glideShape3Name};
+    const char* glideStepsNames[] = {glideSteps1Name, glideSteps2Name, glideSteps3Name};
+    for (int out = 0; out < 3; out++) {
+        parameters[kParamGlideTime1 + out].name = glideTimeNames[out];
+        parameters[kParamGlideTime1 + out].min = 0;
+        parameters[kParamGlideTime1 + out].max = 2000;  // ms
+        parameters[kParamGlideTime1 + out].def = 0;     // Off
+        parameters[kParamGlideTime1 + out].unit = kNT_unitMs;
+        parameters[kParamGlideTime1 + out].scaling = kNT_scalingNone;
+        
+        parameters[kParamGlideShape1 + out].name = glideShapeNames[out];
+        parameters[kParamGlideShape1 + out].min = 0;
+        parameters[kParamGlideShape1 + out].max = 1;    // Linear, Exponential
+        parameters[kParamGlideShape1 + out].def = 0;
+        parameters[kParamGlideShape1 + out].unit = kNT_unitEnum;
+        parameters[kParamGlideShape1 + out].scaling = kNT_scalingNone;
+        parameters[kParamGlideShape1 + out].enumStrings = glideShapeStrings;
+        
+        parameters[kParamGlideSteps1 + out].name = glideStepsNames[out];
+        parameters[kParamGlideSteps1 + out].min = 0;
+        parameters[kParamGlideSteps1 + out].max = 1;    // All steps, or only steps marked in the UI
+        parameters[kParamGlideSteps1 + out].def = 0;
+        parameters[kParamGlideSteps1 + out].unit = kNT_unitEnum;
+        parameters[kParamGlideSteps1 + out].scaling = kNT_scalingNone;
+        parameters[kParamGlideSteps1 + out].enumStrings = glideStepsStrings;
+    }
+    
+    // Live recording
+    parameters[kParamRecMode].name = recModeName;
+    parameters[kParamRecMode].min = 0;
+    parameters[kParamRecMode].max = 2;  // Off, Overwrite, Threshold
+    parameters[kParamRecMode].def = 0;
+    parameters[kParamRecMode].unit = kNT_unitEnum;
+    parameters[kParamRecMode].scaling = kNT_scalingNone;
+    parameters[kParamRecMode].enumStrings = recModeStrings;
+    
+    const char* recInNames[] = {recIn1Name, recIn2Name, recIn3Name};
+    for (int out = 0; out < 3; out++) {
+        parameters[kParamRecIn1 + out].name = recInNames[out];
+        parameters[kParamRecIn1 + out].min = 0;
+        parameters[kParamRecIn1 + out].max = 28;
+        parameters[kParamRecIn1 + out].def = 0;  // None
+        parameters[kParamRecIn1 + out].unit = kNT_unitCvInput;
+        parameters[kParamRecIn1 + out].scaling = kNT_scalingNone;
+    }
+    
+    parameters[kParamRecThreshold].name = recThresholdName;
+    parameters[kParamRecThreshold].min = 0;
+    parameters[kParamRecThreshold].max = 1000;  // mV the input must move from the stored value
+    parameters[kParamRecThreshold].def = 50;
+    parameters[kParamRecThreshold].unit = kNT_unitMillivolts;
+    parameters[kParamRecThreshold].scaling = kNT_scalingNone;
+    
+    parameters[kParamRecQuantize].name = recQuantizeName;
+    parameters[kParamRecQuantize].min = 0;
+    parameters[kParamRecQuantize].max = 1;  // Off, Semitone (1V/oct)
+    parameters[kParamRecQuantize].def = 0;
+    parameters[kParamRecQuantize].unit = kNT_unitEnum;
+    parameters[kParamRecQuantize].scaling = kNT_scalingNone;
+    parameters[kParamRecQuantize].enumStrings = recQuantizeStrings;
+    
+    parameters[kParamAudioRate].name = audioRateName;
+    parameters[kParamAudioRate].min = 0;
+    parameters[kParamAudioRate].max = 1;  // Off, On
+    parameters[kParamAudioRate].def = 0;
+    parameters[kParamAudioRate].unit = kNT_unitEnum;
+    parameters[kParamAudioRate].scaling = kNT_scalingNone;
+    parameters[kParamAudioRate].enumStrings = offOnStrings;
+    
+    parameters[kParamStepSelect].name = stepSelectName;
+    parameters[kParamStepSelect].min = 0;
+    parameters[kParamStepSelect].max = 1;  // Clock, CV Address
+    parameters[kParamStepSelect].def = 0;
+    parameters[kParamStepSelect].unit = kNT_unitEnum;
+    parameters[kParamStepSelect].scaling = kNT_scalingNone;
+    parameters[kParamStepSelect].enumStrings = stepSelectStrings;
+    
+    parameters[kParamAddressIn].name = addressInName;
+    parameters[kParamAddressIn].min = 0;
+    parameters[kParamAddressIn].max = 28;
+    parameters[kParamAddressIn].def = 0;  // None
+    parameters[kParamAddressIn].unit = kNT_unitCvInput;
+    parameters[kParamAddressIn].scaling = kNT_scalingNone;
+    
+    // Modulation inputs. Depth 100% sweeps the target's whole range over 10V
+    // (Transpose: 1V/octave); an input set to none costs nothing.
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int base = kParamMod1In + (mod * 3);
+        snprintf(modNames[mod][0], sizeof(modNames[mod][0]), "Mod %d In", mod + 1);
+        snprintf(modNames[mod][1], sizeof(modNames[mod][1]), "Mod %d Target", mod + 1);
+        snprintf(modNames[mod][2], sizeof(modNames[mod][2]), "Mod %d Depth", mod + 1);
+        
+        parameters[base].name = modNames[mod][0];
+        parameters[base].min = 0;
+        parameters[base].max = 28;
+        parameters[base].def = 0;  // None
+        parameters[base].unit = kNT_unitCvInput;
+        parameters[base].scaling = kNT_scalingNone;
+        
+        parameters[base + 1].name = modNames[mod][1];
+        parameters[base + 1].min = 0;
+        parameters[base + 1].max = kNumModTargets - 1;
+        parameters[base + 1].def = kModLastStep;
+        parameters[base + 1].unit = kNT_unitEnum;
+        parameters[base + 1].scaling = kNT_scalingNone;
+        parameters[base + 1].enumStrings = modTargetStrings;
+        
+        parameters[base + 2].name = modNames[mod][2];
+        parameters[base + 2].min = -100;
+        parameters[base + 2].max = 100;
+        parameters[base + 2].def = 100;
+        parameters[base + 2].unit = kNT_unitPercent;
+        parameters[base + 2].scaling = kNT_scalingNone;
+    }
+    
+    // The step ranges follow this instance's Max Steps, so it gets its own copy
+    // of the table (placed after the object, see calculateRequirements)
+    _NT_parameter* table = (_NT_parameter*)(alg + 1);
+    memcpy(table, parameters, sizeof(parameters));
+    table[kParamFirstStep].max = alg->maxSteps;
+    table[kParamLastStep].max = alg->maxSteps;
+    table[kParamSplitPoint].max = alg->maxSteps - 1;
+    alg->parameters = table;
 }
 
 // =============================================================================
 // Construction
 // =============================================================================
 
-void calculateRequirements(_NT_algorithmRequirements& req, const int32_t*) {
+// Max Steps specification, clamped to what the storage supports
+static int specSteps(const int32_t* specs) {
+    int n = (specs != NULL) ? specs[0] : kMinSteps;
+    if (n < kMinSteps) n = kMinSteps;
+    if (n > kMaxSteps) n = kMaxSteps;
+    return n;
+}
+
+void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specs) {
     req.numParameters = kNumParameters;
-    req.sram = sizeof(V3Seq);
+    req.sram = sizeof(V3Seq) + sizeof(parameters);   // Object, then its parameter table
+    req.dram = 2 * specSteps(specs) * 3 * sizeof(int16_t);  // Steps, then a preset load's staging copy
 }
 
-_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t*) {
-    V3Seq* alg = new (ptrs.sram) V3Seq();
+_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t* specs) {
+    V3Seq* alg = new (ptrs.sram) V3Seq(specSteps(specs), reinterpret_cast<int16_t (*)[3]>(ptrs.dram));
     initParameters(alg);
     return alg;
 }
@@ -270,11 +860,25 @@ _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorith
 // Core Functions
 // =============================================================================
 
+// Step value (-32768 to 32767) to output voltage for the selected range
+static inline float stepVoltage(int16_t value, int voltageRange) {
+    // Normalize to 0.0-1.0
+    float normalized = (value + 32768) / 65535.0f;
+    
+    switch (voltageRange) {
+        case 0:  return normalized * 5.0f;             // 0-5V
+        case 1:  return normalized * 10.0f;            // 0-10V
+        case 2:  return (normalized * 10.0f) - 5.0f;   // -5V to +5V
+        case 3:  return (normalized * 20.0f) - 10.0f;  // -10V to +10V
+        default: return normalized * 10.0f;            // Fallback to 0-10V
+    }
+}
+
 void V3Seq::advanceSequencer(int direction, int firstStep, int lastStep, int splitPoint, 
                               int sec1Reps, int sec2Reps) {
     // Convert 1-based step numbers to 0-based indices
-    int startIndex = firstStep - 1;  // 0-31
-    int endIndex = lastStep - 1;     // 0-31
+    int startIndex = firstStep - 1;  // 0 to maxSteps-1
+    int endIndex = lastStep - 1;
     int stepCount = (endIndex - startIndex) + 1;
     
     // If no sections (splitPoint >= lastStep), use simple wrapping logic
@@ -395,6 +999,360 @@ void V3Seq::advanceSequencer(int direction, int firstStep, int lastStep, int spl
     }
 }
 
+// Sample the record inputs on one frame and write them into a step.
+// Overwrite always writes; Threshold only replaces a value the input has moved
+// away from by at least Rec Threshold, so a still or unplugged input leaves it alone.
+void V3Seq::recordStep(int step, const float* busFrames, int numFrames, int frame) {
+    int recMode = v[kParamRecMode];  // 0=Off, 1=Overwrite, 2=Threshold
+    if (recMode == 0) return;
+    
+    int voltageRange = v[kParamVoltageRange];  // 0=0-5V, 1=0-10V, 2=-5-+5V, 3=-10-+10V
+    float threshold = v[kParamRecThreshold] / 1000.0f;
+    
+    beginStepsWrite();
+    for (int out = 0; out < 3; out++) {
+        int inputBus = v[kParamRecIn1 + out];  // 0 = none, 1-28 = bus 0-27
+        if (inputBus < 1 || inputBus > 28) continue;
+        
+        float volts = busFrames[((inputBus - 1) * numFrames) + frame];
+        if (v[kParamRecQuantize] == 1) {
+            volts = roundf(volts * 12.0f) / 12.0f;  // Nearest semitone at 1V/octave
+        }
+        
+        // Inverse of the output voltage range
+        float normalized;
+        switch (voltageRange) {
+            case 0:  normalized = volts / 5.0f; break;
+            case 2:  normalized = (volts + 5.0f) / 10.0f; break;
+            case 3:  normalized = (volts + 10.0f) / 20.0f; break;
+            default: normalized = volts / 10.0f; break;
+        }
+        if (normalized < 0.0f) normalized = 0.0f;
+        if (normalized > 1.0f) normalized = 1.0f;
+        
+        if (recMode == 2) {
+            // Range width in volts, to compare against the stored value
+            float span = (voltageRange == 0) ? 5.0f : (voltageRange == 3) ? 20.0f : 10.0f;
+            float stored = (stepValues[step][out] + 32768) / 65535.0f;
+            if (fabsf(normalized - stored) * span < threshold) continue;
+        }
+        
+        stepValues[step][out] = (int16_t)((int32_t)(normalized * 65535.0f + 0.5f) - 32768);
+    }
+    endStepsWrite();
+}
+
+// Audio-rate mode: the clock input is an oscillator. Every rising edge is found on
+// its own frame and the outputs are written per sample, so the loop becomes one
+// cycle of a waveform. Step jumps are band-limited with a two-sample polyBLEP,
+// which corrects the sample before the jump too, so the outputs run one sample late.
+// Between edges the outputs are constant and written with a plain fill, so the
+// cost only grows with the number of edges, not with the clock frequency itself.
+void V3Seq::stepAudioRate(float* busFrames, int numFrames) {
+    int clockBus = v[kParamClockIn] - 1;  // 0-27 (parameter is 1-28)
+    const float* clockIn = (clockBus >= 0 && clockBus < 28) ? busFrames + (clockBus * numFrames) : NULL;
+    int voltageRange = v[kParamVoltageRange];
+    
+    int clockDiv = played(kParamClockDiv);
+    int divisor = (clockDiv < 15) ? 16 - clockDiv : 1;  // Multiplication plays as x1 at audio rate
+    int direction = played(kParamDirection);
+    int firstStep = played(kParamFirstStep);
+    int lastStep = played(kParamLastStep);
+    int splitPoint = v[kParamSplitPoint];
+    int sec1Reps = v[kParamSection1Reps];
+    int sec2Reps = v[kParamSection2Reps];
+    
+    float* outs[3];
+    for (int out = 0; out < 3; out++) {
+        int outputBus = v[kParamOut1 + out];  // 0 = none, 1-28 = bus 0-27
+        outs[out] = (outputBus > 0 && outputBus <= 28) ? busFrames + ((outputBus - 1) * numFrames) : NULL;
+    }
+    
+    if (!audioRateActive) {
+        for (int out = 0; out < 3; out++) {
+            blepLevel[out] = playedVoltage(playingRow()[out], voltageRange);
+            blepHeld[out] = blepLevel[out];
+        }
+        audioRateActive = true;
+    }
+    
+    // Level changed between blocks (reset, edit, range): jump at the block boundary
+    for (int out = 0; out < 3; out++) {
+        float newLevel = playedVoltage(playingRow()[out], voltageRange);
+        float h = newLevel - blepLevel[out];
+        blepHeld[out] += 0.5f * h;
+        blepLevel[out] = newLevel;
+    }
+    
+    int frame = 0;
+    float last = lastClockIn;
+    while (frame < numFrames) {
+        // Run up to the next rising edge (or the end of the block)
+        int edge = frame;
+        if (clockIn) {
+            while (edge < numFrames && !(clockIn[edge] > 0.5f && last <= 0.5f)) {
+                last = clockIn[edge];
+                edge++;
+            }
+        } else {
+            edge = numFrames;
+        }
+        
+        // No edges: constant output (the held sample first)
+        if (edge > frame) {
+            for (int out = 0; out < 3; out++) {
+                if (outs[out]) {
+                    float* o = outs[out];
+                    float level = blepLevel[out];
+                    o[frame] = blepHeld[out];
+                    for (int f = frame + 1; f < edge; f++) {
+                        o[f] = level;
+                    }
+                }
+                blepHeld[out] = blepLevel[out];
+            }
+        }
+        if (edge >= numFrames) break;
+        
+        // Fraction of a sample between the 0.5V crossing and this frame (0-1]
+        float d = (clockIn[edge] - 0.5f) / (clockIn[edge] - last);
+        last = clockIn[edge];
+        
+        clockCounter++;
+        if (clockCounter >= divisor) {
+            clockCounter = 0;
+            advanceSequencer(direction, firstStep, lastStep, splitPoint, sec1Reps, sec2Reps);
+            if (currentStep < firstStep - 1) currentStep = firstStep - 1;
+            if (currentStep > lastStep - 1) currentStep = lastStep - 1;
+        }
+        
+        // polyBLEP: +h*d^2/2 on the sample before the jump, -h*(1-d)^2/2 on the one after
+        const int16_t* row = playingRow();
+        for (int out = 0; out < 3; out++) {
+            float newLevel = playedVoltage(row[out], voltageRange);
+            float h = newLevel - blepLevel[out];
+            blepHeld[out] += 0.5f * h * d * d;
+            if (outs[out]) outs[out][edge] = blepHeld[out];
+            blepHeld[out] = newLevel - (0.5f * h * (1.0f - d) * (1.0f - d));
+            blepLevel[out] = newLevel;
+        }
+        frame = edge + 1;
+    }
+    lastClockIn = last;
+}
+
+// Hysteresis at the step boundaries of CV address mode, in steps. The address has
+// to go this far past a boundary before the step changes, so a noisy voltage
+// sitting on a boundary does not chatter between two steps.
+static const float kAddressHysteresis = 0.1f;
+
+// CV address mode: step for an address voltage (0-10V across First..Last Step).
+// stepsPerVolt is stepCount / 10, worked out once per block, so this is a multiply.
+int V3Seq::addressedStep(float volts, int startIndex, float stepsPerVolt, int stepCount) {
+    float position = volts * stepsPerVolt;  // 0 to stepCount
+    int current = currentStep - startIndex;
+    
+    // Stay put while the address is within the current step plus the hysteresis band
+    if (current >= 0 && current < stepCount &&
+        position >= current - kAddressHysteresis && position < current + 1 + kAddressHysteresis) {
+        return currentStep;
+    }
+    
+    int index = (position > 0.0f) ? (int)position : 0;
+    if (index > stepCount - 1) index = stepCount - 1;
+    return startIndex + index;
+}
+
+// Write one step's voltages to every output over frames [fromFrame, toFrame)
+void V3Seq::fillSegment(float* busFrames, int numFrames, int fromFrame, int toFrame, int step) {
+    int voltageRange = v[kParamVoltageRange];
+    for (int out = 0; out < 3; out++) {
+        int outputBus = v[kParamOut1 + out];  // 0 = none, 1-28 = bus 0-27
+        if (outputBus < 1 || outputBus > 28) continue;
+        float value = playedVoltage(stepValues[step][out], voltageRange);
+        float* outBus = busFrames + ((outputBus - 1) * numFrames);
+        for (int frame = fromFrame; frame < toFrame; frame++) {
+            outBus[frame] = value;
+        }
+    }
+}
+
+// Keep the current step within First..Last Step (safety check)
+void V3Seq::clampStep(int startIndex, int endIndex) {
+    if (currentStep < startIndex) {
+        currentStep = startIndex;
+    }
+    if (currentStep > endIndex) {
+        currentStep = endIndex;
+    }
+}
+
+// Point each output's glide at the current step's value: glide into a new step,
+// or jump if this output/step has no glide (even when an earlier glide is still
+// running)
+void V3Seq::updateOutputs() {
+    int step = currentStep;
+    int voltageRange = v[kParamVoltageRange];  // 0=0-5V, 1=0-10V, 2=-5-+5V, 3=-10-+10V
+    bool stepChanged = (step != shownStep);
+    shownStep = step;
+    const int16_t* row = playingRow();
+    
+    for (int out = 0; out < 3; out++) {
+        float outputValue = playedVoltage(row[out], voltageRange);
+        
+        Glide& g = glide[out];
+        if (outputValue != g.target) {
+            int glideTime = v[kParamGlideTime1 + out];  // ms, 0 = off
+            bool marked = glideMarked(out, step);
+            bool glideHere = glideTime > 0 && (v[kParamGlideSteps1 + out] == 0 || marked);
+            
+            if (stepChanged && glideHere) {
+                int samples = (int)((glideTime * NT_globals.sampleRate) / 1000);
+                if (samples < 1) samples = 1;
+                g.start(outputValue, samples, v[kParamGlideShape1 + out] == 1);
+            } else if (!stepChanged && g.remaining > 0) {
+                // Same step edited (or range changed) mid-glide: keep gliding to the new value
+                g.retarget(outputValue);
+            } else {
+                g.set(outputValue);
+            }
+        }
+    }
+}
+
+// Write every output's glide over frames [fromFrame, toFrame)
+void V3Seq::renderOutputs(float* busFrames, int numFrames, int fromFrame, int toFrame) {
+    if (toFrame <= fromFrame) return;
+    for (int out = 0; out < 3; out++) {
+        int outputBus = v[kParamOut1 + out];  // 0 = none, 1-28 = bus 0-27
+        if (outputBus > 0 && outputBus <= 28) {
+            glide[out].render(busFrames + ((outputBus - 1) * numFrames) + fromFrame, toFrame - fromFrame);
+        } else {
+            glide[out].skip(toFrame - fromFrame);  // Keep the glide moving with no bus assigned
+        }
+    }
+}
+
+// Output voltage of a step as played: Transpose modulation moves it 1V/octave
+float V3Seq::playedVoltage(int16_t value, int voltageRange) const {
+    return stepVoltage(value, voltageRange) + transposeVolts;
+}
+
+// Read the modulation inputs (one mean per block) and fold their offsets into
+// modded. With no input assigned this is a check per input: played() then reads
+// the parameters directly.
+void V3Seq::applyModulation(const float* busFrames, int numFrames) {
+    int offsets[kNumModTargets] = { 0, 0, 0, 0, 0 };
+    bool any = false;
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int base = kParamMod1In + (mod * 3);
+        int bus = v[base] - 1;
+        if (bus < 0) {
+            mods[mod].offset = 0;
+            continue;
+        }
+        any = true;
+        
+        // Units per volt at 100% depth: the target's whole range over 10V,
+        // Transpose 1V/octave
+        int target = v[base + 1];
+        float range = (target == kModClockDiv) ? 30.0f : (target == kModDirection) ? 2.0f :
+                      (target == kModTranspose) ? 120.0f : (float)(maxSteps - 1);
+        float volts = ModInput::mean(busFrames + (bus * numFrames), numFrames);
+        mods[mod].update(volts * range * v[base + 2] / 1000.0f);
+        offsets[target] += mods[mod].offset;
+    }
+    if (!any) {
+        modulated = false;
+        transposeVolts = 0.0f;
+        return;
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        int p = kParamClockDiv + i;
+        int value = v[p] + offsets[i];
+        if (value < parameters[p].min) value = parameters[p].min;
+        if (value > parameters[p].max) value = parameters[p].max;
+        modded[i] = (int16_t)value;
+    }
+    
+    // Keep First <= Last as parameterChanged does: a moved Last Step pulls First
+    // Step down with it, otherwise Last Step follows First Step up
+    if (modded[kModFirstStep] > modded[kModLastStep]) {
+        if (offsets[kModLastStep] != 0 && offsets[kModFirstStep] == 0) {
+            modded[kModFirstStep] = modded[kModLastStep];
+        } else {
+            modded[kModLastStep] = modded[kModFirstStep];
+        }
+    }
+    transposeVolts = offsets[kModTranspose] / 12.0f;
+    modulated = true;
+}
+
+void V3Seq::resetSequencer() {
+    currentStep = 0;
+    pingpongForward = true;
+    section1Counter = 0;
+    section2Counter = 0;
+    inSection2 = false;
+    clockCounter = 0;
+    internalClockCounter = 0;
+    samplesSinceLastClock = 0;
+}
+
+// =============================================================================
+// MIDI Transport
+// =============================================================================
+
+// MIDI Start: play from the top
+void V3Seq::transportStart() {
+    resetSequencer();
+    currentStep = played(kParamFirstStep) - 1;  // Start on the first step so Start + N clocks == Song Position N
+    midiClock.restart();
+    transportRunning = true;
+}
+
+// MIDI Stop: hold position
+void V3Seq::transportStop() {
+    transportRunning = false;
+}
+
+// MIDI Continue: resume from the current (or seeked) position
+void V3Seq::transportContinue() {
+    midiClock.restart();
+    transportRunning = true;
+}
+
+// MIDI Song Position Pointer: position is in 16th notes, one clock pulse each.
+// The sequencer is put exactly where it would be after that many pulses from
+// the first step, including clock division phase and section repeats.
+void V3Seq::seekToPosition(uint32_t position) {
+    midiClock.restart();
+    
+    int clockDiv = played(kParamClockDiv);
+    int divisor = (clockDiv < 15) ? 16 - clockDiv : 1;
+    int multiplier = (clockDiv < 15) ? 1 : clockDiv - 14;
+    
+    resetSequencer();
+    uint32_t advances = (position / divisor) * multiplier;
+    clockCounter = (divisor > 1) ? (int)(position % divisor) : 0;
+    
+    LoopPlan plan;
+    buildLoop(plan, played(kParamDirection), played(kParamFirstStep), played(kParamLastStep), v[kParamSplitPoint],
+              v[kParamSection1Reps], v[kParamSection2Reps]);
+    LoopState st = plan.seek(advances);
+    
+    currentStep = st.step;
+    section1Counter = st.section1Counter;
+    section2Counter = st.section2Counter;
+    inSection2 = st.inSection2;
+    pingpongForward = st.pingpongForward;
+}
+
+// =============================================================================
+// Audio Processing
+// =============================================================================
+
 void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     V3Seq* a = static_cast<V3Seq*>(self);
     int numFrames = numFramesBy4 * 4;
@@ -403,22 +1361,115 @@ void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     int clockBus = self->v[kParamClockIn] - 1;  // 0-27 (parameter is 1-28)
     int resetBus = self->v[kParamResetIn] - 1;
     
-    // Get first sample from each input bus (for edge detection)
-    float clockIn = (clockBus >= 0 && clockBus < 28) ? busFrames[clockBus * numFrames] : 0.0f;
+    // UI edits published since the last block, then a preset load
+    a->applyEdits();
+    a->applyLoad();
+    
+    // Modulation inputs, read before the sequencer moves this block
+    a->applyModulation(busFrames, numFrames);
+    
+    // Get first sample of the reset bus (for edge detection)
     float resetIn = (resetBus >= 0 && resetBus < 28) ? busFrames[resetBus * numFrames] : 0.0f;
     
-    // Clock edge detection (rising edge > 0.5V)
-    bool clockTrig = (clockIn > 0.5f && a->lastClockIn <= 0.5f);
+    // Audio-rate mode has its own per-sample loop (CV clock only; MIDI ticks are drained)
+    if (self->v[kParamAudioRate] == 1) {
+        if (resetIn > 0.5f && a->lastResetIn <= 0.5f) {
+            a->resetSequencer();
+        }
+        a->lastResetIn = resetIn;
+        int pulseFrames[8];
+        a->midiClock.process(numFrames, pulseFrames, 8);
+        a->stepAudioRate(busFrames, numFrames);
+        a->sampleTime += numFrames;
+        return;
+    }
+    a->audioRateActive = false;
+    
+    // Clock edges (rising edge > 0.5V), each on its exact frame so the step
+    // changes and recording samples the inputs at the edge, not at the block start
+    int tickFrames[kMaxTicks];
+    int numTicks = 0;
+    if (clockBus >= 0 && clockBus < 28) {
+        numTicks = findClockEdges(busFrames + (clockBus * numFrames), numFrames, 0.5f, a->lastClockIn,
+                                  tickFrames, kMaxTicks);
+    }
     bool resetTrig = (resetIn > 0.5f && a->lastResetIn <= 0.5f);
     
-    a->lastClockIn = clockIn;
     a->lastResetIn = resetIn;
     
+    // Clock source: 0=CV, 1=MIDI, 2=CV+MIDI (MIDI pulses count in blocks with no CV edge)
+    // MIDI ticks are always drained; each pulse is a tick on its own frame
+    int clockSource = self->v[kParamClockSource];
+    int pulseFrames[kMaxTicks];
+    int numPulses = a->midiClock.process(numFrames, pulseFrames, kMaxTicks);
+    if (clockSource == 0 || !a->transportRunning) numPulses = 0;
+    if (clockSource == 1) numTicks = 0;
+    bool midiPulse = false;
+    if (numPulses > 0 && numTicks == 0) {
+        for (int i = 0; i < numPulses; i++) tickFrames[i] = pulseFrames[i];
+        numTicks = numPulses;
+        midiPulse = true;
+    }
+    
+    // Int Clock: 0=Off, 1=Auto, 2=On (On ignores the external clock entirely)
+    int internalMode = self->v[kParamInternalClock];
+    if (internalMode == 2) {
+        numTicks = 0;
+        midiPulse = false;
+    }
+    bool clockTrig = (numTicks > 0);
+    if (clockTrig) {
+        uint32_t sinceLast = (a->sampleTime + tickFrames[0]) - a->lastExternalTime;
+        if (numTicks > 1) sinceLast = tickFrames[numTicks - 1] - tickFrames[numTicks - 2];
+        if ((a->externalSeen || numTicks > 1) && sinceLast > 100 && sinceLast < 96000) {
+            a->externalPeriod = (int)sinceLast;
+        }
+        if (midiPulse) {
+            a->externalPeriod = a->midiClock.pulsePeriod();
+        }
+        a->lastExternalTime = a->sampleTime + tickFrames[numTicks - 1];
+        a->externalSeen = true;
+    }
+    
+    // Internal clock: always when On; when Auto, from the moment the external clock
+    // has been missing for "Takeover" periods (or has never arrived) until it returns
+    bool useInternal = (internalMode == 2);
+    int firstFrame = 0;
+    if (internalMode == 1 && !clockTrig) {
+        if (a->internalClock.active || !a->externalSeen) {
+            useInternal = true;
+        } else {
+            uint32_t deadline = a->lastExternalTime + (uint32_t)(self->v[kParamTakeover] * a->externalPeriod);
+            if ((int32_t)(a->sampleTime + numFrames - deadline) > 0) {
+                useInternal = true;
+                firstFrame = (int32_t)(deadline - a->sampleTime) > 0 ? (int)(deadline - a->sampleTime) : 0;
+            }
+        }
+    }
+    int internalFrames[kMaxTicks];
+    int numInternal = 0;
+    if (useInternal) {
+        if (!a->internalClock.active) {
+            a->internalClock.startAt(firstFrame, self->v[kParamBpm], self->v[kParamPpqn]);
+        }
+        numInternal = a->internalClock.process(numFrames, self->v[kParamBpm], self->v[kParamPpqn],
+                                               internalFrames, kMaxTicks);
+    }
+    a->internalClock.active = useInternal;
+    
+    // Internal pulses only run with no external tick in the block: each is a tick
+    bool internalPulse = (numInternal > 0);
+    if (internalPulse) {
+        for (int i = 0; i < numInternal; i++) tickFrames[i] = internalFrames[i];
+        numTicks = numInternal;
+        clockTrig = true;
+    }
+    
     // Get sequencer parameters
-    int clockDiv = self->v[kParamClockDiv];
-    int direction = self->v[kParamDirection];
-    int firstStep = self->v[kParamFirstStep];  // 1-32
-    int lastStep = self->v[kParamLastStep];    // 1-32
+    int clockDiv = a->played(kParamClockDiv);
+    int direction = a->played(kParamDirection);
+    int firstStep = a->played(kParamFirstStep);  // 1 to Max Steps
+    int lastStep = a->played(kParamLastStep);
     int splitPoint = self->v[kParamSplitPoint];
     int sec1Reps = self->v[kParamSection1Reps];
     int sec2Reps = self->v[kParamSection2Reps];
@@ -436,107 +1487,145 @@ void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     
     // Reset handling
     if (resetTrig) {
-        a->currentStep = 0;
-        a->pingpongForward = true;
-        a->section1Counter = 0;
-        a->section2Counter = 0;
-        a->inSection2 = false;
-        a->clockCounter = 0;
-        a->internalClockCounter = 0;
-        a->samplesSinceLastClock = 0;
+        a->resetSequencer();
     }
     
-    // Track samples for multiplication modes
+    // Samples since the last clock, as of the end of this block
     a->samplesSinceLastClock += numFrames;
     
-    // Clock handling with division/multiplication
-    bool stepped = false;
-    if (clockTrig) {
+    // CV address mode: the Address input picks the step, the clock does not advance it
+    int addressBus = self->v[kParamAddressIn] - 1;  // 0-27 (parameter is 1-28)
+    bool addressed = (self->v[kParamStepSelect] == 1 && addressBus >= 0 && addressBus < 28);
+    int startIndex = firstStep - 1;
+    int endIndex = lastStep - 1;
+    
+    // CV address mode: read the address every 4 frames, so an audio-rate address
+    // still moves the outputs within the block. If the step changes after the first
+    // chunk the block is written here in constant segments (no glide).
+    bool addressRendered = false;
+    if (addressed) {
+        const float* address = busFrames + (addressBus * numFrames);
+        int stepCount = (endIndex - startIndex) + 1;
+        float stepsPerVolt = stepCount * 0.1f;
+        
+        a->currentStep = a->addressedStep(address[0], startIndex, stepsPerVolt, stepCount);
+        int segmentStart = 0;
+        for (int chunk = 1; chunk < numFramesBy4; chunk++) {
+            int newStep = a->addressedStep(address[chunk * 4], startIndex, stepsPerVolt, stepCount);
+            if (newStep != a->currentStep) {
+                a->fillSegment(busFrames, numFrames, segmentStart, chunk * 4, a->currentStep);
+                segmentStart = chunk * 4;
+                a->currentStep = newStep;
+                addressRendered = true;
+            }
+        }
+        if (addressRendered) {
+            a->fillSegment(busFrames, numFrames, segmentStart, numFrames, a->currentStep);
+        }
+    }
+    
+    // Outputs for the step playing at the start of the block (a reset, or an edit).
+    // A First/Last Step change can leave the step outside the range: it plays
+    // clamped, but the next advance still starts from where it was and is clamped
+    // after (the order LoopPlan's seek mirrors).
+    int advanceFrom = a->currentStep;
+    a->clampStep(startIndex, endIndex);
+    a->updateOutputs();
+    if (addressRendered) {
+        // Already written in segments; settle on the last one
+        for (int out = 0; out < 3; out++) a->glide[out].set(a->glide[out].target);
+    }
+    
+    // Clock handling with division/multiplication, one tick at a time. The
+    // outputs are written up to each tick's frame before the step moves there.
+    int segmentStart = 0;
+    for (int tick = 0; tick < numTicks && !addressed; tick++) {
+        int frame = tickFrames[tick];
+        
         // Measure clock period for multiplication
-        if (a->samplesSinceLastClock > 100 && a->samplesSinceLastClock < 96000) {
-            a->lastClockPeriod = a->samplesSinceLastClock;
+        int sinceClock = a->samplesSinceLastClock - (numFrames - frame);
+        if (sinceClock > 100 && sinceClock < 96000) {
+            a->lastClockPeriod = sinceClock;
         }
-        a->samplesSinceLastClock = 0;
+        if (midiPulse) {
+            a->lastClockPeriod = a->midiClock.pulsePeriod();  // PLL tempo, not block-quantized spacing
+        }
+        if (internalPulse) {
+            a->lastClockPeriod = (int)(InternalClock::period(self->v[kParamBpm], self->v[kParamPpqn]) + 0.5);
+        }
+        a->samplesSinceLastClock = numFrames - frame;
         a->internalClockCounter = 0;
         
+        bool stepped = false;
         if (isDivision) {
             // Division mode: count clocks before advancing
             a->clockCounter++;
             if (a->clockCounter >= divisor) {
                 a->clockCounter = 0;
-                a->advanceSequencer(direction, firstStep, lastStep, splitPoint, sec1Reps, sec2Reps);
                 stepped = true;
             }
         } else {
             // Multiplication mode: step on external clock
-            a->advanceSequencer(direction, firstStep, lastStep, splitPoint, sec1Reps, sec2Reps);
             stepped = true;
         }
+        
+        if (stepped) {
+            a->renderOutputs(busFrames, numFrames, segmentStart, frame);
+            segmentStart = frame;
+            a->currentStep = advanceFrom;
+            a->advanceSequencer(direction, firstStep, lastStep, splitPoint, sec1Reps, sec2Reps);
+            a->clampStep(startIndex, endIndex);
+            advanceFrom = a->currentStep;
+            
+            // Live recording: sample the inputs into the step that just came up
+            a->recordStep(a->currentStep, busFrames, numFrames, frame);
+            a->updateOutputs();
+        }
     }
     
-    // Internal clock multiplication - generate additional steps between external clocks
-    if (!isDivision && multiplier > 1 && !clockTrig && a->lastClockPeriod > 0) {
+    // Internal clock multiplication - generate additional steps between external clocks,
+    // on the frame where the subdivision falls
+    if (!isDivision && multiplier > 1 && !clockTrig && !addressed && a->lastClockPeriod > 0) {
         int subdivisionPeriod = a->lastClockPeriod / multiplier;
+        int due = subdivisionPeriod * (a->internalClockCounter + 1);
         
-        if (subdivisionPeriod > numFrames && a->samplesSinceLastClock >= subdivisionPeriod * (a->internalClockCounter + 1)) {
+        if (subdivisionPeriod > numFrames && a->samplesSinceLastClock >= due) {
             a->internalClockCounter++;
             if (a->internalClockCounter < multiplier) {
+                int frame = due - (a->samplesSinceLastClock - numFrames);
+                if (frame < 0) frame = 0;
+                if (frame > numFrames - 1) frame = numFrames - 1;
+                a->renderOutputs(busFrames, numFrames, segmentStart, frame);
+                segmentStart = frame;
+                a->currentStep = advanceFrom;
                 a->advanceSequencer(direction, firstStep, lastStep, splitPoint, sec1Reps, sec2Reps);
-                stepped = true;
+                a->clampStep(startIndex, endIndex);
+                a->recordStep(a->currentStep, busFrames, numFrames, frame);
+                a->updateOutputs();
             }
         }
     }
     
-    // Clamp current step to valid range (safety check)
-    int startIndex = firstStep - 1;
-    int endIndex = lastStep - 1;
-    if (a->currentStep < startIndex) {
-        a->currentStep = startIndex;
-    }
-    if (a->currentStep > endIndex) {
-        a->currentStep = endIndex;
+    if (!addressRendered) {
+        a->renderOutputs(busFrames, numFrames, segmentStart, numFrames);
     }
     
-    // Output current step values to all output buses
-    int step = a->currentStep;
-    int voltageRange = self->v[kParamVoltageRange];  // 0=0-5V, 1=0-10V, 2=-5-+5V, 3=-10-+10V
-    
-    for (int out = 0; out < 3; out++) {
-        int outputBus = self->v[kParamOut1 + out];  // 0 = none, 1-28 = bus 0-27
-        
-        if (outputBus > 0 && outputBus <= 28) {
-            int16_t value = a->stepValues[step][out];
-            // Normalize to 0.0-1.0
-            float normalized = (value + 32768) / 65535.0f;
-            
-            // Convert to voltage based on selected range
-            float outputValue;
-            switch (voltageRange) {
-                case 0:  // 0-5V
-                    outputValue = normalized * 5.0f;
-                    break;
-                case 1:  // 0-10V
-                    outputValue = normalized * 10.0f;
-                    break;
-                case 2:  // -5V to +5V
-                    outputValue = (normalized * 10.0f) - 5.0f;
-                    break;
-                case 3:  // -10V to +10V
-                    outputValue = (normalized * 20.0f) - 10.0f;
-                    break;
-                default:
-                    outputValue = normalized * 10.0f;  // Fallback to 0-10V
-                    break;
-            }
-            
-            // Write to all frames in the output bus
-            float* outBus = busFrames + ((outputBus - 1) * numFrames);
-            for (int frame = 0; frame < numFrames; frame++) {
-                outBus[frame] = outputValue;
-            }
+    // Internal clock output: 5V pulses starting on the exact frame of each internal pulse
+    int clockOutBus = self->v[kParamClockOut];  // 0 = none, 1-28 = bus 0-27
+    float* clockOut = (clockOutBus > 0 && clockOutBus <= 28) ? busFrames + ((clockOutBus - 1) * numFrames) : NULL;
+    int nextPulse = 0;
+    for (int frame = 0; frame < numFrames; frame++) {
+        if (nextPulse < numInternal && internalFrames[nextPulse] == frame) {
+            a->clockOutCounter = 240;  // ~5ms at 48kHz
+            nextPulse++;
         }
-        
+        if (clockOut) {
+            clockOut[frame] = (a->clockOutCounter > 0) ? 5.0f : 0.0f;
+        }
+        if (a->clockOutCounter > 0) a->clockOutCounter--;
     }
+    
+    a->sampleTime += numFrames;
 }
 
 void parameterChanged(_NT_algorithm* self, int parameterIndex) {
@@ -593,8 +1682,8 @@ bool draw(_NT_algorithm* self) {
     NT_drawShapeI(kNT_rectangle, 0, 0, 256, 64, 0);  // Black background
     
     // Get parameters
-    int firstStep = self->v[kParamFirstStep];  // 1-32
-    int lastStep = self->v[kParamLastStep];    // 1-32
+    int firstStep = self->v[kParamFirstStep];  // 1 to Max Steps
+    int lastStep = self->v[kParamLastStep];
     int splitPoint = self->v[kParamSplitPoint];
     
     // Draw title with page indicator
@@ -605,7 +1694,21 @@ bool draw(_NT_algorithm* self) {
     // Draw current step number in top right corner
     char stepNum[4];
     snprintf(stepNum, sizeof(stepNum), "%d", a->selectedStep + 1);
-    NT_drawText(240, 0, stepNum, 255);
+    NT_drawText((a->selectedStep >= 99) ? 234 : 240, 0, stepNum, 255);
+    
+    // Longer patterns: the grid shows the 32-step page holding the selected step
+    int gridPage = a->selectedStep / kPageSteps;
+    int numGridPages = (a->maxSteps + kPageSteps - 1) / kPageSteps;
+    if (numGridPages > 1) {
+        char pageText[24];  // Two ints and a slash
+        snprintf(pageText, sizeof(pageText), "%d/%d", gridPage + 1, numGridPages);
+        NT_drawText(120, 0, pageText, 128);
+    }
+    
+    // Recording indicator
+    if (self->v[kParamRecMode] != 0) {
+        NT_drawText(160, 0, "REC", 255);
+    }
     
     // Draw adjustment mode indicator (coarse or fine)
     const char* modeText = a->fineAdjustMode ? "fine" : "coarse";
@@ -626,7 +1729,7 @@ bool draw(_NT_algorithm* self) {
         NT_drawShapeI(kNT_line, barStartX, pageBarY, barEndX, pageBarY, brightness);
     }
     
-    // Draw 32 steps in 2 rows of 16
+    // Draw 32 steps (one grid page) in 2 rows of 16
     // Each step shows 1 bar for the current page's CV output
     // Screen is 256 wide, divided into 2 rows of 16 steps
     
@@ -640,9 +1743,11 @@ bool draw(_NT_algorithm* self) {
     // Get which CV output to display based on page
     int currentOutput = a->selectedPage;  // 0, 1, or 2
     
-    for (int step = 0; step < 32; step++) {
-        int row = step / 16;     // 0 or 1
-        int col = step % 16;     // 0-15
+    for (int i = 0; i < kPageSteps; i++) {
+        int step = (gridPage * kPageSteps) + i;
+        if (step >= a->maxSteps) break;
+        int row = i / 16;        // 0 or 1
+        int col = i % 16;        // 0-15
         
         int x = col * stepWidth;
         int y = startY + (row * rowHeight);
@@ -667,6 +1772,11 @@ bool draw(_NT_algorithm* self) {
         // Draw bar (filled rectangle from top to bottom)
         NT_drawShapeI(kNT_rectangle, x, barTopY, x + barWidth - 1, barBottomY, 255);
         
+        // Glide mark: a short line across the top of the bar
+        if (a->glideMarked(currentOutput, step)) {
+            NT_drawShapeI(kNT_line, x, y - 1, x + barWidth - 1, y - 1, 128);
+        }
+        
         // Draw step indicator if this is the current playing step
         if (step == a->currentStep) {
             // Draw small dot above the bar
@@ -686,9 +1796,9 @@ bool draw(_NT_algorithm* self) {
             NT_drawShapeI(kNT_rectangle, markerX, markerY, markerX + 1, markerY + 1, 255);
         }
         
-        // Draw separator dots between step groups (after steps 3, 7, 11, 19, 23, 27)
-        // These appear in the gap after every 4th step (4, 8, 12, 20, 24, 28 in 1-indexed)
-        if (step == 3 || step == 7 || step == 11 || step == 19 || step == 23 || step == 27) {
+        // Draw separator dots between step groups (after columns 3, 7 and 11 of each row)
+        // These appear in the gap after every 4th step (4, 8, 12 in 1-indexed)
+        if (col == 3 || col == 7 || col == 11) {
             int dotX = x + barWidth + (stepGap / 2);
             
             // Draw dots at 0%, 25%, 50%, 75%, 100% of bar height
@@ -712,17 +1822,17 @@ bool draw(_NT_algorithm* self) {
 
 uint32_t hasCustomUi(_NT_algorithm* self) {
     (void)self;
-    return kNT_potC | kNT_encoderL | kNT_encoderR | kNT_encoderButtonR;
+    return kNT_potC | kNT_encoderL | kNT_encoderR | kNT_encoderButtonL | kNT_encoderButtonR;
 }
 
 void handleUi(_NT_algorithm* self, const _NT_uiData& data) {
     V3Seq* a = (V3Seq*)self;
     
     // Get current sequencer range
-    int firstStep = self->v[kParamFirstStep];  // 1-32
-    int lastStep = self->v[kParamLastStep];    // 1-32
-    int startIndex = firstStep - 1;  // 0-31
-    int endIndex = lastStep - 1;     // 0-31
+    int firstStep = self->v[kParamFirstStep];  // 1 to Max Steps
+    int lastStep = self->v[kParamLastStep];
+    int startIndex = firstStep - 1;  // 0 to maxSteps-1
+    int endIndex = lastStep - 1;
     
     // Middle pot: select page (CV1, CV2, CV3) with catch behavior
     if (data.controls & kNT_potC) {
@@ -772,27 +1882,28 @@ void handleUi(_NT_algorithm* self, const _NT_uiData& data) {
     }
     a->lastEncoderRButton = data.controls;
     
+    // Left encoder button: mark/unmark the selected step for glide on the current page's output
+    uint16_t currentEncoderLButton = data.controls & kNT_encoderButtonL;
+    uint16_t lastEncoderLButton = a->lastEncoderLButton & kNT_encoderButtonL;
+    if (currentEncoderLButton && !lastEncoderLButton) {  // Rising edge
+        a->glideSteps[a->selectedPage][a->selectedStep >> 5] ^= (1u << (a->selectedStep & 31));
+    }
+    a->lastEncoderLButton = data.controls;
+    
     // Left encoder: modify value for current page's output on selected step
     if (data.encoders[0] != 0) {
         int delta = data.encoders[0];
         int currentOutput = a->selectedPage;  // 0, 1, or 2
         
         // Get current value
-        int16_t currentValue = a->stepValues[a->selectedStep][currentOutput];
-        
         // Calculate step size based on mode
         // Coarse: 25 total values = 65535/25 = 2621 units per step
         // Fine: 500 total values = 65535/500 = 131 units per step
         int stepSize = a->fineAdjustMode ? 131 : 2621;
         
-        // Increment by delta
-        int32_t newValue = (int32_t)currentValue + (delta * stepSize);
-        
-        // Clamp to valid range
-        if (newValue < -32768) newValue = -32768;
-        if (newValue > 32767) newValue = 32767;
-        
-        a->stepValues[a->selectedStep][currentOutput] = (int16_t)newValue;
+        // Increment by delta; step() applies it (and clamps) at the next block
+        a->editLog.add(a->selectedStep, currentOutput, delta * stepSize);
+        a->editLog.publish();
     }
 }
 
@@ -810,17 +1921,47 @@ void setupUi(_NT_algorithm* self, _NT_float3& pots) {
 void serialise(_NT_algorithm* self, _NT_jsonStream& stream) {
     V3Seq* a = (V3Seq*)self;
     
-    // Save all step values as 2D array
+    // Consistent copy of the steps: retry if step() wrote to them meanwhile
+    int16_t values[kMaxSteps][3];
+    size_t bytes = a->maxSteps * sizeof(values[0]);
+    for (;;) {
+        uint32_t version = __atomic_load_n(&a->stepsVersion, __ATOMIC_ACQUIRE);
+        if (version & 1) continue;
+        memcpy(values, a->stepValues, bytes);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&a->stepsVersion, __ATOMIC_ACQUIRE) == version) break;
+    }
+    
+    // Only steps up to the last one holding a value are saved (the rest are 0),
+    // so a 128-step instance using 16 steps saves and loads like a 16-step one
+    int usedSteps = a->maxSteps;
+    while (usedSteps > 0 && values[usedSteps - 1][0] == 0 && values[usedSteps - 1][1] == 0 &&
+           values[usedSteps - 1][2] == 0) {
+        usedSteps--;
+    }
+    
+    // Save the step values as 2D array
     stream.addMemberName("stepValues");
     stream.openArray();
-    for (int step = 0; step < 32; step++) {
+    for (int step = 0; step < usedSteps; step++) {
         stream.openArray();
         for (int out = 0; out < 3; out++) {
-            stream.addNumber((int)a->stepValues[step][out]);
+            stream.addNumber((int)values[step][out]);
         }
         stream.closeArray();
     }
     stream.closeArray();
+    
+    // Glide marks: per output, one 32-step bitmask word per 32 steps
+    int words = (a->maxSteps + 31) / 32;
+    stream.addMemberName("glideSteps");
+    stream.openArray();
+    for (int out = 0; out < 3; out++) {
+        for (int w = 0; w < words; w++) {
+            stream.addNumber((int)a->glideSteps[out][w]);
+        }
+    }
+    stream.closeArray();
 }
 
 bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
@@ -834,18 +1975,45 @@ bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
         if (parse.matchName("stepValues")) {
             int numSteps = 0;
             if (parse.numberOfArrayElements(numSteps)) {
-                int stepsToLoad = (numSteps < 32) ? numSteps : 32;
-                for (int step = 0; step < stepsToLoad; step++) {
+                // Staged for step(). Withdraw a load it has not taken yet first: step()
+                // interrupts this thread, so it never sees the copy half written.
+                __atomic_store_n(&a->loadPending, 0, __ATOMIC_RELAXED);
+                __atomic_signal_fence(__ATOMIC_SEQ_CST);
+                for (int step = 0; step < numSteps; step++) {
                     int numOutputs = 0;
                     if (parse.numberOfArrayElements(numOutputs)) {
-                        int outputsToLoad = (numOutputs < 3) ? numOutputs : 3;
-                        for (int out = 0; out < outputsToLoad; out++) {
+                        for (int out = 0; out < numOutputs; out++) {
                             int value;
-                            if (parse.number(value)) {
-                                a->stepValues[step][out] = (int16_t)value;
+                            if (parse.number(value) && step < a->maxSteps && out < 3) {
+                                a->loadValues[step][out] = (int16_t)value;
                             }
                         }
                     }
+                    // Outputs a short row leaves out are empty
+                    for (int out = (numOutputs > 0) ? numOutputs : 0; out < 3 && step < a->maxSteps; out++) {
+                        a->loadValues[step][out] = 0;
+                    }
+                }
+                // Steps the preset did not save are empty
+                for (int step = numSteps; step < a->maxSteps; step++) {
+                    for (int out = 0; out < 3; out++) {
+                        a->loadValues[step][out] = 0;
+                    }
+                }
+                __atomic_store_n(&a->loadPending, 1, __ATOMIC_RELEASE);
+            }
+        } else if (parse.matchName("glideSteps")) {
+            // 3 words (presets from 32-step versions) or 3 per output
+            int numWords = 0;
+            if (parse.numberOfArrayElements(numWords)) {
+                int words = (numWords > 3) ? numWords / 3 : 1;
+                for (int n = 0; n < numWords; n++) {
+                    int value;
+                    int out = n / words;
+                    int w = n % words;
+                    if (parse.number(value) && out < 3 && w < kMaxSteps / 32) {
+                        a->glideSteps[out][w] = (uint32_t)value;
+                    }
                 }
             }
         } else {
@@ -857,16 +2025,55 @@ bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
     return true;
 }
 
+void midiRealtime(_NT_algorithm* self, uint8_t byte) {
+    V3Seq* a = static_cast<V3Seq*>(self);
+    
+    if (byte == 0xF8) {
+        a->midiClock.receiveTick();  // Timing clock (24 PPQN)
+        return;
+    }
+    
+    // Transport only applies when following MIDI clock
+    if (self->v[kParamClockSource] == 0) return;
+    
+    switch (byte) {
+        case 0xFA: a->transportStart(); break;
+        case 0xFB: a->transportContinue(); break;
+        case 0xFC: a->transportStop(); break;
+    }
+}
+
+void midiMessage(_NT_algorithm* self, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    V3Seq* a = static_cast<V3Seq*>(self);
+    
+    // Song Position Pointer: 14-bit count of 16th notes since song start
+    if (byte0 == 0xF2 && self->v[kParamClockSource] != 0) {
+        uint32_t position = (byte1 & 0x7F) | ((uint32_t)(byte2 & 0x7F) << 7);
+        a->seekToPosition(position);
+    }
+}
+
 // =============================================================================
 // Plugin Factory
 // =============================================================================
 
+// Specifications for algorithm initialization
+static const _NT_specification specifications[] = {
+    {
+        .name = "Max Steps",
+        .min = kMinSteps,
+        .max = kMaxSteps,
+        .def = kMinSteps,
+        .type = kNT_typeGeneric
+    }
+};
+
 static const _NT_factory factory = {
     .guid = NT_MULTICHAR('V', '3', 'S', 'Q'),
     .name = "V3Seq",
     .description = "3-Output CV Sequencer",
-    .numSpecifications = 0,
-    .specifications = nullptr,
+    .numSpecifications = 1,
+    .specifications = specifications,
     .calculateStaticRequirements = nullptr,
     .initialise = nullptr,
     .calculateRequirements = calculateRequirements,
@@ -874,8 +2081,8 @@ static const _NT_factory factory = {
     .parameterChanged = parameterChanged,
     .step = step,
     .draw = draw,
-    .midiRealtime = nullptr,
-    .midiMessage = nullptr,
+    .midiRealtime = midiRealtime,
+    .midiMessage = midiMessage,
     .tags = kNT_tagUtility,
     .hasCustomUi = hasCustomUi,
     .customUi = handleUi,
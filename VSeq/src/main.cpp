@@ -6,414 +6,230 @@
 #include <cmath>
 #include <cstring>
 
+#include "seq_common.h"
+
 // VSeq: 3 CV sequencers + 1 gate sequencer
 // - Clock and Reset inputs
 // - 3 CV sequencers × 3 outputs = 9 CV outputs
 // - 1 Gate sequencer with 6 tracks
-// - Each sequencer has 32 steps
+// - Each sequencer has 32-128 steps (Max Steps specification), stored in DRAM
 // - Direction control: Forward, Backward, Pingpong
 // - Section looping with configurable repeats
 // - Fill feature for gate sequencer
+// - Sample-accurate event scheduler for clocks, triggers and MIDI
+// - MIDI note engine: per-output voices with gate length and legato ties
+// - Follows a CV clock, 24 PPQN MIDI clock, or either
+// - MIDI Start/Stop/Continue and Song Position Pointer
+// - Internal clock (BPM/PPQN) that can take over when the external clock stops
 
-struct VSeq : public _NT_algorithm {
-    // Sequencer data: 3 CV sequencers × 32 steps × 3 outputs
-    int16_t stepValues[3][32][3];
-    
-    // Gate sequencer data: 6 tracks × 32 steps
-    bool gateSteps[6][32];
-    
-    // CV Sequencer state (3 sequencers)
-    int currentStep[3];         // Current step for each sequencer (0-31)
-    bool pingpongForward[3];    // Direction state for pingpong mode
-    int section1Counter[3];     // Track section 1 repeat count
-    int section2Counter[3];     // Track section 2 repeat count
-    bool inSection2[3];         // Which section is currently playing
-    int clockCounter[3];        // Clock division counter
-    int internalClockCounter[3]; // Internal subdivision counter for multiplication
-    int lastClockPeriod[3];     // Samples between last two clocks (for multiplication)
-    int samplesSinceLastClock[3]; // Sample counter since last clock
-    
-    // Gate sequencer state (6 tracks)
-    int gateCurrentStep[6];     // Current step for each gate track (0-31)
-    bool gatePingpongForward[6]; // Direction state for pingpong mode
-    int gateSwingCounter[6];    // Counter for swing timing
-    int gateSection1Counter[6]; // Track section 1 repeat count
-    int gateSection2Counter[6]; // Track section 2 repeat count
-    bool gateInSection2[6];     // Which section is currently playing
-    bool gateInFill[6];         // Whether we're in the fill section
-    int gateTriggerCounter[6];  // Countdown for trigger pulse duration
-    bool gateTriggered[6];      // Whether gate was just triggered this step
-    int gateClockCounter[6];    // Clock division counter for gate tracks
-    int gateInternalClockCounter[6]; // Internal subdivision counter for multiplication
-    int gateLastClockPeriod[6]; // Samples between last two clocks (for multiplication)
-    int gateSamplesSinceLastClock[6]; // Sample counter since last clock
+// Scheduled event types. When two events share a sample time they are
+// dispatched in this order, so a gate always closes before the next one opens.
+enum {
+    kEvtReset = 0,
+    kEvtTrigOff,        // End of a gate track trigger pulse
+    kEvtClockOutOff,    // End of an internal clock output pulse
+    kEvtMidiNoteOff,
+    kEvtClock,          // Rising edge on the clock input
+    kEvtCvTick,         // Subdivision tick for a CV sequencer (clock multiplication)
+    kEvtGateTick,       // Subdivision tick for a gate track (clock multiplication)
+    kEvtTrigOn,         // Start of a gate track trigger pulse (possibly swing-delayed)
+    kEvtMidiNoteOn,
+    kEvtMidiCC
+};
+
+struct SeqEvent {
+    uint32_t time;      // Absolute sample time
+    uint8_t type;       // kEvt*
+    uint8_t target;     // Sequencer, track or output index
+    uint8_t data1;      // Type specific (subdivision index, note, CC number)
+    uint8_t data2;      // Type specific (epoch tag, velocity, CC value)
+};
+
+// Fixed-capacity min-heap of events ordered by sample time. The storage is in
+// SRAM after the seq, output and track states, sized from the layout (see
+// VSeq::eventCapacity).
+struct EventQueue {
+    SeqEvent* heap;
+    int capacity;
+    int count;
     
-    // Edge detection
-    float lastClockIn;
-    float lastResetIn;
+    EventQueue() : heap(NULL), capacity(0), count(0) {}
     
-    // UI state
-    int selectedStep;           // 0-31
-    int selectedSeq;            // 0-2 for CV seqs, 3 for gate seq
-    int selectedTrack;          // 0-5 (for gate sequencer)
-    int lastSelectedStep;       // Track when step changes to update pots
-    uint16_t lastButton4State;  // For debouncing button 4
-    uint16_t lastEncoderRButton; // For debouncing right encoder button
-    float lastPotLValue;        // Track left pot position for relative movement
-    bool potCaught[3];          // Track if each pot has caught the step value
-    bool trackPotCaught;        // Track if left pot has caught track position (for gate seq)
+    void place(SeqEvent* memory, int size) {
+        heap = memory;
+        capacity = size;
+        count = 0;
+    }
     
-    // Debug: track actual output bus assignments
-    int debugOutputBus[12];
+    // Wrap-safe ordering on absolute sample time, then on event type
+    static bool before(const SeqEvent& x, const SeqEvent& y) {
+        int32_t diff = (int32_t)(x.time - y.time);
+        if (diff != 0) return diff < 0;
+        return x.type < y.type;
+    }
     
-    VSeq() {
-        // Initialize step values to test patterns (visible voltages)
-        // Each sequencer gets different voltage levels for testing
-        for (int seq = 0; seq < 3; seq++) {
-            for (int step = 0; step < 32; step++) {
-                for (int out = 0; out < 3; out++) {
-                    // Create test patterns: different voltages for each output
-                    // seq 0: 2V, 4V, 6V
-                    // seq 1: 1V, 3V, 5V
-                    // seq 2: 3V, 5V, 7V
-                    float voltage = 2.0f + (seq * 1.0f) + (out * 2.0f);
-                    if (seq == 1) voltage -= 1.0f;
-                    
-                    // Convert voltage (0-10V range) to int16_t (-32768 to 32767)
-                    // 0V = -32768, 10V = 32767
-                    float normalized = voltage / 10.0f;  // 0.0-1.0
-                    stepValues[seq][step][out] = (int16_t)((normalized * 65535.0f) - 32768.0f);
-                }
-            }
-            currentStep[seq] = 0;
-            pingpongForward[seq] = true;
-            section1Counter[seq] = 0;
-            section2Counter[seq] = 0;
-            inSection2[seq] = false;
-            clockCounter[seq] = 0;
-            internalClockCounter[seq] = 0;
-            lastClockPeriod[seq] = 4800;  // Default ~10Hz at 48kHz
-            samplesSinceLastClock[seq] = 0;
-        }
-        
-        lastClockIn = 0.0f;
-        lastResetIn = 0.0f;
-        selectedStep = 0;
-        selectedSeq = 0;
-        selectedTrack = 0;
-        lastSelectedStep = 0;
-        lastButton4State = 0;
-        lastEncoderRButton = 0;
-        lastPotLValue = 0.5f;
-        potCaught[0] = false;
-        potCaught[1] = false;
-        potCaught[2] = false;
-        trackPotCaught = false;
-        
-        // Initialize gate sequencer
-        for (int track = 0; track < 6; track++) {
-            for (int step = 0; step < 32; step++) {
-                gateSteps[track][step] = false;
-            }
-            gateCurrentStep[track] = 0;
-            gatePingpongForward[track] = true;
-            gateSwingCounter[track] = 0;
-            gateSection1Counter[track] = 0;
-            gateSection2Counter[track] = 0;
-            gateInSection2[track] = false;
-            gateInFill[track] = false;
-            gateTriggerCounter[track] = 0;
-            gateClockCounter[track] = 0;
-            gateTriggered[track] = false;
-            gateInternalClockCounter[track] = 0;
-            gateLastClockPeriod[track] = 4800;  // Default ~10Hz at 48kHz
-            gateSamplesSinceLastClock[track] = 0;
-        }
-        
-        for (int i = 0; i < 12; i++) {
-            debugOutputBus[i] = 0;
+    bool push(const SeqEvent& e) {
+        if (count >= capacity) return false;  // Queue full (see VSeq::schedule)
+        int i = count++;
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!before(e, heap[parent])) break;
+            heap[i] = heap[parent];
+            i = parent;
         }
+        heap[i] = e;
+        return true;
     }
     
-    // Advance sequencer to next step based on direction, with section looping
-    void advanceSequencer(int seq, int direction, int stepCount, int splitPoint, int sec1Reps, int sec2Reps) {
-        // If no sections (splitPoint >= stepCount), use simple wrapping logic
-        if (splitPoint >= stepCount) {
-            if (direction == 0) {
-                // Forward
-                currentStep[seq]++;
-                if (currentStep[seq] >= stepCount) {
-                    currentStep[seq] = 0;
-                }
-            } else if (direction == 1) {
-                // Backward
-                currentStep[seq]--;
-                if (currentStep[seq] < 0) {
-                    currentStep[seq] = stepCount - 1;
-                }
-            } else {
-                // Pingpong
-                if (pingpongForward[seq]) {
-                    currentStep[seq]++;
-                    if (currentStep[seq] >= stepCount) {
-                        currentStep[seq] = stepCount - 1;
-                        pingpongForward[seq] = false;
-                    }
-                } else {
-                    currentStep[seq]--;
-                    if (currentStep[seq] < 0) {
-                        currentStep[seq] = 0;
-                        pingpongForward[seq] = true;
-                    }
-                }
-            }
-            return;
-        }
-        
-        // Section-based logic
-        if (direction == 0) {
-            // Forward
-            currentStep[seq]++;
-            
-            // Check if we've reached the end of a section
-            if (!inSection2[seq]) {
-                // In section 1
-                if (currentStep[seq] >= splitPoint) {
-                    section1Counter[seq]++;
-                    if (section1Counter[seq] >= sec1Reps) {
-                        // Move to section 2
-                        inSection2[seq] = true;
-                        section1Counter[seq] = 0;
-                    } else {
-                        // Repeat section 1
-                        currentStep[seq] = 0;
-                    }
-                }
-            } else {
-                // In section 2
-                if (currentStep[seq] >= stepCount) {
-                    section2Counter[seq]++;
-                    if (section2Counter[seq] >= sec2Reps) {
-                        // Loop back to section 1
-                        inSection2[seq] = false;
-                        section2Counter[seq] = 0;
-                        currentStep[seq] = 0;
-                    } else {
-                        // Repeat section 2
-                        currentStep[seq] = splitPoint;
-                    }
-                }
-            }
-        } else if (direction == 1) {
-            // Backward
-            currentStep[seq]--;
-            
-            // Check if we've reached the start of a section
-            if (inSection2[seq]) {
-                // In section 2
-                if (currentStep[seq] < splitPoint) {
-                    section2Counter[seq]++;
-                    if (section2Counter[seq] >= sec2Reps) {
-                        // Move to section 1
-                        inSection2[seq] = false;
-                        section2Counter[seq] = 0;
-                    } else {
-                        // Repeat section 2
-                        currentStep[seq] = stepCount - 1;
-                    }
-                }
-            } else {
-                // In section 1
-                if (currentStep[seq] < 0) {
-                    section1Counter[seq]++;
-                    if (section1Counter[seq] >= sec1Reps) {
-                        // Move to section 2
-                        inSection2[seq] = true;
-                        section1Counter[seq] = 0;
-                        currentStep[seq] = stepCount - 1;
-                    } else {
-                        // Repeat section 1
-                        currentStep[seq] = splitPoint - 1;
-                    }
-                }
-            }
-        } else {
-            // Pingpong
-            if (pingpongForward[seq]) {
-                currentStep[seq]++;
-                if (currentStep[seq] >= stepCount) {
-                    currentStep[seq] = stepCount - 1;
-                    pingpongForward[seq] = false;
-                }
-            } else {
-                currentStep[seq]--;
-                if (currentStep[seq] <= 0) {
-                    currentStep[seq] = 0;
-                    pingpongForward[seq] = true;
-                }
-            }
+    const SeqEvent& top() const { return heap[0]; }
+    
+    void pop() {
+        SeqEvent last = heap[--count];
+        int i = 0;
+        for (;;) {
+            int child = (2 * i) + 1;
+            if (child >= count) break;
+            if (child + 1 < count && before(heap[child + 1], heap[child])) child++;
+            if (!before(heap[child], last)) break;
+            heap[i] = heap[child];
+            i = child;
         }
+        heap[i] = last;
     }
     
-    void resetSequencer(int seq) {
-        int direction = 0;  // Will be set from parameters in process()
-        if (direction == 1) {
-            // Backward: start at last step
-            currentStep[seq] = 31;
-        } else {
-            // Forward and Pingpong: start at step 0
-            currentStep[seq] = 0;
-        }
-        pingpongForward[seq] = true;
-        section1Counter[seq] = 0;
-        section2Counter[seq] = 0;
-        inSection2[seq] = false;
+    // True if the earliest event is due before the given sample time
+    bool dueBefore(uint32_t time) const {
+        return count > 0 && (int32_t)(heap[0].time - time) < 0;
+    }
+};
+
+// Where a kEvtClock came from (event data1)
+enum {
+    kClockFromCv = 0,
+    kClockFromMidi,
+    kClockFromInternal
+};
+
+// Modulation targets: the playback setting of a CV seq or gate track (or of all
+// of them) that a modulation input moves
+enum {
+    kModLength,
+    kModDirection,
+    kModClockDiv,
+    kModSwing,          // Gate tracks only
+    kModTranspose,      // CV seqs only, 1V/octave at 100% depth
+    kNumModTargets
+};
+
+static const int kNumPatterns = 16;
+
+// Up to 8 CV sequencers with 1-3 outputs each, and up to 6 gate tracks, chosen
+// by the "Layout" specification (see kLayouts). The default (3 × 3 + 6) is the
+// original fixed layout.
+static const int kMaxSeqs = 8;
+static const int kDefaultSeqs = 3;
+static const int kMaxOuts = 3;
+static const int kMaxGateTracks = 6;
+
+// Pattern slot (and transform view base) of the gate sequencer. CV seqs are
+// slots 0-7, so the gate sequencer keeps the same slot whatever the seq count.
+static const int kGateSlot = kMaxSeqs;
+
+struct SeqLayout {
+    int numSeqs;        // CV sequencers (1-8)
+    int numOuts;        // Outputs per CV sequencer (1-3)
+    int numTracks;      // Gate tracks (0-6)
+};
+
+// Pattern banks (DRAM): 16 patterns for each CV sequencer and for the gate
+// sequencer, maxSteps steps each. The size comes from the specifications, so
+// the layout is worked out at construction.
+typedef int16_t CvStep[3];  // One step of a CV sequencer: 3 outputs
+
+struct PatternBank {
+    int maxSteps;
+    int numTracks;
+    CvStep* cv;         // [seq][pattern][step], maxSteps steps per pattern
+    bool* gate;         // [pattern][track][step], maxSteps steps per track
+    
+    static uint32_t bytesFor(const SeqLayout& layout, int maxSteps) {
+        return (uint32_t)(layout.numSeqs * kNumPatterns * maxSteps) * sizeof(CvStep) +
+               (uint32_t)(kNumPatterns * layout.numTracks * maxSteps) * sizeof(bool);
     }
     
-    // Advance gate sequencer to next step based on direction, with section looping and fill
-    void advanceGateSequencer(int track, int direction, int trackLength, int splitPoint, 
-                              int sec1Reps, int sec2Reps, int fillStart) {
-        // If no sections (splitPoint >= trackLength), use simple wrapping logic
-        if (splitPoint >= trackLength) {
-            if (direction == 0) {
-                // Forward
-                gateCurrentStep[track]++;
-                if (gateCurrentStep[track] >= trackLength) {
-                    gateCurrentStep[track] = 0;
-                }
-            } else if (direction == 1) {
-                // Backward
-                gateCurrentStep[track]--;
-                if (gateCurrentStep[track] < 0) {
-                    gateCurrentStep[track] = trackLength - 1;
-                }
-            } else if (direction == 2) {
-                // Pingpong
-                if (gatePingpongForward[track]) {
-                    gateCurrentStep[track]++;
-                    if (gateCurrentStep[track] >= trackLength) {
-                        gateCurrentStep[track] = trackLength - 2;
-                        if (gateCurrentStep[track] < 0) gateCurrentStep[track] = 0;
-                        gatePingpongForward[track] = false;
-                    }
-                } else {
-                    gateCurrentStep[track]--;
-                    if (gateCurrentStep[track] < 0) {
-                        gateCurrentStep[track] = 1;
-                        if (gateCurrentStep[track] >= trackLength) gateCurrentStep[track] = trackLength - 1;
-                        gatePingpongForward[track] = true;
-                    }
-                }
-            }
-            return;
-        }
-        
-        // Section-based logic
-        // Determine section boundaries
-        int section1End = (splitPoint > 0 && splitPoint < trackLength) ? splitPoint : trackLength;
-        
-        if (direction == 0) {  // Forward
-            gateCurrentStep[track]++;
-            
-            // Check for fill trigger on last repetition of section 1
-            // Only if sections are enabled (splitPoint < trackLength) AND fill is enabled (fillStart > 0)
-            // AND we're actually repeating section 1 (sec1Reps > 1)
-            if (!gateInSection2[track] && 
-                splitPoint > 0 && 
-                splitPoint < trackLength &&
-                fillStart > 0 &&
-                fillStart < splitPoint &&
-                sec1Reps > 1 &&
-                gateSection1Counter[track] == sec1Reps - 1 &&
-                gateCurrentStep[track] >= fillStart) {
-                // Fill triggered! Jump to section 2
-                gateSection1Counter[track] = 0;
-                gateInSection2[track] = true;
-                gateCurrentStep[track] = splitPoint;
-            }
-            // Check if we've crossed a section boundary
-            else if (!gateInSection2[track] && gateCurrentStep[track] >= section1End) {
-                // Completed section 1
-                gateSection1Counter[track]++;
-                if (gateSection1Counter[track] >= sec1Reps) {
-                    // Move to section 2
-                    gateSection1Counter[track] = 0;
-                    gateInSection2[track] = true;
-                    if (splitPoint > 0) {
-                        gateCurrentStep[track] = splitPoint;
-                    } else {
-                        gateCurrentStep[track] = 0;
-                    }
-                } else {
-                    // Repeat section 1
-                    gateCurrentStep[track] = 0;
-                }
-            } else if (gateInSection2[track] && gateCurrentStep[track] >= trackLength) {
-                // Completed section 2
-                gateSection2Counter[track]++;
-                if (gateSection2Counter[track] >= sec2Reps) {
-                    // Back to section 1
-                    gateSection2Counter[track] = 0;
-                    gateInSection2[track] = false;
-                }
-                gateCurrentStep[track] = (splitPoint > 0) ? splitPoint : 0;
-                if (!gateInSection2[track]) {
-                    gateCurrentStep[track] = 0;
-                }
-            }
-        } else if (direction == 1) {  // Backward
-            gateCurrentStep[track]--;
-            
-            if (gateInSection2[track] && gateCurrentStep[track] < splitPoint) {
-                gateSection2Counter[track]++;
-                if (gateSection2Counter[track] >= sec2Reps) {
-                    gateSection2Counter[track] = 0;
-                    gateInSection2[track] = false;
-                    gateCurrentStep[track] = section1End - 1;
-                } else {
-                    gateCurrentStep[track] = trackLength - 1;
-                }
-            } else if (!gateInSection2[track] && gateCurrentStep[track] < 0) {
-                gateSection1Counter[track]++;
-                if (gateSection1Counter[track] >= sec1Reps) {
-                    gateSection1Counter[track] = 0;
-                    gateInSection2[track] = true;
-                    gateCurrentStep[track] = trackLength - 1;
-                } else {
-                    gateCurrentStep[track] = section1End - 1;
-                }
-            }
-        } else if (direction == 2) {  // Pingpong
-            if (gatePingpongForward[track]) {
-                gateCurrentStep[track]++;
-                if (gateCurrentStep[track] >= trackLength) {
-                    gateCurrentStep[track] = trackLength - 2;
-                    if (gateCurrentStep[track] < 0) gateCurrentStep[track] = 0;
-                    gatePingpongForward[track] = false;
-                }
-            } else {
-                gateCurrentStep[track]--;
-                if (gateCurrentStep[track] < 0) {
-                    gateCurrentStep[track] = 1;
-                    if (gateCurrentStep[track] >= trackLength) gateCurrentStep[track] = trackLength - 1;
-                    gatePingpongForward[track] = true;
-                }
-            }
-        }
+    void place(uint8_t* dram, const SeqLayout& layout, int steps) {
+        maxSteps = steps;
+        numTracks = layout.numTracks;
+        cv = reinterpret_cast<CvStep*>(dram);
+        gate = reinterpret_cast<bool*>(dram + (layout.numSeqs * kNumPatterns * maxSteps) * sizeof(CvStep));
+    }
+    
+    CvStep* cvPattern(int seq, int pattern) const {
+        return cv + ((seq * kNumPatterns) + pattern) * maxSteps;
+    }
+    
+    // Track t of the pattern starts at [t * maxSteps]
+    bool* gatePattern(int pattern) const {
+        return gate + (pattern * numTracks) * maxSteps;
     }
 };
 
-// Helper function to set a pixel in NT_screen
-// Screen is 256x64, stored as 128x64 bytes (2 pixels per byte, 4-bit grayscale)
-inline void setPixel(int x, int y, int brightness) {
-    if (x < 0 || x >= 256 || y < 0 || y >= 64) return;
+// Step edits from customUi reach step() through a single-producer /
+// single-consumer log. The UI appends edits and then publishes the whole batch
+// with one index store; step() applies everything published at the start of a
+// block. Neither side locks or copies a pattern, and a multi-field edit (all three
+// outputs of a step) is never seen half-done by the audio thread.
+enum {
+    kEditCvValue,       // bank.cvPattern(slot, pattern)[step][index] = value
+    kEditGate,          // bank.gatePattern(pattern)[index * maxSteps + step] = value != 0
+    kEditCommit         // Transform of slot (CV seq, or kGateSlot + track in index) is now baked in
+};
+
+struct StepEdit {
+    uint8_t type;
+    uint8_t slot;       // CV sequencer (0-7), unused for gates
+    uint8_t pattern;    // Pattern the edit was made on
+    uint8_t step;
+    uint8_t index;      // Output (CV) or track (gate)
+    int16_t value;
+};
+
+// Ring buffer size, a power of two: a whole committed CV pattern (kMaxSteps × 3
+// edits) fits
+static const uint32_t kEditLogSize = 512;
+
+struct EditLog {
+    StepEdit edits[kEditLogSize];
+    uint32_t pending;           // UI write position (not yet visible to step())
+    uint32_t published;         // Written by the UI only
+    uint32_t applied;           // Written by step() only
     
-    int byteIndex = (y * 128) + (x / 2);
-    int pixelShift = (x & 1) ? 0 : 4;  // Even pixels in high nibble, odd in low
+    EditLog() : pending(0), published(0), applied(0) {}
     
-    // Clear the nibble and set new value
-    NT_screen[byteIndex] = (NT_screen[byteIndex] & (0x0F << (4 - pixelShift))) | ((brightness & 0x0F) << pixelShift);
-}
+    // UI side: room left before add() starts dropping edits
+    uint32_t space() const {
+        return kEditLogSize - (pending - __atomic_load_n(&applied, __ATOMIC_ACQUIRE));
+    }
+    
+    // UI side: queue an edit. Returns false (edit dropped) if step() is a whole log behind.
+    bool add(uint8_t type, int slot, int pattern, int step, int index, int16_t value) {
+        if (pending - __atomic_load_n(&applied, __ATOMIC_ACQUIRE) >= kEditLogSize) return false;
+        StepEdit& e = edits[pending & (kEditLogSize - 1)];
+        e.type = type;
+        e.slot = (uint8_t)slot;
+        e.pattern = (uint8_t)pattern;
+        e.step = (uint8_t)step;
+        e.index = (uint8_t)index;
+        e.value = value;
+        pending++;
+        return true;
+    }
+    
+    // UI side: hand everything added so far to step() in one store
+    void publish() {
+        __atomic_store_n(&published, pending, __ATOMIC_RELEASE);
+    }
+};
 
 // Parameter indices
 enum {
@@ -535,60 +351,1038 @@ enum {
     kParamGate6Section1Reps,
     kParamGate6Section2Reps,
     kParamGate6FillStart,
+    // MIDI note gate length per CV sequencer (% of step, 100 = legato/tie)
+    kParamSeq1GateLength,
+    kParamSeq2GateLength,
+    kParamSeq3GateLength,
+    // Clock source: CV, MIDI, or either
+    kParamClockSource,
+    // Internal clock
+    kParamInternalClock,
+    kParamBpm,
+    kParamPpqn,
+    kParamTakeover,
+    kParamClockOut,
+    // Pattern banks: next pattern per sequencer and when it takes over
+    kParamSeq1Pattern,
+    kParamSeq2Pattern,
+    kParamSeq3Pattern,
+    kParamGatePattern,
+    kParamPatternSwitch,
+    // Groove template for the gate tracks, and the 16 User template steps
+    kParamGroove,
+    kParamGrooveStep1,
+    kParamGrooveStep16 = kParamGrooveStep1 + 15,
+    // Scale quantizer per CV output (seq * 3 + out)
+    kParamSeq1Scale1,
+    kParamSeq3Scale3 = kParamSeq1Scale1 + 8,
+    kParamSeq1Root1,
+    kParamSeq3Root3 = kParamSeq1Root1 + 8,
+    // Pattern transforms per CV sequencer (5 params per sequencer)
+    kParamSeq1Rotate,
+    kParamSeq1Reverse,
+    kParamSeq1Transpose,
+    kParamSeq1ValueScale,
+    kParamSeq1ValueOffset,
+    kParamSeq3ValueOffset = kParamSeq1Rotate + 14,
+    // Pattern transforms per gate track (3 params per track)
+    kParamGate1Rotate,
+    kParamGate1Reverse,
+    kParamGate1Invert,
+    kParamGate6Invert = kParamGate1Rotate + 17,
+    // Euclidean generator per gate track (3 params per track)
+    kParamGate1EuclidHits,
+    kParamGate1EuclidRotate,
+    kParamGate1EuclidAccent,
+    kParamGate6EuclidAccent = kParamGate1EuclidHits + 17,
+    // Turing (shift register) mode per CV sequencer (6 params per sequencer)
+    kParamSeq1TmMode,
+    kParamSeq1TmLength,
+    kParamSeq1TmFlip,
+    kParamSeq1TmFlipCv,
+    kParamSeq1TmRange,
+    kParamSeq1TmHarmony,
+    kParamSeq3TmHarmony = kParamSeq1TmMode + 17,
+    // Output mode (Add/Replace) of every output (seq * 3 + out, then the gate
+    // tracks and the clock output)
+    kParamSeq1Out1Mode,
+    kParamSeq3Out3Mode = kParamSeq1Out1Mode + 8,
+    kParamGate1OutMode,
+    kParamGate6OutMode = kParamGate1OutMode + 5,
+    kParamClockOutMode,
+    // Modulation inputs (4 params per input: In, Target, Dest, Depth)
+    kParamMod1In,
+    kParamMod1Target,
+    kParamMod1Dest,
+    kParamMod1Depth,
+    kParamMod4Depth = kParamMod1In + 15,
     kNumParameters
 };
 
-// String arrays for enum parameters
-static const char* const divisionStrings[] = {
-    "/16", "/15", "/14", "/13", "/12", "/11", "/10", "/9", "/8", "/7", "/6", "/5", "/4", "/3", "/2",
-    "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15", "x16", NULL
+// CV seqs 4-8 (when the CV Seqs specification asks for them) are appended after
+// kNumParameters, 34 each, in the order of the Seq 1 parameters: Out 1-3, MIDI 1-3,
+// Clock Div .. Sec2 Reps, Gate Len, Pattern, Scale 1-3, Root 1-3, the 5 transforms,
+// the 6 Turing parameters and Out 1-3 mode. Seqs 1-3 keep their original indices,
+// so the default configuration has the original parameter table and presets load
+// unchanged (parameters added since then are at the end).
+static const int kExtraSeqParams = 34;
+static const int kMaxLogicalParameters = kNumParameters + ((kMaxSeqs - kDefaultSeqs) * kExtraSeqParams);
+
+// Parameter table and page lists index with a uint8_t
+static const int kMaxParameters = 255;
+
+// Inputs, Internal Clock, Patterns, Groove, Outs + Params per seq, Gate Outs,
+// a page per gate track, the 4 transform/generator pages, then Modulation
+static const int kMaxPages = 4 + (2 * kMaxSeqs) + 1 + kMaxGateTracks + 4 + 1;
+
+// Per-seq parameter, named by its Seq 1 enum (kParamSeq1ClockDiv .. kParamSeq1Section2Reps,
+// kParamSeq1GateLength, kParamSeq1Pattern, kParamSeq1Rotate .. kParamSeq1ValueOffset,
+// kParamSeq1TmMode .. kParamSeq1TmHarmony)
+static inline int seqParam(int seq, int param) {
+    int stride, block;
+    if (param >= kParamSeq1TmMode) {
+        stride = 6;
+        block = 25 + (param - kParamSeq1TmMode);
+    } else if (param >= kParamSeq1Rotate) {
+        stride = 5;
+        block = 20 + (param - kParamSeq1Rotate);
+    } else if (param == kParamSeq1Pattern) {
+        stride = 1;
+        block = 13;
+    } else if (param == kParamSeq1GateLength) {
+        stride = 1;
+        block = 12;
+    } else {
+        stride = 6;
+        block = 6 + (param - kParamSeq1ClockDiv);
+    }
+    if (seq < kDefaultSeqs) return param + (seq * stride);
+    return kNumParameters + ((seq - kDefaultSeqs) * kExtraSeqParams) + block;
+}
+
+// Per-output parameter, named by its Seq 1 output 1 enum (kParamSeq1Out1,
+// kParamSeq1Midi1, kParamSeq1Scale1, kParamSeq1Root1, kParamSeq1Out1Mode)
+static inline int seqOutParam(int seq, int out, int param) {
+    if (seq < kDefaultSeqs) return param + (seq * 3) + out;
+    int block = (param == kParamSeq1Out1) ? 0 : (param == kParamSeq1Midi1) ? 3 : (param == kParamSeq1Scale1) ? 14 :
+                (param == kParamSeq1Root1) ? 17 : 31;
+    return kNumParameters + ((seq - kDefaultSeqs) * kExtraSeqParams) + block + out;
+}
+
+// Next-pattern parameter of a pattern slot (kGateSlot = the gate sequencer)
+static inline int patternParam(int slot) {
+    return (slot == kGateSlot) ? (int)kParamGatePattern : seqParam(slot, kParamSeq1Pattern);
+}
+
+// Parameters of a layout: 10 global ones plus 4 per modulation input, 19 shared
+// by the gate tracks (Trigger MIDI Ch, Gate Pattern, Groove and its 16 steps), 19
+// per CV seq plus 5 per output (Out, MIDI, Scale, Root, Out mode), and 18 per
+// gate track
+static inline int numParametersFor(const SeqLayout& layout) {
+    return 10 + (kNumModInputs * 4) + ((layout.numTracks > 0) ? 19 : 0) +
+           (layout.numSeqs * (19 + (5 * layout.numOuts))) + (layout.numTracks * 18);
+}
+
+// The layouts the "Layout" specification offers: every seq count and output
+// count that fits in kMaxParameters, each with as many gate tracks as still fit.
+// The NT's specifications are independent ranges, so separate seq, output and
+// track counts would offer combinations that can't be built (the default alone
+// uses all 255). Numbered from 1 on the NT, see the README for the list.
+static const SeqLayout kLayouts[] = {
+    { 1, 3, 6 }, { 1, 2, 6 }, { 1, 1, 6 },
+    { 2, 3, 6 }, { 2, 2, 6 }, { 2, 1, 6 },
+    { 3, 3, 6 }, { 3, 2, 6 }, { 3, 1, 6 },
+    { 4, 3, 4 }, { 4, 2, 5 }, { 4, 1, 6 },
+    { 5, 3, 2 }, { 5, 2, 3 }, { 5, 1, 5 },
+    { 6, 3, 0 }, { 6, 2, 2 }, { 6, 1, 3 },
+    { 7, 2, 0 }, { 7, 1, 2 },
+    { 8, 1, 1 }
 };
+static const int kNumLayouts = sizeof(kLayouts) / sizeof(kLayouts[0]);
+static const int kDefaultLayout = 7;    // 3 seqs × 3 outputs + 6 tracks
 
-static const char* const directionStrings[] = {
-    "Forward", "Backward", "Pingpong", NULL
+// Playback state of one CV sequencer
+struct CvSeqState {
+    CvStep* stepValues;         // Playing pattern, pointing into the DRAM bank
+    int currentStep;            // Current step (0 to maxSteps-1)
+    bool pingpongForward;       // Direction state for pingpong mode
+    int section1Counter;        // Section 1 repeat count
+    int section2Counter;        // Section 2 repeat count
+    bool inSection2;            // Which section is currently playing
+    int clockCounter;           // Clock division counter
+    
+    // Turing mode: a CV seq in Mode "Turing" plays a looping shift register
+    // instead of its steps. Each clocked step moves the register one place; the
+    // bit leaving the loop comes back in, flipped with the Flip probability.
+    uint32_t tmRegister;
+    XorShift32 tmRng;
+    float tmFlipCv;             // Flip CV input in volts (mean of the last block)
 };
 
-// Parameter name strings (must be static to persist)
-static char seq1DivName[] = "Seq 1 Clock Div";
-static char seq1DirName[] = "Seq 1 Direction";
-static char seq1StepName[] = "Seq 1 Steps";
-static char seq1SplitName[] = "Seq 1 Split Point";
-static char seq1Sec1Name[] = "Seq 1 Sec1 Reps";
-static char seq1Sec2Name[] = "Seq 1 Sec2 Reps";
-static char seq2DivName[] = "Seq 2 Clock Div";
-static char seq2DirName[] = "Seq 2 Direction";
-static char seq2StepName[] = "Seq 2 Steps";
-static char seq2SplitName[] = "Seq 2 Split Point";
-static char seq2Sec1Name[] = "Seq 2 Sec1 Reps";
-static char seq2Sec2Name[] = "Seq 2 Sec2 Reps";
-static char seq3DivName[] = "Seq 3 Clock Div";
-static char seq3DirName[] = "Seq 3 Direction";
-static char seq3StepName[] = "Seq 3 Steps";
-static char seq3SplitName[] = "Seq 3 Split Point";
-static char seq3Sec1Name[] = "Seq 3 Sec1 Reps";
-static char seq3Sec2Name[] = "Seq 3 Sec2 Reps";
-
-// MIDI channel parameter names
-static char seq1Midi1Name[] = "Seq 1 MIDI 1";
-static char seq1Midi2Name[] = "Seq 1 MIDI 2";
-static char seq1Midi3Name[] = "Seq 1 MIDI 3";
-static char seq2Midi1Name[] = "Seq 2 MIDI 1";
-static char seq2Midi2Name[] = "Seq 2 MIDI 2";
-static char seq2Midi3Name[] = "Seq 2 MIDI 3";
-static char seq3Midi1Name[] = "Seq 3 MIDI 1";
-static char seq3Midi2Name[] = "Seq 3 MIDI 2";
-static char seq3Midi3Name[] = "Seq 3 MIDI 3";
+// One CV output: its scale quantizer and its MIDI voice
+struct CvVoiceState {
+    // Quantizer table mapping the top 10 bits of a step value to a note
+    // (semitones above 0V). Built from the defaults at construction and rebuilt
+    // by parameterChanged when the output's scale or root changes, so step()
+    // only ever looks a note up.
+    uint8_t quantTable[1024];
+    
+    // One sounding note per output
+    int8_t note;                // Sounding MIDI note, -1 = none
+    uint8_t channel;            // Channel the note was sent on (0-15), so the note-off matches
+    uint32_t offTime;           // Sample time of the pending note-off (stale offs are ignored)
+};
 
-// Trigger sequencer MIDI channel
-static char triggerMidiChannelName[] = "Trigger MIDI Ch";
+// Playback state of one gate track
+struct GateTrackState {
+    int currentStep;            // Current step (0 to maxSteps-1)
+    bool pingpongForward;       // Direction state for pingpong mode
+    int section1Counter;        // Section 1 repeat count
+    int section2Counter;        // Section 2 repeat count
+    bool inSection2;            // Which section is currently playing
+    bool inFill;                // Whether we're in the fill section
+    int clockCounter;           // Clock division counter
+    bool high;                  // Current trigger output level
+    float level;                // Voltage of the current pulse (5V, 10V when accented)
+    uint32_t offTime;           // Sample time the current trigger pulse ends
+    
+    // Groove: per-step trigger delays in samples, rebuilt only when the track's
+    // step length (tempo, clock div) or the template changes
+    uint32_t grooveDelay[16];
+    int grooveStepLength;       // Step length the delays were computed for
+    uint32_t grooveTrackVersion; // grooveVersion the delays were computed for
+    
+    // Euclidean generator: a track in generatedTracks plays euclidMask (bit =
+    // step) instead of its stored steps, with accented hits in accentMask
+    StepBits euclidMask;
+    StepBits accentMask;
+};
 
-// Gate track parameter names
-static char gate1OutName[] = "Gate 1 Out";
-static char gate1CCName[] = "Gate 1 CC";
-static char gate2OutName[] = "Gate 2 Out";
-static char gate2CCName[] = "Gate 2 CC";
-static char gate3OutName[] = "Gate 3 Out";
-static char gate3CCName[] = "Gate 3 CC";
+// Outputs that write a bus, as writer ids: CV voices (seq * numOuts + out), then
+// the gate tracks, then the internal clock output
+static const int kWriterGate = kMaxSeqs * kMaxOuts;
+static const int kWriterClock = kWriterGate + kMaxGateTracks;
+static const int kMaxWriters = kWriterClock + 1;
+
+// Per-block output plan: the routed outputs grouped by destination bus, so each
+// bus is written once per render however many outputs share it. Outputs sharing
+// a bus are summed; the bus keeps its incoming signal only if all of them are in
+// Add mode. Rebuilt at the start of every block from the Out and mode parameters,
+// so outputs set to none (and stopped gate tracks) cost nothing.
+struct OutputPlan {
+    int numBuses;                   // Buses with at least one output routed to them
+    uint8_t bus[28];                // Destination bus (0-27) of each entry
+    bool replace[28];               // Replace the bus content, else add to it
+    uint8_t first[29];              // Entry i's writers are writers[first[i] .. first[i + 1])
+    uint8_t writers[kMaxWriters];
+};
+
+// Logical parameter index of a parameter this instance does not have
+static const uint8_t kNoParam = 255;
+
+struct VSeq : public _NT_algorithm {
+    // Configuration from the specifications. The per-seq, per-output and
+    // per-track states are placed in SRAM after this object (see construct),
+    // so an instance only pays for what it has.
+    SeqLayout layout;
+    int numSeqs;                // layout.numSeqs, used everywhere
+    int numOuts;
+    int numTracks;
+    CvSeqState* seqs;           // numSeqs entries
+    CvVoiceState* voices;       // numSeqs × numOuts entries, index seq * numOuts + out
+    GateTrackState* gates;      // numTracks entries
+    
+    // Parameters are addressed by their logical index (the enum, then seqs 4-8,
+    // see seqParam); paramIndex maps it to this instance's table, which only
+    // holds the parameters of the configured seqs, outputs and tracks.
+    uint8_t paramIndex[kMaxLogicalParameters];    // kNoParam = not in this instance
+    uint16_t logicalParam[kMaxParameters];        // Table index -> logical index
+    
+    // Mod Dest choices of this instance: All, its seqs, then its tracks
+    const char* modDestNames[1 + kMaxSeqs + kMaxGateTracks + 1];
+    int numParameters;
+    
+    // Parameter pages, generated for the configured seqs and tracks
+    _NT_parameterPage pageArray[kMaxPages];
+    _NT_parameterPages pages;
+    uint8_t pageParams[kMaxParameters];
+    
+    // Playing pattern of each sequencer, pointing into the DRAM bank.
+    // Switching patterns just moves these pointers, nothing is copied.
+    int maxSteps;                   // Steps per pattern (Max Steps specification)
+    PatternBank bank;
+    bool* gateSteps;                // numTracks tracks × maxSteps steps, see gateStep()
+    int activePattern[kMaxSeqs + 1]; // Playing pattern (0-15) of each CV seq, then the gate sequencer (kGateSlot)
+    uint32_t barClockCount;         // Clock pulses since reset, for switching on bar boundaries
+    EditLog editLog;                // Step edits on their way from customUi to step()
+    
+    // Preset loads: deserialise fills the second bank (after the first in DRAM,
+    // seeded from it) and the playing patterns and Turing registers to go with
+    // it, then sets loadPending. step() swaps the banks, so a load never writes
+    // the bank step() is playing.
+    PatternBank loadBank;
+    int loadActive[kMaxSeqs + 1];
+    uint32_t loadTm[kMaxSeqs];
+    uint32_t loadTmMask;            // Bit n = seq n has a register in loadTm
+    uint32_t loadPending;
+    
+    // Groove templates: bumped when a groove parameter changes, so the gate
+    // tracks rebuild their delays
+    uint32_t grooveVersion;
+    
+    // Event scheduling (all timing is in absolute samples)
+    EventQueue events;
+    uint32_t sampleTime;        // Sample time at the start of the current block
+    uint32_t lastClockTime;     // Sample time of the last clock edge
+    int clockPeriod;            // Samples between last two clocks (for multiplication and swing)
+    uint8_t clockEpoch;         // Bumped on every clock/reset; stale subdivision ticks are ignored
+    uint8_t resetEpoch;         // Bumped on every reset; cancels pending swing-delayed triggers
+    
+    // MIDI clock input
+    MidiClockFollower midiClock;
+    bool transportRunning;      // Cleared by MIDI Stop, set by Start/Continue
+    
+    // Internal clock
+    InternalClock internalClock;
+    uint32_t lastExternalTime;  // Sample time of the last CV or MIDI clock pulse
+    bool externalSeen;          // An external clock has arrived since construction
+    bool clockOutHigh;          // Internal clock output level
+    uint32_t clockOutOffTime;   // Sample time the clock output pulse ends
+    
+    // Edge detection
+    float lastClockIn;
+    float lastResetIn;
+    
+    // UI state
+    int selectedStep;           // 0 to maxSteps-1
+    int selectedSeq;            // 0 to numSeqs-1 for CV seqs, numSeqs for gate seq
+    int selectedTrack;          // 0 to numTracks-1 (for gate sequencer)
+    int lastSelectedStep;       // Track when step changes to update pots
+    uint16_t lastButton4State;  // For debouncing button 4
+    uint16_t lastEncoderRButton; // For debouncing right encoder button
+    float lastPotLValue;        // Track left pot position for relative movement
+    bool potCaught[3];          // Track if each pot has caught the step value
+    bool trackPotCaught;        // Track if left pot has caught track position (for gate seq)
+    
+    // Pattern transforms: bit per view (0-7 = CV seqs, kGateSlot + track = gate
+    // tracks) that has just been baked into the pattern and plays untransformed
+    // until its transform parameters are back at neutral
+    uint16_t transformBypass;
+    
+    // Euclidean generator: bit per gate track playing its generated steps.
+    // Rebuilt only when the track's Euclid parameters or Length change:
+    // parameterChanged marks it in euclidDirty, the next block regenerates it.
+    uint8_t generatedTracks;
+    uint32_t euclidDirty;
+    
+    // Debug: track actual output bus assignments
+    int debugOutputBus[12];
+    
+    // Which outputs write which bus this block (see OutputPlan)
+    OutputPlan outputPlan;
+    
+    // Modulation inputs. While any is assigned, modValues is this block's copy of
+    // the parameter table with their offsets folded in, and played() reads it;
+    // the parameters themselves are never written.
+    ModInput mods[kNumModInputs];
+    bool modulated;
+    int16_t modValues[kMaxParameters];
+    
+    // Events a layout can have pending: per CV seq a subdivision tick and a
+    // spare; per output a note-on and note-off, twice over for a tie overlapping
+    // the next note; per track a subdivision tick, swing or groove delayed
+    // trigs, the pulse end and its CC on and off; and 32 for the clock and
+    // reset edges and clock out pulse of one block
+    static int eventCapacity(const SeqLayout& l) {
+        return 32 + (l.numSeqs * 2) + (l.numSeqs * l.numOuts * 4) + (l.numTracks * 8);
+    }
+    
+    // SRAM taken by the seq, output and track states and the event queue of a layout
+    static uint32_t stateBytes(const SeqLayout& l) {
+        return (uint32_t)(l.numSeqs * sizeof(CvSeqState)) +
+               (uint32_t)(l.numSeqs * l.numOuts * sizeof(CvVoiceState)) +
+               (uint32_t)(l.numTracks * sizeof(GateTrackState)) +
+               (uint32_t)(eventCapacity(l) * sizeof(SeqEvent));
+    }
+    
+    VSeq(const SeqLayout& l, uint8_t* stateMemory) {
+        layout = l;
+        numSeqs = l.numSeqs;
+        numOuts = l.numOuts;
+        numTracks = l.numTracks;
+        seqs = reinterpret_cast<CvSeqState*>(stateMemory);
+        voices = reinterpret_cast<CvVoiceState*>(seqs + numSeqs);
+        gates = reinterpret_cast<GateTrackState*>(voices + (numSeqs * numOuts));
+        events.place(reinterpret_cast<SeqEvent*>(gates + numTracks), eventCapacity(l));
+        numParameters = 0;
+        
+        // Pattern data lives in DRAM and is set up by initPatterns() from construct()
+        maxSteps = kMinSteps;
+        bank.place(NULL, layout, 0);
+        loadBank.place(NULL, layout, 0);
+        loadTmMask = 0;
+        loadPending = 0;
+        gateSteps = NULL;
+        for (int i = 0; i <= kGateSlot; i++) {
+            activePattern[i] = 0;
+        }
+        barClockCount = 0;
+        transformBypass = 0;
+        generatedTracks = 0;
+        euclidDirty = (1u << numTracks) - 1u;  // First block builds from the loaded parameters
+        grooveVersion = 1;  // Forces the first build
+        
+        for (int seq = 0; seq < numSeqs; seq++) {
+            new (&seqs[seq]) CvSeqState();
+            seqs[seq].stepValues = NULL;
+            seqs[seq].currentStep = 0;
+            seqs[seq].pingpongForward = true;
+            seqs[seq].section1Counter = 0;
+            seqs[seq].section2Counter = 0;
+            seqs[seq].inSection2 = false;
+            seqs[seq].clockCounter = 0;
+            
+            // Different start per seq so Turing seqs don't play in unison
+            seqs[seq].tmRng.seed(0x2545F491u * (seq + 1));
+            seqs[seq].tmRegister = seqs[seq].tmRng.next();
+            seqs[seq].tmFlipCv = 0.0f;
+        }
+        
+        for (int i = 0; i < numSeqs * numOuts; i++) {
+            voices[i].note = -1;
+            voices[i].channel = 0;
+            voices[i].offTime = 0;
+        }
+        for (int seq = 0; seq < numSeqs; seq++) {
+            for (int out = 0; out < numOuts; out++) {
+                buildQuantTable(voice(seq, out), parameterDefault(seqOutParam(seq, out, kParamSeq1Scale1)),
+                                parameterDefault(seqOutParam(seq, out, kParamSeq1Root1)));
+            }
+        }
+        
+        sampleTime = 0;
+        lastClockTime = 0;
+        clockPeriod = 4800;  // Default ~10Hz at 48kHz
+        clockEpoch = 0;
+        resetEpoch = 0;
+        transportRunning = true;
+        lastExternalTime = 0;
+        externalSeen = false;
+        clockOutHigh = false;
+        clockOutOffTime = 0;
+        
+        lastClockIn = 0.0f;
+        lastResetIn = 0.0f;
+        selectedStep = 0;
+        selectedSeq = 0;
+        selectedTrack = 0;
+        lastSelectedStep = 0;
+        lastButton4State = 0;
+        lastEncoderRButton = 0;
+        lastPotLValue = 0.5f;
+        potCaught[0] = false;
+        potCaught[1] = false;
+        potCaught[2] = false;
+        trackPotCaught = false;
+        
+        // Initialize gate sequencer
+        for (int track = 0; track < numTracks; track++) {
+            gates[track].currentStep = 0;
+            gates[track].pingpongForward = true;
+            gates[track].section1Counter = 0;
+            gates[track].section2Counter = 0;
+            gates[track].inSection2 = false;
+            gates[track].inFill = false;
+            gates[track].clockCounter = 0;
+            gates[track].high = false;
+            gates[track].level = 5.0f;
+            gates[track].offTime = 0;
+            gates[track].grooveStepLength = 0;
+            gates[track].grooveTrackVersion = 0;
+            gates[track].euclidMask.clear();
+            gates[track].accentMask.clear();
+        }
+        
+        for (int i = 0; i < 12; i++) {
+            debugOutputBus[i] = 0;
+        }
+        outputPlan.numBuses = 0;
+        modulated = false;
+    }
+    
+    // Fill the DRAM pattern bank and point every sequencer at pattern 1
+    // (the preset load bank follows it, see loadBank)
+    void initPatterns(uint8_t* dram, int steps) {
+        maxSteps = steps;
+        bank.place(dram, layout, steps);
+        loadBank.place(dram + PatternBank::bytesFor(layout, steps), layout, steps);
+        
+        for (int seq = 0; seq < numSeqs; seq++) {
+            for (int pattern = 0; pattern < kNumPatterns; pattern++) {
+                CvStep* cv = bank.cvPattern(seq, pattern);
+                for (int step = 0; step < maxSteps; step++) {
+                    for (int out = 0; out < 3; out++) {
+                        cv[step][out] = initialStepValue(seq, out);
+                    }
+                }
+            }
+            seqs[seq].stepValues = bank.cvPattern(seq, 0);
+        }
+        
+        memset(bank.gate, 0, kNumPatterns * numTracks * maxSteps * sizeof(bool));
+        gateSteps = bank.gatePattern(0);
+    }
+    
+    // Voice (CV output state) of a seq's output
+    int voice(int seq, int out) const {
+        return (seq * numOuts) + out;
+    }
+    
+    // Value of a parameter by logical index; parameters this instance does not
+    // have read as their default
+    int16_t param(int logical) const {
+        uint8_t p = paramIndex[logical];
+        return (p == kNoParam) ? parameterDefault(logical) : v[p];
+    }
+    static int16_t parameterDefault(int logical);
+    
+    // Value of a playback setting as played this block: the parameter plus any
+    // modulation aimed at it. Only the audio side reads this; the UI, presets and
+    // commits work with the parameter as set.
+    int16_t played(int logical) const {
+        uint8_t p = paramIndex[logical];
+        if (p == kNoParam) return parameterDefault(logical);
+        return modulated ? modValues[p] : v[p];
+    }
+    
+    // Set a parameter by logical index (ignored if this instance does not have it)
+    void setParameterFromAudio(int logical, int16_t value) {
+        uint8_t p = paramIndex[logical];
+        if (p == kNoParam) return;
+        NT_setParameterFromAudio(NT_algorithmIndex(this), p + NT_parameterOffset(), value);
+    }
+    
+    // Debug: bus of the first 12 CV outputs, from their Out parameters (saved in
+    // presets). Only the Out parameters and a preset load change it, so it is
+    // synced from parameterChanged and deserialise, never per block.
+    void syncDebugOutputBus() {
+        for (int i = 0; i < 12; i++) {
+            int seq = i / numOuts;
+            debugOutputBus[i] = (seq < numSeqs) ? param(seqOutParam(seq, i % numOuts, kParamSeq1Out1)) : 0;
+        }
+    }
+    
+    // Test pattern every CV step starts at (visible voltages), different
+    // levels for each output:
+    // seq 0: 2V, 4V, 6V
+    // seq 1: 1V, 3V, 5V
+    // seq 2: 3V, 5V, 7V
+    // (seqs 4-8 repeat the levels of seqs 1-3)
+    static int16_t initialStepValue(int seq, int out) {
+        seq %= kDefaultSeqs;
+        float voltage = 2.0f + (seq * 1.0f) + (out * 2.0f);
+        if (seq == 1) voltage -= 1.0f;
+        
+        // Convert voltage (0-10V range) to int16_t (-32768 to 32767)
+        // 0V = -32768, 10V = 32767
+        float normalized = voltage / 10.0f;  // 0.0-1.0
+        return (int16_t)((normalized * 65535.0f) - 32768.0f);
+    }
+    
+    // Stored step of a gate track in the playing pattern
+    bool& gateStep(int track, int step) {
+        return gateSteps[(track * maxSteps) + step];
+    }
+    
+    // Audio side: apply every edit the UI has published (called at the start of step())
+    void applyEdits() {
+        uint32_t end = __atomic_load_n(&editLog.published, __ATOMIC_ACQUIRE);
+        for (uint32_t i = editLog.applied; i != end; i++) {
+            const StepEdit& e = editLog.edits[i & (kEditLogSize - 1)];
+            if (e.type == kEditCvValue) {
+                bank.cvPattern(e.slot, e.pattern)[e.step][e.index] = e.value;
+            } else if (e.type == kEditGate) {
+                bank.gatePattern(e.pattern)[(e.index * maxSteps) + e.step] = (e.value != 0);
+            } else {
+                finishCommit(e.slot < kGateSlot ? e.slot : kGateSlot + e.index);
+            }
+        }
+        __atomic_store_n(&editLog.applied, end, __ATOMIC_RELEASE);
+    }
+    
+    // UI side: start a preset load in loadBank, from the playing bank and patterns
+    void beginLoad() {
+        // Withdraw a load step() has not taken yet: step() interrupts this
+        // thread, so it never sees loadBank half written
+        __atomic_store_n(&loadPending, 0, __ATOMIC_RELAXED);
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+        memcpy(loadBank.cv, bank.cv, PatternBank::bytesFor(layout, maxSteps));
+        for (int i = 0; i <= kGateSlot; i++) {
+            loadActive[i] = activePattern[i];
+        }
+        loadTmMask = 0;
+    }
+    
+    // UI side: hand the load to step()
+    void endLoad() {
+        __atomic_store_n(&loadPending, 1, __ATOMIC_RELEASE);
+    }
+    
+    // Audio side: take a preset load (called after applyEdits, so edits made
+    // before the load don't land on top of it)
+    void applyLoad() {
+        if (!__atomic_load_n(&loadPending, __ATOMIC_ACQUIRE)) return;
+        PatternBank playing = bank;
+        bank = loadBank;
+        loadBank = playing;
+        for (int seq = 0; seq < numSeqs; seq++) {
+            selectPattern(seq, loadActive[seq]);
+            if (loadTmMask & (1u << seq)) seqs[seq].tmRegister = loadTm[seq];
+        }
+        selectPattern(kGateSlot, loadActive[kGateSlot]);
+        __atomic_store_n(&loadPending, 0, __ATOMIC_RELAXED);
+    }
+    
+    // Make a pattern the playing one (slot = CV seq, or kGateSlot for the gate sequencer)
+    void selectPattern(int slot, int pattern) {
+        if (pattern < 0 || pattern >= kNumPatterns) return;
+        if (slot == kGateSlot) {
+            activePattern[slot] = pattern;
+            gateSteps = bank.gatePattern(pattern);
+        } else if (slot < numSeqs) {
+            activePattern[slot] = pattern;
+            seqs[slot].stepValues = bank.cvPattern(slot, pattern);
+        }
+    }
+    
+    // Advance sequencer to next step based on direction, with section looping
+    void advanceSequencer(int seq, int direction, int stepCount, int splitPoint, int sec1Reps, int sec2Reps) {
+        // If no sections (splitPoint >= stepCount), use simple wrapping logic
+        if (splitPoint >= stepCount) {
+            if (direction == 0) {
+                // Forward
+                seqs[seq].currentStep++;
+                if (seqs[seq].currentStep >= stepCount) {
+                    seqs[seq].currentStep = 0;
+                }
+            } else if (direction == 1) {
+                // Backward
+                seqs[seq].currentStep--;
+                if (seqs[seq].currentStep < 0) {
+                    seqs[seq].currentStep = stepCount - 1;
+                }
+            } else {
+                // Pingpong
+                if (seqs[seq].pingpongForward) {
+                    seqs[seq].currentStep++;
+                    if (seqs[seq].currentStep >= stepCount) {
+                        seqs[seq].currentStep = stepCount - 1;
+                        seqs[seq].pingpongForward = false;
+                    }
+                } else {
+                    seqs[seq].currentStep--;
+                    if (seqs[seq].currentStep < 0) {
+                        seqs[seq].currentStep = 0;
+                        seqs[seq].pingpongForward = true;
+                    }
+                }
+            }
+            return;
+        }
+        
+        // Section-based logic
+        if (direction == 0) {
+            // Forward
+            seqs[seq].currentStep++;
+            
+            // Check if we've reached the end of a section
+            if (!seqs[seq].inSection2) {
+                // In section 1
+                if (seqs[seq].currentStep >= splitPoint) {
+                    seqs[seq].section1Counter++;
+                    if (seqs[seq].section1Counter >= sec1Reps) {
+                        // Move to section 2
+                        seqs[seq].inSection2 = true;
+                        seqs[seq].section1Counter = 0;
+                    } else {
+                        // Repeat section 1
+                        seqs[seq].currentStep = 0;
+                    }
+                }
+            } else {
+                // In section 2
+                if (seqs[seq].currentStep >= stepCount) {
+                    seqs[seq].section2Counter++;
+                    if (seqs[seq].section2Counter >= sec2Reps) {
+                        // Loop back to section 1
+                        seqs[seq].inSection2 = false;
+                        seqs[seq].section2Counter = 0;
+                        seqs[seq].currentStep = 0;
+                    } else {
+                        // Repeat section 2
+                        seqs[seq].currentStep = splitPoint;
+                    }
+                }
+            }
+        } else if (direction == 1) {
+            // Backward
+            seqs[seq].currentStep--;
+            
+            // Check if we've reached the start of a section
+            if (seqs[seq].inSection2) {
+                // In section 2
+                if (seqs[seq].currentStep < splitPoint) {
+                    seqs[seq].section2Counter++;
+                    if (seqs[seq].section2Counter >= sec2Reps) {
+                        // Move to section 1
+                        seqs[seq].inSection2 = false;
+                        seqs[seq].section2Counter = 0;
+                    } else {
+                        // Repeat section 2
+                        seqs[seq].currentStep = stepCount - 1;
+                    }
+                }
+            } else {
+                // In section 1
+                if (seqs[seq].currentStep < 0) {
+                    seqs[seq].section1Counter++;
+                    if (seqs[seq].section1Counter >= sec1Reps) {
+                        // Move to section 2
+                        seqs[seq].inSection2 = true;
+                        seqs[seq].section1Counter = 0;
+                        seqs[seq].currentStep = stepCount - 1;
+                    } else {
+                        // Repeat section 1
+                        seqs[seq].currentStep = splitPoint - 1;
+                    }
+                }
+            }
+        } else {
+            // Pingpong
+            if (seqs[seq].pingpongForward) {
+                seqs[seq].currentStep++;
+                if (seqs[seq].currentStep >= stepCount) {
+                    seqs[seq].currentStep = stepCount - 1;
+                    seqs[seq].pingpongForward = false;
+                }
+            } else {
+                seqs[seq].currentStep--;
+                if (seqs[seq].currentStep <= 0) {
+                    seqs[seq].currentStep = 0;
+                    seqs[seq].pingpongForward = true;
+                }
+            }
+        }
+    }
+    
+    void resetSequencer(int seq) {
+        int direction = 0;  // Will be set from parameters in process()
+        if (direction == 1) {
+            // Backward: start at last step
+            seqs[seq].currentStep = maxSteps - 1;
+        } else {
+            // Forward and Pingpong: start at step 0
+            seqs[seq].currentStep = 0;
+        }
+        seqs[seq].pingpongForward = true;
+        seqs[seq].section1Counter = 0;
+        seqs[seq].section2Counter = 0;
+        seqs[seq].inSection2 = false;
+    }
+    
+    // Advance gate sequencer to next step based on direction, with section looping and fill
+    void advanceGateSequencer(int track, int direction, int trackLength, int splitPoint, 
+                              int sec1Reps, int sec2Reps, int fillStart) {
+        // If no sections (splitPoint >= trackLength), use simple wrapping logic
+        if (splitPoint >= trackLength) {
+            if (direction == 0) {
+                // Forward
+                gates[track].currentStep++;
+                if (gates[track].currentStep >= trackLength) {
+                    gates[track].currentStep = 0;
+                }
+            } else if (direction == 1) {
+                // Backward
+                gates[track].currentStep--;
+                if (gates[track].currentStep < 0) {
+                    gates[track].currentStep = trackLength - 1;
+                }
+            } else if (direction == 2) {
+                // Pingpong
+                if (gates[track].pingpongForward) {
+                    gates[track].currentStep++;
+                    if (gates[track].currentStep >= trackLength) {
+                        gates[track].currentStep = trackLength - 2;
+                        if (gates[track].currentStep < 0) gates[track].currentStep = 0;
+                        gates[track].pingpongForward = false;
+                    }
+                } else {
+                    gates[track].currentStep--;
+                    if (gates[track].currentStep < 0) {
+                        gates[track].currentStep = 1;
+                        if (gates[track].currentStep >= trackLength) gates[track].currentStep = trackLength - 1;
+                        gates[track].pingpongForward = true;
+                    }
+                }
+            }
+            return;
+        }
+        
+        // Section-based logic
+        // Determine section boundaries
+        int section1End = (splitPoint > 0 && splitPoint < trackLength) ? splitPoint : trackLength;
+        
+        if (direction == 0) {  // Forward
+            gates[track].currentStep++;
+            
+            // Check for fill trigger on last repetition of section 1
+            // Only if sections are enabled (splitPoint < trackLength) AND fill is enabled (fillStart > 0)
+            // AND we're actually repeating section 1 (sec1Reps > 1)
+            if (!gates[track].inSection2 && 
+                splitPoint > 0 && 
+                splitPoint < trackLength &&
+                fillStart > 0 &&
+                fillStart < splitPoint &&
+                sec1Reps > 1 &&
+                gates[track].section1Counter == sec1Reps - 1 &&
+                gates[track].currentStep >= fillStart) {
+                // Fill triggered! Jump to section 2
+                gates[track].section1Counter = 0;
+                gates[track].inSection2 = true;
+                gates[track].currentStep = splitPoint;
+            }
+            // Check if we've crossed a section boundary
+            else if (!gates[track].inSection2 && gates[track].currentStep >= section1End) {
+                // Completed section 1
+                gates[track].section1Counter++;
+                if (gates[track].section1Counter >= sec1Reps) {
+                    // Move to section 2
+                    gates[track].section1Counter = 0;
+                    gates[track].inSection2 = true;
+                    if (splitPoint > 0) {
+                        gates[track].currentStep = splitPoint;
+                    } else {
+                        gates[track].currentStep = 0;
+                    }
+                } else {
+                    // Repeat section 1
+                    gates[track].currentStep = 0;
+                }
+            } else if (gates[track].inSection2 && gates[track].currentStep >= trackLength) {
+                // Completed section 2
+                gates[track].section2Counter++;
+                if (gates[track].section2Counter >= sec2Reps) {
+                    // Back to section 1
+                    gates[track].section2Counter = 0;
+                    gates[track].inSection2 = false;
+                }
+                gates[track].currentStep = (splitPoint > 0) ? splitPoint : 0;
+                if (!gates[track].inSection2) {
+                    gates[track].currentStep = 0;
+                }
+            }
+        } else if (direction == 1) {  // Backward
+            gates[track].currentStep--;
+            
+            if (gates[track].inSection2 && gates[track].currentStep < splitPoint) {
+                gates[track].section2Counter++;
+                if (gates[track].section2Counter >= sec2Reps) {
+                    gates[track].section2Counter = 0;
+                    gates[track].inSection2 = false;
+                    gates[track].currentStep = section1End - 1;
+                } else {
+                    gates[track].currentStep = trackLength - 1;
+                }
+            } else if (!gates[track].inSection2 && gates[track].currentStep < 0) {
+                gates[track].section1Counter++;
+                if (gates[track].section1Counter >= sec1Reps) {
+                    gates[track].section1Counter = 0;
+                    gates[track].inSection2 = true;
+                    gates[track].currentStep = trackLength - 1;
+                } else {
+                    gates[track].currentStep = section1End - 1;
+                }
+            }
+        } else if (direction == 2) {  // Pingpong
+            if (gates[track].pingpongForward) {
+                gates[track].currentStep++;
+                if (gates[track].currentStep >= trackLength) {
+                    gates[track].currentStep = trackLength - 2;
+                    if (gates[track].currentStep < 0) gates[track].currentStep = 0;
+                    gates[track].pingpongForward = false;
+                }
+            } else {
+                gates[track].currentStep--;
+                if (gates[track].currentStep < 0) {
+                    gates[track].currentStep = 1;
+                    if (gates[track].currentStep >= trackLength) gates[track].currentStep = trackLength - 1;
+                    gates[track].pingpongForward = true;
+                }
+            }
+        }
+    }
+    
+    // Event scheduling - defined after the parameter enum
+    void schedule(uint32_t time, uint8_t type, uint8_t target, uint8_t data1 = 0, uint8_t data2 = 0);
+    void dispatchEvent(const SeqEvent& e);
+    void handleClock(uint32_t time, int source);
+    void handleReset();
+    void stepCvSequencer(int seq, uint32_t time, uint8_t subdivision);
+    void stepGateTrack(int track, uint32_t time, uint8_t subdivision);
+    void planOutputs();
+    void applyModulation(const float* busFrames, int numFrames);
+    void modulate(int logical, int offset);
+    float outputLevel(int writer);
+    void renderOutputs(float* busFrames, int numFrames, int fromFrame, int toFrame);
+    
+    // MIDI note engine
+    int stepLength(int seq);
+    
+    // Groove templates (gate tracks)
+    uint32_t grooveDelayFor(int track, int step);
+    
+    // Scale quantizer (CV outputs, index = voice index)
+    void buildQuantTable(int index, int scale, int root);
+    int quantizedNote(int seq, int out, int16_t value);
+    void startNote(int out, uint8_t note, uint8_t velocity, uint32_t time);
+    void releaseVoice(int out);
+    void releaseAllVoices();
+    
+    // MIDI transport
+    void transportStart();
+    void transportStop();
+    void transportContinue();
+    void seekToPosition(uint32_t position);
+    
+    // Pattern switching
+    void switchQueuedPattern(int slot);
+    void switchQueuedPatterns();
+    bool cvAtLoopStart(int seq);
+    bool gateAtLoopStart(int track);
+    
+    // Pattern transforms: rotate/reverse/invert/transpose/scale/offset applied
+    // as index remapping and arithmetic when a step is read. The view wraps at
+    // the loop length: the played (modulated) length on the audio path, the set
+    // length for the UI and the commit (the two-argument forms).
+    int cvViewStep(int seq, int step, int length);
+    int cvViewStep(int seq, int step) { return cvViewStep(seq, step, param(seqParam(seq, kParamSeq1StepCount))); }
+    int16_t cvValue(int seq, int step, int out, int length);
+    int16_t cvValue(int seq, int step, int out) { return cvValue(seq, step, out, param(seqParam(seq, kParamSeq1StepCount))); }
+    int16_t playedCvValue(int seq, int step, int out);
+    bool turing(int seq);
+    void shiftTuring(int seq);
+    int16_t turingValue(int seq, int out);
+    int gateViewStep(int track, int step, int length);
+    int gateViewStep(int track, int step) { return gateViewStep(track, step, param(kParamGate1Length + (track * 9))); }
+    bool gateOn(int track, int step, int length);
+    bool gateOn(int track, int step) { return gateOn(track, step, param(kParamGate1Length + (track * 9))); }
+    bool generated(int track);
+    bool gateAccent(int track, int step, int length);
+    bool gateAccent(int track, int step) { return gateAccent(track, step, param(kParamGate1Length + (track * 9))); }
+    void regenerate(int track);
+    bool transformActive(int view);
+    bool commitTransform(int view);
+    void finishCommit(int view);
+};
+
+// Helper function to set a pixel in NT_screen
+// Screen is 256x64, stored as 128x64 bytes (2 pixels per byte, 4-bit grayscale)
+inline void setPixel(int x, int y, int brightness) {
+    if (x < 0 || x >= 256 || y < 0 || y >= 64) return;
+    
+    int byteIndex = (y * 128) + (x / 2);
+    int pixelShift = (x & 1) ? 0 : 4;  // Even pixels in high nibble, odd in low
+    
+    // Clear the nibble and set new value
+    NT_screen[byteIndex] = (NT_screen[byteIndex] & (0x0F << (4 - pixelShift))) | ((brightness & 0x0F) << pixelShift);
+}
+
+
+// String arrays for enum parameters
+static const char* const divisionStrings[] = {
+    "/16", "/15", "/14", "/13", "/12", "/11", "/10", "/9", "/8", "/7", "/6", "/5", "/4", "/3", "/2",
+    "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15", "x16", NULL
+};
+
+static const char* const directionStrings[] = {
+    "Forward", "Backward", "Pingpong", NULL
+};
+
+static const char* const clockSourceStrings[] = {
+    "CV", "MIDI", "CV+MIDI", NULL
+};
+
+static const char* const grooveStrings[] = {
+    "Swing", "MPC 54%", "MPC 58%", "MPC 62%", "MPC 66%", "MPC 71%", "Shuffle", "Lazy", "User", NULL
+};
+
+static const char* const scaleStrings[] = {
+    "Off", "Chromatic", "Major", "Minor", "Harm Minor", "Dorian", "Phrygian", "Lydian",
+    "Mixolydian", "Locrian", "Maj Penta", "Min Penta", "Blues", "Whole Tone", NULL
+};
+
+static const char* const rootStrings[] = {
+    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B", NULL
+};
+
+static const char* const patternSwitchStrings[] = {
+    "End", "Bar", NULL
+};
+
+static const char* const offOnStrings[] = {
+    "Off", "On", NULL
+};
+
+static const char* const seqModeStrings[] = {
+    "Steps", "Turing", NULL
+};
+
+static const char* const internalClockStrings[] = {
+    "Off", "Auto", "On", NULL
+};
+
+static const char* const modTargetStrings[] = {
+    "Length", "Direction", "Clock Div", "Swing", "Transpose", NULL
+};
+
+// Where a modulation input goes: every seq and track, or one of them
+static const char* const modDestStrings[] = {
+    "All", "Seq 1", "Seq 2", "Seq 3", "Seq 4", "Seq 5", "Seq 6", "Seq 7", "Seq 8",
+    "Track 1", "Track 2", "Track 3", "Track 4", "Track 5", "Track 6", NULL
+};
+
+// Parameter name strings (must be static to persist)
+static const char* const seqParamSuffixes[] = {
+    "Clock Div", "Direction", "Steps", "Split Point", "Sec1 Reps", "Sec2 Reps", "Gate Len", "Pattern"
+};
+static char seqParamNames[kMaxSeqs][8][20];
+
+// Per-output names: Out, MIDI, Scale, Root and Out mode of each CV output
+static char seqOutNames[kMaxSeqs][kMaxOuts][5][20];
+static char gateOutModeNames[6][16];
+static char clockOutModeName[] = "Clock Out mode";
+
+// Pattern bank names
+static char gatePatternName[] = "Gate Pattern";
+static char patternSwitchName[] = "Pattern Switch";
+static char grooveName[] = "Groove";
+static char grooveStepNames[16][12];
+static char seqTransformNames[kMaxSeqs][5][20];
+static char gateTransformNames[6][3][20];
+static char gateEuclidNames[6][3][20];
+static char seqTuringNames[kMaxSeqs][6][20];
+static char modNames[kNumModInputs][4][16];
+
+// Trigger sequencer MIDI channel
+static char triggerMidiChannelName[] = "Trigger MIDI Ch";
+
+// Gate track parameter names
+static char gate1OutName[] = "Gate 1 Out";
+static char gate1CCName[] = "Gate 1 CC";
+static char gate2OutName[] = "Gate 2 Out";
+static char gate2CCName[] = "Gate 2 CC";
+static char gate3OutName[] = "Gate 3 Out";
+static char gate3CCName[] = "Gate 3 CC";
 static char gate4OutName[] = "Gate 4 Out";
 static char gate4CCName[] = "Gate 4 CC";
 static char gate5OutName[] = "Gate 5 Out";
@@ -596,699 +1390,2106 @@ static char gate5CCName[] = "Gate 5 CC";
 static char gate6OutName[] = "Gate 6 Out";
 static char gate6CCName[] = "Gate 6 CC";
 
-static char gate1RunName[] = "Gate 1 Run";
-static char gate1LenName[] = "Gate 1 Length";
-static char gate1DirName[] = "Gate 1 Direction";
-static char gate1DivName[] = "Gate 1 ClockDiv";
-static char gate1SwingName[] = "Gate 1 Swing";
-static char gate1SplitName[] = "Gate 1 Split";
-static char gate1Sec1Name[] = "Gate 1 Sec1 Reps";
-static char gate1Sec2Name[] = "Gate 1 Sec2 Reps";
-static char gate1FillName[] = "Gate 1 Fill Start";
+static char gate1RunName[] = "Gate 1 Run";
+static char gate1LenName[] = "Gate 1 Length";
+static char gate1DirName[] = "Gate 1 Direction";
+static char gate1DivName[] = "Gate 1 ClockDiv";
+static char gate1SwingName[] = "Gate 1 Swing";
+static char gate1SplitName[] = "Gate 1 Split";
+static char gate1Sec1Name[] = "Gate 1 Sec1 Reps";
+static char gate1Sec2Name[] = "Gate 1 Sec2 Reps";
+static char gate1FillName[] = "Gate 1 Fill Start";
+
+static char gate2RunName[] = "Gate 2 Run";
+static char gate2LenName[] = "Gate 2 Length";
+static char gate2DirName[] = "Gate 2 Direction";
+static char gate2DivName[] = "Gate 2 ClockDiv";
+static char gate2SwingName[] = "Gate 2 Swing";
+static char gate2SplitName[] = "Gate 2 Split";
+static char gate2Sec1Name[] = "Gate 2 Sec1 Reps";
+static char gate2Sec2Name[] = "Gate 2 Sec2 Reps";
+static char gate2FillName[] = "Gate 2 Fill Start";
+
+static char gate3RunName[] = "Gate 3 Run";
+static char gate3LenName[] = "Gate 3 Length";
+static char gate3DirName[] = "Gate 3 Direction";
+static char gate3DivName[] = "Gate 3 ClockDiv";
+static char gate3SwingName[] = "Gate 3 Swing";
+static char gate3SplitName[] = "Gate 3 Split";
+static char gate3Sec1Name[] = "Gate 3 Sec1 Reps";
+static char gate3Sec2Name[] = "Gate 3 Sec2 Reps";
+static char gate3FillName[] = "Gate 3 Fill Start";
+
+static char gate4RunName[] = "Gate 4 Run";
+static char gate4LenName[] = "Gate 4 Length";
+static char gate4DirName[] = "Gate 4 Direction";
+static char gate4DivName[] = "Gate 4 ClockDiv";
+static char gate4SwingName[] = "Gate 4 Swing";
+static char gate4SplitName[] = "Gate 4 Split";
+static char gate4Sec1Name[] = "Gate 4 Sec1 Reps";
+static char gate4Sec2Name[] = "Gate 4 Sec2 Reps";
+static char gate4FillName[] = "Gate 4 Fill Start";
+
+static char gate5RunName[] = "Gate 5 Run";
+static char gate5LenName[] = "Gate 5 Length";
+static char gate5DirName[] = "Gate 5 Direction";
+static char gate5DivName[] = "Gate 5 ClockDiv";
+static char gate5SwingName[] = "Gate 5 Swing";
+static char gate5SplitName[] = "Gate 5 Split";
+static char gate5Sec1Name[] = "Gate 5 Sec1 Reps";
+static char gate5Sec2Name[] = "Gate 5 Sec2 Reps";
+static char gate5FillName[] = "Gate 5 Fill Start";
+
+static char gate6RunName[] = "Gate 6 Run";
+static char gate6LenName[] = "Gate 6 Length";
+static char gate6DirName[] = "Gate 6 Direction";
+static char gate6DivName[] = "Gate 6 ClockDiv";
+static char gate6SwingName[] = "Gate 6 Swing";
+static char gate6SplitName[] = "Gate 6 Split";
+static char gate6Sec1Name[] = "Gate 6 Sec1 Reps";
+static char gate6Sec2Name[] = "Gate 6 Sec2 Reps";
+static char gate6FillName[] = "Gate 6 Fill Start";
+
+// Global parameter array
+// Every parameter any instance can have, by logical index. Each instance copies
+// the ones it has into its own table (see buildParameterTable).
+static _NT_parameter parameters[kMaxLogicalParameters];
+
+// Owner of every parameter: the CV seq (and output) or gate track it belongs to,
+// -1 for none. Filled in by initParameters.
+static int8_t paramSeq[kMaxLogicalParameters];
+static int8_t paramOut[kMaxLogicalParameters];
+static int8_t paramTrack[kMaxLogicalParameters];
+
+static void initParameterOwners() {
+    for (int i = 0; i < kMaxLogicalParameters; i++) {
+        paramSeq[i] = -1;
+        paramOut[i] = -1;
+        paramTrack[i] = -1;
+    }
+    static const uint8_t seqParams[] = {
+        kParamSeq1ClockDiv, kParamSeq1Direction, kParamSeq1StepCount, kParamSeq1SplitPoint,
+        kParamSeq1Section1Reps, kParamSeq1Section2Reps, kParamSeq1GateLength, kParamSeq1Pattern,
+        kParamSeq1Rotate, kParamSeq1Reverse, kParamSeq1Transpose, kParamSeq1ValueScale, kParamSeq1ValueOffset,
+        kParamSeq1TmMode, kParamSeq1TmLength, kParamSeq1TmFlip, kParamSeq1TmFlipCv, kParamSeq1TmRange, kParamSeq1TmHarmony
+    };
+    static const uint8_t outParams[] = {
+        kParamSeq1Out1, kParamSeq1Midi1, kParamSeq1Scale1, kParamSeq1Root1, kParamSeq1Out1Mode
+    };
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int i = 0; i < 19; i++) {
+            paramSeq[seqParam(seq, seqParams[i])] = (int8_t)seq;
+        }
+        for (int out = 0; out < kMaxOuts; out++) {
+            for (int i = 0; i < 5; i++) {
+                int p = seqOutParam(seq, out, outParams[i]);
+                paramSeq[p] = (int8_t)seq;
+                paramOut[p] = (int8_t)out;
+            }
+        }
+    }
+    for (int track = 0; track < kMaxGateTracks; track++) {
+        paramTrack[kParamGate1Out + (track * 2)] = (int8_t)track;
+        paramTrack[kParamGate1CC + (track * 2)] = (int8_t)track;
+        paramTrack[kParamGate1OutMode + track] = (int8_t)track;
+        for (int i = 0; i < 9; i++) {
+            paramTrack[kParamGate1Run + (track * 9) + i] = (int8_t)track;
+        }
+        for (int i = 0; i < 3; i++) {
+            paramTrack[kParamGate1Rotate + (track * 3) + i] = (int8_t)track;
+            paramTrack[kParamGate1EuclidHits + (track * 3) + i] = (int8_t)track;
+        }
+    }
+    // Shared by the gate tracks: there as long as track 1 is
+    paramTrack[kParamTriggerMidiChannel] = 0;
+    paramTrack[kParamGatePattern] = 0;
+    for (int i = kParamGroove; i <= kParamGrooveStep16; i++) {
+        paramTrack[i] = 0;
+    }
+}
+
+static bool hasParameter(const SeqLayout& layout, int logical) {
+    if (paramSeq[logical] >= layout.numSeqs || paramOut[logical] >= layout.numOuts) return false;
+    return paramTrack[logical] < layout.numTracks;
+}
+
+// Add/Replace mode of an output
+static void setOutputModeParameter(int param, const char* name) {
+    parameters[param].name = name;
+    parameters[param].min = 0;
+    parameters[param].max = 1;
+    parameters[param].def = 1;  // Replace
+    parameters[param].unit = kNT_unitOutputMode;
+    parameters[param].scaling = kNT_scalingNone;
+    parameters[param].enumStrings = NULL;
+}
+
+// Initialize parameter definitions
+static void initParameters(VSeq* alg) {
+    initParameterOwners();
+    
+    // Clock and Reset inputs
+    parameters[kParamClockIn].name = "Clock in";
+    parameters[kParamClockIn].min = 0;
+    parameters[kParamClockIn].max = 28;
+    parameters[kParamClockIn].def = 1;
+    parameters[kParamClockIn].unit = kNT_unitCvInput;
+    parameters[kParamClockIn].scaling = kNT_scalingNone;
+    
+    parameters[kParamResetIn].name = "Reset in";
+    parameters[kParamResetIn].min = 0;
+    parameters[kParamResetIn].max = 28;
+    parameters[kParamResetIn].def = 2;
+    parameters[kParamResetIn].unit = kNT_unitCvInput;
+    parameters[kParamResetIn].scaling = kNT_scalingNone;
+    
+    parameters[kParamClockSource].name = "Clock Source";
+    parameters[kParamClockSource].min = 0;
+    parameters[kParamClockSource].max = 2;  // CV, MIDI, CV+MIDI
+    parameters[kParamClockSource].def = 0;  // CV
+    parameters[kParamClockSource].unit = kNT_unitEnum;
+    parameters[kParamClockSource].scaling = kNT_scalingNone;
+    parameters[kParamClockSource].enumStrings = clockSourceStrings;
+    
+    // Internal clock
+    parameters[kParamInternalClock].name = "Int Clock";
+    parameters[kParamInternalClock].min = 0;
+    parameters[kParamInternalClock].max = 2;  // Off, Auto (when external stops), On
+    parameters[kParamInternalClock].def = 0;
+    parameters[kParamInternalClock].unit = kNT_unitEnum;
+    parameters[kParamInternalClock].scaling = kNT_scalingNone;
+    parameters[kParamInternalClock].enumStrings = internalClockStrings;
+    
+    parameters[kParamBpm].name = "BPM";
+    parameters[kParamBpm].min = 200;   // 20.0 BPM
+    parameters[kParamBpm].max = 3000;  // 300.0 BPM
+    parameters[kParamBpm].def = 1200;  // 120.0 BPM
+    parameters[kParamBpm].unit = kNT_unitBPM;
+    parameters[kParamBpm].scaling = kNT_scaling10;
+    
+    parameters[kParamPpqn].name = "PPQN";
+    parameters[kParamPpqn].min = 1;
+    parameters[kParamPpqn].max = 24;
+    parameters[kParamPpqn].def = 4;    // 16th notes
+    parameters[kParamPpqn].unit = kNT_unitNone;
+    parameters[kParamPpqn].scaling = kNT_scalingNone;
+    
+    parameters[kParamTakeover].name = "Takeover";
+    parameters[kParamTakeover].min = 1;
+    parameters[kParamTakeover].max = 16;  // Missed external clock periods before Auto takes over
+    parameters[kParamTakeover].def = 4;
+    parameters[kParamTakeover].unit = kNT_unitNone;
+    parameters[kParamTakeover].scaling = kNT_scalingNone;
+    
+    parameters[kParamClockOut].name = "Clock Out";
+    parameters[kParamClockOut].min = 0;
+    parameters[kParamClockOut].max = 28;
+    parameters[kParamClockOut].def = 0;   // None
+    parameters[kParamClockOut].unit = kNT_unitCvOutput;
+    parameters[kParamClockOut].scaling = kNT_scalingNone;
+    
+    // CV outputs and their MIDI channels (per output of every seq)
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int out = 0; out < kMaxOuts; out++) {
+            snprintf(seqOutNames[seq][out][0], sizeof(seqOutNames[seq][out][0]), "Seq %d Out %d", seq + 1, out + 1);
+            snprintf(seqOutNames[seq][out][1], sizeof(seqOutNames[seq][out][1]), "Seq %d MIDI %d", seq + 1, out + 1);
+            
+            int outParam = seqOutParam(seq, out, kParamSeq1Out1);
+            parameters[outParam].name = seqOutNames[seq][out][0];
+            parameters[outParam].min = 0;
+            parameters[outParam].max = 28;
+            parameters[outParam].def = 0;
+            parameters[outParam].unit = kNT_unitCvOutput;
+            parameters[outParam].scaling = kNT_scalingNone;
+            
+            int midiParam = seqOutParam(seq, out, kParamSeq1Midi1);
+            parameters[midiParam].name = seqOutNames[seq][out][1];
+            parameters[midiParam].min = 0;  // 0 = Off
+            parameters[midiParam].max = 16; // 1-16 = MIDI channels
+            parameters[midiParam].def = 0;  // Off by default
+            parameters[midiParam].unit = kNT_unitNone;
+            parameters[midiParam].scaling = kNT_scalingNone;
+        }
+    }
+    
+    // Trigger sequencer MIDI channel
+    parameters[kParamTriggerMidiChannel].name = triggerMidiChannelName;
+    parameters[kParamTriggerMidiChannel].min = 0;  // 0 = Off
+    parameters[kParamTriggerMidiChannel].max = 16; // 1-16 = MIDI channels
+    parameters[kParamTriggerMidiChannel].def = 0;  // Off by default
+    parameters[kParamTriggerMidiChannel].unit = kNT_unitNone;
+    parameters[kParamTriggerMidiChannel].scaling = kNT_scalingNone;
+    
+    // Sequencer configuration parameters
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int i = 0; i < 8; i++) {
+            snprintf(seqParamNames[seq][i], sizeof(seqParamNames[seq][i]), "Seq %d %s", seq + 1, seqParamSuffixes[i]);
+        }
+    }
+    
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        int divParam = seqParam(seq, kParamSeq1ClockDiv);
+        int dirParam = seqParam(seq, kParamSeq1Direction);
+        int stepParam = seqParam(seq, kParamSeq1StepCount);
+        int splitParam = seqParam(seq, kParamSeq1SplitPoint);
+        int sec1Param = seqParam(seq, kParamSeq1Section1Reps);
+        int sec2Param = seqParam(seq, kParamSeq1Section2Reps);
+        
+        // Clock Division parameter
+        parameters[divParam].name = seqParamNames[seq][0];
+        parameters[divParam].min = 0;
+        parameters[divParam].max = 30;  // /16 to /2, x1 to x16 (31 options)
+        parameters[divParam].def = 14;  // Default to /2
+        parameters[divParam].unit = kNT_unitEnum;
+        parameters[divParam].scaling = kNT_scalingNone;
+        parameters[divParam].enumStrings = divisionStrings;
+        
+        // Direction parameter
+        parameters[dirParam].name = seqParamNames[seq][1];
+        parameters[dirParam].min = 0;
+        parameters[dirParam].max = 2;  // Forward, Backward, Pingpong
+        parameters[dirParam].def = 0;  // Forward
+        parameters[dirParam].unit = kNT_unitEnum;
+        parameters[dirParam].scaling = kNT_scalingNone;
+        parameters[dirParam].enumStrings = directionStrings;
+        
+        // Step Count parameter
+        parameters[stepParam].name = seqParamNames[seq][2];
+        parameters[stepParam].min = 1;
+        parameters[stepParam].max = kMinSteps;  // Raised to Max Steps per instance
+        parameters[stepParam].def = 16;  // Default to 16 steps
+        parameters[stepParam].unit = kNT_unitNone;
+        parameters[stepParam].scaling = kNT_scalingNone;
+        
+        // Split Point parameter
+        parameters[splitParam].name = seqParamNames[seq][3];
+        parameters[splitParam].min = 1;
+        parameters[splitParam].max = kMinSteps - 1;
+        parameters[splitParam].def = 8;  // Default to middle of 16 steps
+        parameters[splitParam].unit = kNT_unitNone;
+        parameters[splitParam].scaling = kNT_scalingNone;
+        
+        // Section 1 Repeats parameter
+        parameters[sec1Param].name = seqParamNames[seq][4];
+        parameters[sec1Param].min = 1;
+        parameters[sec1Param].max = 99;
+        parameters[sec1Param].def = 1;
+        parameters[sec1Param].unit = kNT_unitNone;
+        parameters[sec1Param].scaling = kNT_scalingNone;
+        
+        // Section 2 Repeats parameter
+        parameters[sec2Param].name = seqParamNames[seq][5];
+        parameters[sec2Param].min = 1;
+        parameters[sec2Param].max = 99;
+        parameters[sec2Param].def = 1;
+        parameters[sec2Param].unit = kNT_unitNone;
+        parameters[sec2Param].scaling = kNT_scalingNone;
+    }
+    
+    // Gate outputs and MIDI CC parameters (6 tracks, 2 parameters each)
+    const char* gateOutNames[] = {gate1OutName, gate2OutName, gate3OutName, gate4OutName, gate5OutName, gate6OutName};
+    const char* gateCCNames[] = {gate1CCName, gate2CCName, gate3CCName, gate4CCName, gate5CCName, gate6CCName};
+    
+    for (int track = 0; track < 6; track++) {
+        int outParam = kParamGate1Out + (track * 2);
+        int ccParam = kParamGate1CC + (track * 2);
+        
+        parameters[outParam].name = gateOutNames[track];
+        parameters[outParam].min = 0;
+        parameters[outParam].max = 28;
+        parameters[outParam].def = 0;
+        parameters[outParam].unit = kNT_unitCvOutput;
+        parameters[outParam].scaling = kNT_scalingNone;
+        
+        parameters[ccParam].name = gateCCNames[track];
+        parameters[ccParam].min = 0;  // 0-127
+        parameters[ccParam].max = 127;
+        parameters[ccParam].def = 0;  // Default to CC 0 for all
+        parameters[ccParam].unit = kNT_unitNone;
+        parameters[ccParam].scaling = kNT_scalingNone;
+    }
+    
+    // Gate Track parameters (6 tracks, 10 parameters each - minus the Out param which is now separate)
+    const char* gateRunNames[] = {gate1RunName, gate2RunName, gate3RunName, gate4RunName, gate5RunName, gate6RunName};
+    const char* gateLenNames[] = {gate1LenName, gate2LenName, gate3LenName, gate4LenName, gate5LenName, gate6LenName};
+    const char* gateDirNames[] = {gate1DirName, gate2DirName, gate3DirName, gate4DirName, gate5DirName, gate6DirName};
+    const char* gateDivNames[] = {gate1DivName, gate2DivName, gate3DivName, gate4DivName, gate5DivName, gate6DivName};
+    const char* gateSwingNames[] = {gate1SwingName, gate2SwingName, gate3SwingName, gate4SwingName, gate5SwingName, gate6SwingName};
+    const char* gateSplitNames[] = {gate1SplitName, gate2SplitName, gate3SplitName, gate4SplitName, gate5SplitName, gate6SplitName};
+    const char* gateSec1Names[] = {gate1Sec1Name, gate2Sec1Name, gate3Sec1Name, gate4Sec1Name, gate5Sec1Name, gate6Sec1Name};
+    const char* gateSec2Names[] = {gate1Sec2Name, gate2Sec2Name, gate3Sec2Name, gate4Sec2Name, gate5Sec2Name, gate6Sec2Name};
+    const char* gateFillNames[] = {gate1FillName, gate2FillName, gate3FillName, gate4FillName, gate5FillName, gate6FillName};
+    
+    for (int track = 0; track < 6; track++) {
+        int runParam = kParamGate1Run + (track * 9);   // Now 9 params per track instead of 10
+        int lenParam = kParamGate1Length + (track * 9);
+        int dirParam = kParamGate1Direction + (track * 9);
+        int divParam = kParamGate1ClockDiv + (track * 9);
+        int swingParam = kParamGate1Swing + (track * 9);
+        int splitParam = kParamGate1SplitPoint + (track * 9);
+        int sec1Param = kParamGate1Section1Reps + (track * 9);
+        int sec2Param = kParamGate1Section2Reps + (track * 9);
+        int fillParam = kParamGate1FillStart + (track * 9);
+        
+        parameters[runParam].name = gateRunNames[track];
+        parameters[runParam].min = 0;
+        parameters[runParam].max = 1;
+        parameters[runParam].def = 0;  // Default to stopped
+        parameters[runParam].unit = kNT_unitNone;
+        parameters[runParam].scaling = kNT_scalingNone;
+        
+        parameters[lenParam].name = gateLenNames[track];
+        parameters[lenParam].min = 1;
+        parameters[lenParam].max = kMinSteps;
+        parameters[lenParam].def = 16;  // Default to 16 steps
+        parameters[lenParam].unit = kNT_unitNone;
+        parameters[lenParam].scaling = kNT_scalingNone;
+        
+        parameters[dirParam].name = gateDirNames[track];
+        parameters[dirParam].min = 0;
+        parameters[dirParam].max = 2;
+        parameters[dirParam].def = 0;
+        parameters[dirParam].unit = kNT_unitEnum;
+        parameters[dirParam].scaling = kNT_scalingNone;
+        parameters[dirParam].enumStrings = directionStrings;
+        
+        parameters[divParam].name = gateDivNames[track];
+        parameters[divParam].min = 0;
+        parameters[divParam].max = 30;
+        parameters[divParam].def = 14;  // Default to /2
+        parameters[divParam].unit = kNT_unitEnum;
+        parameters[divParam].scaling = kNT_scalingNone;
+        parameters[divParam].enumStrings = divisionStrings;
+        
+        parameters[swingParam].name = gateSwingNames[track];
+        parameters[swingParam].min = 0;
+        parameters[swingParam].max = 100;
+        parameters[swingParam].def = 0;
+        parameters[swingParam].unit = kNT_unitNone;
+        parameters[swingParam].scaling = kNT_scalingNone;
+        
+        parameters[splitParam].name = gateSplitNames[track];
+        parameters[splitParam].min = 0;
+        parameters[splitParam].max = kMinSteps - 1;
+        parameters[splitParam].def = 0;
+        parameters[splitParam].unit = kNT_unitNone;
+        parameters[splitParam].scaling = kNT_scalingNone;
+        
+        parameters[sec1Param].name = gateSec1Names[track];
+        parameters[sec1Param].min = 1;
+        parameters[sec1Param].max = 99;
+        parameters[sec1Param].def = 1;
+        parameters[sec1Param].unit = kNT_unitNone;
+        parameters[sec1Param].scaling = kNT_scalingNone;
+        
+        parameters[sec2Param].name = gateSec2Names[track];
+        parameters[sec2Param].min = 1;
+        parameters[sec2Param].max = 99;
+        parameters[sec2Param].def = 1;
+        parameters[sec2Param].unit = kNT_unitNone;
+        parameters[sec2Param].scaling = kNT_scalingNone;
+        
+        parameters[fillParam].name = gateFillNames[track];
+        parameters[fillParam].min = 1;
+        parameters[fillParam].max = kMinSteps;
+        parameters[fillParam].def = 1;  // Default to lowest value
+        parameters[fillParam].unit = kNT_unitNone;
+        parameters[fillParam].scaling = kNT_scalingNone;
+    }
+    
+    // MIDI note gate length (per sequencer)
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        int paramIdx = seqParam(seq, kParamSeq1GateLength);
+        parameters[paramIdx].name = seqParamNames[seq][6];
+        parameters[paramIdx].min = 1;
+        parameters[paramIdx].max = 100;  // 100 = tie into the next note (legato)
+        parameters[paramIdx].def = 50;
+        parameters[paramIdx].unit = kNT_unitPercent;
+        parameters[paramIdx].scaling = kNT_scalingNone;
+    }
+    
+    // Pattern banks (every CV seq, then the gate sequencer)
+    for (int slot = 0; slot <= kGateSlot; slot++) {
+        int paramIdx = patternParam(slot);
+        parameters[paramIdx].name = (slot == kGateSlot) ? gatePatternName : seqParamNames[slot][7];
+        parameters[paramIdx].min = 1;
+        parameters[paramIdx].max = kNumPatterns;
+        parameters[paramIdx].def = 1;
+        parameters[paramIdx].unit = kNT_unitNone;
+        parameters[paramIdx].scaling = kNT_scalingNone;
+    }
+    
+    parameters[kParamPatternSwitch].name = patternSwitchName;
+    parameters[kParamPatternSwitch].min = 0;
+    parameters[kParamPatternSwitch].max = 1;  // End of pattern, or bar boundary
+    parameters[kParamPatternSwitch].def = 0;
+    parameters[kParamPatternSwitch].unit = kNT_unitEnum;
+    parameters[kParamPatternSwitch].scaling = kNT_scalingNone;
+    parameters[kParamPatternSwitch].enumStrings = patternSwitchStrings;
+    
+    // Groove template (Swing = each track's own Swing parameter, as before)
+    parameters[kParamGroove].name = grooveName;
+    parameters[kParamGroove].min = 0;
+    parameters[kParamGroove].max = 8;
+    parameters[kParamGroove].def = 0;  // Swing
+    parameters[kParamGroove].unit = kNT_unitEnum;
+    parameters[kParamGroove].scaling = kNT_scalingNone;
+    parameters[kParamGroove].enumStrings = grooveStrings;
+    
+    // User groove: delay of each step as a percentage of the step length
+    for (int i = 0; i < 16; i++) {
+        snprintf(grooveStepNames[i], sizeof(grooveStepNames[i]), "Groove %d", i + 1);
+        parameters[kParamGrooveStep1 + i].name = grooveStepNames[i];
+        parameters[kParamGrooveStep1 + i].min = 0;
+        parameters[kParamGrooveStep1 + i].max = 50;  // Up to half a step late
+        parameters[kParamGrooveStep1 + i].def = 0;
+        parameters[kParamGrooveStep1 + i].unit = kNT_unitPercent;
+        parameters[kParamGrooveStep1 + i].scaling = kNT_scalingNone;
+    }
+    
+    // Scale quantizer for each CV output
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int out = 0; out < kMaxOuts; out++) {
+            snprintf(seqOutNames[seq][out][2], sizeof(seqOutNames[seq][out][2]), "Seq %d Scale %d", seq + 1, out + 1);
+            int scaleParam = seqOutParam(seq, out, kParamSeq1Scale1);
+            parameters[scaleParam].name = seqOutNames[seq][out][2];
+            parameters[scaleParam].min = 0;
+            parameters[scaleParam].max = 13;
+            parameters[scaleParam].def = 0;  // Off = unquantized 0-10V, as before
+            parameters[scaleParam].unit = kNT_unitEnum;
+            parameters[scaleParam].scaling = kNT_scalingNone;
+            parameters[scaleParam].enumStrings = scaleStrings;
+            
+            snprintf(seqOutNames[seq][out][3], sizeof(seqOutNames[seq][out][3]), "Seq %d Root %d", seq + 1, out + 1);
+            int rootParam = seqOutParam(seq, out, kParamSeq1Root1);
+            parameters[rootParam].name = seqOutNames[seq][out][3];
+            parameters[rootParam].min = 0;
+            parameters[rootParam].max = 11;
+            parameters[rootParam].def = 0;  // C
+            parameters[rootParam].unit = kNT_unitEnum;
+            parameters[rootParam].scaling = kNT_scalingNone;
+            parameters[rootParam].enumStrings = rootStrings;
+        }
+    }
+    
+    // Pattern transforms per CV sequencer. All neutral by default, so an
+    // untouched sequencer plays its stored pattern exactly as before.
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        int base = seqParam(seq, kParamSeq1Rotate);
+        snprintf(seqTransformNames[seq][0], sizeof(seqTransformNames[seq][0]), "Seq %d Rotate", seq + 1);
+        snprintf(seqTransformNames[seq][1], sizeof(seqTransformNames[seq][1]), "Seq %d Reverse", seq + 1);
+        snprintf(seqTransformNames[seq][2], sizeof(seqTransformNames[seq][2]), "Seq %d Transpose", seq + 1);
+        snprintf(seqTransformNames[seq][3], sizeof(seqTransformNames[seq][3]), "Seq %d Scale", seq + 1);
+        snprintf(seqTransformNames[seq][4], sizeof(seqTransformNames[seq][4]), "Seq %d Offset", seq + 1);
+        
+        parameters[base].name = seqTransformNames[seq][0];
+        parameters[base].min = -(kMinSteps - 1);
+        parameters[base].max = kMinSteps - 1;  // Steps the pattern is moved later (negative = earlier)
+        parameters[base].def = 0;
+        parameters[base].unit = kNT_unitNone;
+        parameters[base].scaling = kNT_scalingNone;
+        
+        parameters[base + 1].name = seqTransformNames[seq][1];
+        parameters[base + 1].min = 0;
+        parameters[base + 1].max = 1;
+        parameters[base + 1].def = 0;
+        parameters[base + 1].unit = kNT_unitEnum;
+        parameters[base + 1].scaling = kNT_scalingNone;
+        parameters[base + 1].enumStrings = offOnStrings;
+        
+        parameters[base + 2].name = seqTransformNames[seq][2];
+        parameters[base + 2].min = -24;
+        parameters[base + 2].max = 24;
+        parameters[base + 2].def = 0;
+        parameters[base + 2].unit = kNT_unitSemitones;
+        parameters[base + 2].scaling = kNT_scalingNone;
+        
+        parameters[base + 3].name = seqTransformNames[seq][3];
+        parameters[base + 3].min = 0;
+        parameters[base + 3].max = 200;  // Step values scaled around 0V
+        parameters[base + 3].def = 100;
+        parameters[base + 3].unit = kNT_unitPercent;
+        parameters[base + 3].scaling = kNT_scalingNone;
+        
+        parameters[base + 4].name = seqTransformNames[seq][4];
+        parameters[base + 4].min = -100;
+        parameters[base + 4].max = 100;  // -10V to +10V in 0.1V steps
+        parameters[base + 4].def = 0;
+        parameters[base + 4].unit = kNT_unitVolts;
+        parameters[base + 4].scaling = kNT_scaling10;
+    }
+    
+    // Pattern transforms per gate track
+    for (int track = 0; track < 6; track++) {
+        int base = kParamGate1Rotate + (track * 3);
+        snprintf(gateTransformNames[track][0], sizeof(gateTransformNames[track][0]), "Gate %d Rotate", track + 1);
+        snprintf(gateTransformNames[track][1], sizeof(gateTransformNames[track][1]), "Gate %d Reverse", track + 1);
+        snprintf(gateTransformNames[track][2], sizeof(gateTransformNames[track][2]), "Gate %d Invert", track + 1);
+        
+        parameters[base].name = gateTransformNames[track][0];
+        parameters[base].min = -(kMinSteps - 1);
+        parameters[base].max = kMinSteps - 1;
+        parameters[base].def = 0;
+        parameters[base].unit = kNT_unitNone;
+        parameters[base].scaling = kNT_scalingNone;
+        
+        for (int i = 1; i < 3; i++) {
+            parameters[base + i].name = gateTransformNames[track][i];
+            parameters[base + i].min = 0;
+            parameters[base + i].max = 1;
+            parameters[base + i].def = 0;
+            parameters[base + i].unit = kNT_unitEnum;
+            parameters[base + i].scaling = kNT_scalingNone;
+            parameters[base + i].enumStrings = offOnStrings;
+        }
+    }
+    
+    // Euclidean generator per gate track: Hits 0 plays the stored steps
+    for (int track = 0; track < 6; track++) {
+        int base = kParamGate1EuclidHits + (track * 3);
+        snprintf(gateEuclidNames[track][0], sizeof(gateEuclidNames[track][0]), "Gate %d Euc Hits", track + 1);
+        snprintf(gateEuclidNames[track][1], sizeof(gateEuclidNames[track][1]), "Gate %d Euc Rotate", track + 1);
+        snprintf(gateEuclidNames[track][2], sizeof(gateEuclidNames[track][2]), "Gate %d Euc Accent", track + 1);
+        
+        parameters[base].name = gateEuclidNames[track][0];
+        parameters[base].min = 0;
+        parameters[base].max = kMinSteps;  // Spread over the track Length
+        parameters[base].def = 0;   // Off
+        parameters[base].unit = kNT_unitNone;
+        parameters[base].scaling = kNT_scalingNone;
+        
+        parameters[base + 1].name = gateEuclidNames[track][1];
+        parameters[base + 1].min = 0;
+        parameters[base + 1].max = kMinSteps - 1;
+        parameters[base + 1].def = 0;
+        parameters[base + 1].unit = kNT_unitNone;
+        parameters[base + 1].scaling = kNT_scalingNone;
+        
+        parameters[base + 2].name = gateEuclidNames[track][2];
+        parameters[base + 2].min = 0;
+        parameters[base + 2].max = kMinSteps;  // Spread over the hits
+        parameters[base + 2].def = 0;   // No accents
+        parameters[base + 2].unit = kNT_unitNone;
+        parameters[base + 2].scaling = kNT_scalingNone;
+    }
+    
+    // Turing mode per CV sequencer
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        int base = seqParam(seq, kParamSeq1TmMode);
+        snprintf(seqTuringNames[seq][0], sizeof(seqTuringNames[seq][0]), "Seq %d Mode", seq + 1);
+        snprintf(seqTuringNames[seq][1], sizeof(seqTuringNames[seq][1]), "Seq %d TM Length", seq + 1);
+        snprintf(seqTuringNames[seq][2], sizeof(seqTuringNames[seq][2]), "Seq %d TM Flip", seq + 1);
+        snprintf(seqTuringNames[seq][3], sizeof(seqTuringNames[seq][3]), "Seq %d TM Flip CV", seq + 1);
+        snprintf(seqTuringNames[seq][4], sizeof(seqTuringNames[seq][4]), "Seq %d TM Range", seq + 1);
+        snprintf(seqTuringNames[seq][5], sizeof(seqTuringNames[seq][5]), "Seq %d TM Harmony", seq + 1);
+        
+        parameters[base].name = seqTuringNames[seq][0];
+        parameters[base].min = 0;
+        parameters[base].max = 1;
+        parameters[base].def = 0;   // Steps
+        parameters[base].unit = kNT_unitEnum;
+        parameters[base].scaling = kNT_scalingNone;
+        parameters[base].enumStrings = seqModeStrings;
+        
+        parameters[base + 1].name = seqTuringNames[seq][1];
+        parameters[base + 1].min = 2;
+        parameters[base + 1].max = 32;  // Bits in the loop
+        parameters[base + 1].def = 16;
+        parameters[base + 1].unit = kNT_unitNone;
+        parameters[base + 1].scaling = kNT_scalingNone;
+        
+        parameters[base + 2].name = seqTuringNames[seq][2];
+        parameters[base + 2].min = 0;
+        parameters[base + 2].max = 100;  // 0 = locked loop, 50 = random, 100 = locked at double length
+        parameters[base + 2].def = 10;
+        parameters[base + 2].unit = kNT_unitPercent;
+        parameters[base + 2].scaling = kNT_scalingNone;
+        
+        parameters[base + 3].name = seqTuringNames[seq][3];
+        parameters[base + 3].min = 0;
+        parameters[base + 3].max = 28;
+        parameters[base + 3].def = 0;   // None; +10% per volt
+        parameters[base + 3].unit = kNT_unitCvInput;
+        parameters[base + 3].scaling = kNT_scalingNone;
+        
+        parameters[base + 4].name = seqTuringNames[seq][4];
+        parameters[base + 4].min = 1;
+        parameters[base + 4].max = 100;  // 0.1V - 10V
+        parameters[base + 4].def = 20;   // 2 octaves
+        parameters[base + 4].unit = kNT_unitVolts;
+        parameters[base + 4].scaling = kNT_scaling10;
+        
+        parameters[base + 5].name = seqTuringNames[seq][5];
+        parameters[base + 5].min = -24;
+        parameters[base + 5].max = 24;
+        parameters[base + 5].def = 7;   // A fifth above output 1
+        parameters[base + 5].unit = kNT_unitSemitones;
+        parameters[base + 5].scaling = kNT_scalingNone;
+    }
+    
+    // Output modes, named "<output> mode" as the NT does. Replace by default: a
+    // single output on a bus sets it as before. Outputs sharing a bus are summed
+    // (see OutputPlan).
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int out = 0; out < kMaxOuts; out++) {
+            snprintf(seqOutNames[seq][out][4], sizeof(seqOutNames[seq][out][4]), "Seq %d Out %d mode", seq + 1, out + 1);
+            setOutputModeParameter(seqOutParam(seq, out, kParamSeq1Out1Mode), seqOutNames[seq][out][4]);
+        }
+    }
+    for (int track = 0; track < 6; track++) {
+        snprintf(gateOutModeNames[track], sizeof(gateOutModeNames[track]), "Gate %d Out mode", track + 1);
+        setOutputModeParameter(kParamGate1OutMode + track, gateOutModeNames[track]);
+    }
+    setOutputModeParameter(kParamClockOutMode, clockOutModeName);
+    
+    // Modulation inputs. Depth 100% sweeps the target's whole range over 10V
+    // (Transpose: 1V/octave); an input set to none costs nothing.
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int base = kParamMod1In + (mod * 4);
+        snprintf(modNames[mod][0], sizeof(modNames[mod][0]), "Mod %d In", mod + 1);
+        snprintf(modNames[mod][1], sizeof(modNames[mod][1]), "Mod %d Target", mod + 1);
+        snprintf(modNames[mod][2], sizeof(modNames[mod][2]), "Mod %d Dest", mod + 1);
+        snprintf(modNames[mod][3], sizeof(modNames[mod][3]), "Mod %d Depth", mod + 1);
+        
+        parameters[base].name = modNames[mod][0];
+        parameters[base].min = 0;
+        parameters[base].max = 28;
+        parameters[base].def = 0;   // None
+        parameters[base].unit = kNT_unitCvInput;
+        parameters[base].scaling = kNT_scalingNone;
+        
+        parameters[base + 1].name = modNames[mod][1];
+        parameters[base + 1].min = 0;
+        parameters[base + 1].max = kNumModTargets - 1;
+        parameters[base + 1].def = kModLength;
+        parameters[base + 1].unit = kNT_unitEnum;
+        parameters[base + 1].scaling = kNT_scalingNone;
+        parameters[base + 1].enumStrings = modTargetStrings;
+        
+        parameters[base + 2].name = modNames[mod][2];
+        parameters[base + 2].min = 0;
+        parameters[base + 2].max = kMaxSeqs + kMaxGateTracks;
+        parameters[base + 2].def = 0;   // All
+        parameters[base + 2].unit = kNT_unitEnum;
+        parameters[base + 2].scaling = kNT_scalingNone;
+        parameters[base + 2].enumStrings = modDestStrings;
+        
+        parameters[base + 3].name = modNames[mod][3];
+        parameters[base + 3].min = -100;
+        parameters[base + 3].max = 100;
+        parameters[base + 3].def = 100;
+        parameters[base + 3].unit = kNT_unitPercent;
+        parameters[base + 3].scaling = kNT_scalingNone;
+    }
+    
+    // Each instance gets its own table: only the parameters of its seqs, outputs
+    // and tracks (in logical order, so the default layout is the original table),
+    // with the step ranges of its Max Steps. Placed after the object, see
+    // calculateRequirements.
+    _NT_parameter* table = (_NT_parameter*)(alg + 1);
+    int n = 0;
+    for (int logical = 0; logical < kMaxLogicalParameters; logical++) {
+        if (!hasParameter(alg->layout, logical)) {
+            alg->paramIndex[logical] = kNoParam;
+            continue;
+        }
+        table[n] = parameters[logical];
+        alg->paramIndex[logical] = (uint8_t)n;
+        alg->logicalParam[n] = (uint16_t)logical;
+        n++;
+    }
+    alg->numParameters = n;
+    
+    int last = alg->maxSteps - 1;
+    for (int seq = 0; seq < alg->numSeqs; seq++) {
+        table[alg->paramIndex[seqParam(seq, kParamSeq1StepCount)]].max = alg->maxSteps;
+        table[alg->paramIndex[seqParam(seq, kParamSeq1SplitPoint)]].max = last;
+        table[alg->paramIndex[seqParam(seq, kParamSeq1Rotate)]].min = -last;
+        table[alg->paramIndex[seqParam(seq, kParamSeq1Rotate)]].max = last;
+    }
+    for (int track = 0; track < alg->numTracks; track++) {
+        table[alg->paramIndex[kParamGate1Length + (track * 9)]].max = alg->maxSteps;
+        table[alg->paramIndex[kParamGate1SplitPoint + (track * 9)]].max = last;
+        table[alg->paramIndex[kParamGate1FillStart + (track * 9)]].max = alg->maxSteps;
+        table[alg->paramIndex[kParamGate1Rotate + (track * 3)]].min = -last;
+        table[alg->paramIndex[kParamGate1Rotate + (track * 3)]].max = last;
+        table[alg->paramIndex[kParamGate1EuclidHits + (track * 3)]].max = alg->maxSteps;
+        table[alg->paramIndex[kParamGate1EuclidRotate + (track * 3)]].max = last;
+        table[alg->paramIndex[kParamGate1EuclidAccent + (track * 3)]].max = alg->maxSteps;
+    }
+    
+    // Mod Dest lists only this instance's seqs and tracks
+    int d = 0;
+    alg->modDestNames[d++] = modDestStrings[0];
+    for (int seq = 0; seq < alg->numSeqs; seq++) alg->modDestNames[d++] = modDestStrings[1 + seq];
+    for (int track = 0; track < alg->numTracks; track++) alg->modDestNames[d++] = modDestStrings[1 + kMaxSeqs + track];
+    alg->modDestNames[d] = NULL;
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        _NT_parameter& dest = table[alg->paramIndex[kParamMod1Dest + (mod * 4)]];
+        dest.max = alg->numSeqs + alg->numTracks;
+        dest.enumStrings = alg->modDestNames;
+    }
+    alg->parameters = table;
+}
+
+int16_t VSeq::parameterDefault(int logical) {
+    return ::parameters[logical].def;
+}
 
-static char gate2RunName[] = "Gate 2 Run";
-static char gate2LenName[] = "Gate 2 Length";
-static char gate2DirName[] = "Gate 2 Direction";
-static char gate2DivName[] = "Gate 2 ClockDiv";
-static char gate2SwingName[] = "Gate 2 Swing";
-static char gate2SplitName[] = "Gate 2 Split";
-static char gate2Sec1Name[] = "Gate 2 Sec1 Reps";
-static char gate2Sec2Name[] = "Gate 2 Sec2 Reps";
-static char gate2FillName[] = "Gate 2 Fill Start";
+// Parameter pages, generated for the configured seqs and tracks. Pages list
+// parameters by logical index; the ones this instance does not have are left
+// out, and a page left empty is dropped.
+static char seqPageNames[kMaxSeqs][2][16];
+static char trackPageNames[kMaxGateTracks][16];
 
-static char gate3RunName[] = "Gate 3 Run";
-static char gate3LenName[] = "Gate 3 Length";
-static char gate3DirName[] = "Gate 3 Direction";
-static char gate3DivName[] = "Gate 3 ClockDiv";
-static char gate3SwingName[] = "Gate 3 Swing";
-static char gate3SplitName[] = "Gate 3 Split";
-static char gate3Sec1Name[] = "Gate 3 Sec1 Reps";
-static char gate3Sec2Name[] = "Gate 3 Sec2 Reps";
-static char gate3FillName[] = "Gate 3 Fill Start";
+struct PageBuilder {
+    VSeq* alg;
+    int used;                   // Entries of alg->pageParams taken so far
+    
+    PageBuilder(VSeq* a) : alg(a), used(0) {
+        alg->pages.numPages = 0;
+        alg->pages.pages = alg->pageArray;
+    }
+    
+    void begin(const char* name) {
+        end();
+        _NT_parameterPage& page = alg->pageArray[alg->pages.numPages++];
+        memset(&page, 0, sizeof(page));
+        page.name = name;
+        page.params = alg->pageParams + used;
+    }
+    
+    void add(int logical) {
+        uint8_t p = alg->paramIndex[logical];
+        if (p == kNoParam) return;
+        alg->pageParams[used++] = p;
+        alg->pageArray[alg->pages.numPages - 1].numParams++;
+    }
+    
+    void end() {
+        if (alg->pages.numPages > 0 && alg->pageArray[alg->pages.numPages - 1].numParams == 0) {
+            alg->pages.numPages--;
+        }
+    }
+};
 
-static char gate4RunName[] = "Gate 4 Run";
-static char gate4LenName[] = "Gate 4 Length";
-static char gate4DirName[] = "Gate 4 Direction";
-static char gate4DivName[] = "Gate 4 ClockDiv";
-static char gate4SwingName[] = "Gate 4 Swing";
-static char gate4SplitName[] = "Gate 4 Split";
-static char gate4Sec1Name[] = "Gate 4 Sec1 Reps";
-static char gate4Sec2Name[] = "Gate 4 Sec2 Reps";
-static char gate4FillName[] = "Gate 4 Fill Start";
+static void initPages(VSeq* alg) {
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        snprintf(seqPageNames[seq][0], sizeof(seqPageNames[seq][0]), "Seq %d Outs", seq + 1);
+        snprintf(seqPageNames[seq][1], sizeof(seqPageNames[seq][1]), "Seq %d Params", seq + 1);
+    }
+    for (int track = 0; track < kMaxGateTracks; track++) {
+        snprintf(trackPageNames[track], sizeof(trackPageNames[track]), "Trig Track %d", track + 1);
+    }
+    
+    PageBuilder b(alg);
+    
+    b.begin("Inputs");
+    b.add(kParamClockIn);
+    b.add(kParamResetIn);
+    b.add(kParamClockSource);
+    
+    b.begin("Internal Clock");
+    b.add(kParamInternalClock);
+    b.add(kParamBpm);
+    b.add(kParamPpqn);
+    b.add(kParamTakeover);
+    b.add(kParamClockOut);
+    b.add(kParamClockOutMode);
+    
+    b.begin("Patterns");
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        b.add(patternParam(seq));
+    }
+    b.add(kParamGatePattern);
+    b.add(kParamPatternSwitch);
+    
+    b.begin("Groove");
+    b.add(kParamGroove);
+    for (int i = 0; i < 16; i++) {
+        b.add(kParamGrooveStep1 + i);
+    }
+    
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        b.begin(seqPageNames[seq][0]);
+        for (int out = 0; out < kMaxOuts; out++) {
+            b.add(seqOutParam(seq, out, kParamSeq1Out1));
+            b.add(seqOutParam(seq, out, kParamSeq1Out1Mode));
+            b.add(seqOutParam(seq, out, kParamSeq1Midi1));
+            b.add(seqOutParam(seq, out, kParamSeq1Scale1));
+            b.add(seqOutParam(seq, out, kParamSeq1Root1));
+        }
+        b.add(seqParam(seq, kParamSeq1GateLength));
+    }
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        b.begin(seqPageNames[seq][1]);
+        for (int i = 0; i < 6; i++) {
+            b.add(seqParam(seq, kParamSeq1ClockDiv + i));
+        }
+    }
+    
+    b.begin("Gate Outs");
+    b.add(kParamTriggerMidiChannel);
+    for (int track = 0; track < kMaxGateTracks; track++) {
+        b.add(kParamGate1Out + (track * 2));
+        b.add(kParamGate1OutMode + track);
+        b.add(kParamGate1CC + (track * 2));
+    }
+    for (int track = 0; track < kMaxGateTracks; track++) {
+        b.begin(trackPageNames[track]);
+        for (int i = 0; i < 9; i++) {
+            b.add(kParamGate1Run + (track * 9) + i);
+        }
+    }
+    
+    b.begin("Seq Transforms");
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int i = 0; i < 5; i++) {
+            b.add(seqParam(seq, kParamSeq1Rotate + i));
+        }
+    }
+    b.begin("Gate Transforms");
+    for (int track = 0; track < kMaxGateTracks; track++) {
+        for (int i = 0; i < 3; i++) {
+            b.add(kParamGate1Rotate + (track * 3) + i);
+        }
+    }
+    b.begin("Euclid");
+    for (int track = 0; track < kMaxGateTracks; track++) {
+        for (int i = 0; i < 3; i++) {
+            b.add(kParamGate1EuclidHits + (track * 3) + i);
+        }
+    }
+    b.begin("Turing");
+    for (int seq = 0; seq < kMaxSeqs; seq++) {
+        for (int i = 0; i < 6; i++) {
+            b.add(seqParam(seq, kParamSeq1TmMode + i));
+        }
+    }
+    b.begin("Modulation");
+    for (int i = kParamMod1In; i <= kParamMod4Depth; i++) {
+        b.add(i);
+    }
+    b.end();
+}
 
-static char gate5RunName[] = "Gate 5 Run";
-static char gate5LenName[] = "Gate 5 Length";
-static char gate5DirName[] = "Gate 5 Direction";
-static char gate5DivName[] = "Gate 5 ClockDiv";
-static char gate5SwingName[] = "Gate 5 Swing";
-static char gate5SplitName[] = "Gate 5 Split";
-static char gate5Sec1Name[] = "Gate 5 Sec1 Reps";
-static char gate5Sec2Name[] = "Gate 5 Sec2 Reps";
-static char gate5FillName[] = "Gate 5 Fill Start";
+// Max Steps specification, clamped to what the storage supports
+static int specSteps(const int32_t* specs) {
+    int n = (specs != NULL) ? specs[0] : kMinSteps;
+    if (n < kMinSteps) n = kMinSteps;
+    if (n > kMaxSteps) n = kMaxSteps;
+    return n;
+}
+
+static int specValue(const int32_t* specs, int index, int min, int max, int def) {
+    int n = (specs != NULL) ? specs[index] : def;
+    if (n < min) n = min;
+    if (n > max) n = max;
+    return n;
+}
+
+// Layout specification (1-kNumLayouts), see kLayouts
+static SeqLayout specLayout(const int32_t* specs) {
+    return kLayouts[specValue(specs, 1, 1, kNumLayouts, kDefaultLayout) - 1];
+}
+
+void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specs) {
+    SeqLayout layout = specLayout(specs);
+    req.numParameters = numParametersFor(layout);
+    // Object, its parameter table, then the seq, output and track states
+    req.sram = sizeof(VSeq) + (numParametersFor(layout) * sizeof(_NT_parameter)) + VSeq::stateBytes(layout);
+    // 16 patterns per sequencer, twice: the playing bank and the preset load bank
+    req.dram = 2 * PatternBank::bytesFor(layout, specSteps(specs));
+}
+
+_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t* specs) {
+    SeqLayout layout = specLayout(specs);
+    uint8_t* states = ptrs.sram + sizeof(VSeq) + (numParametersFor(layout) * sizeof(_NT_parameter));
+    VSeq* alg = new (ptrs.sram) VSeq(layout, states);
+    alg->initPatterns(ptrs.dram, specSteps(specs));
+    initParameters(alg);
+    initPages(alg);
+    alg->parameterPages = &alg->pages;
+    
+    // Initialize debug output bus array from default parameter values
+    // (v is only set once construct returns)
+    for (int i = 0; i < 12; i++) {
+        int seq = i / layout.numOuts;
+        alg->debugOutputBus[i] = (seq < layout.numSeqs) ?
+            VSeq::parameterDefault(seqOutParam(seq, i % layout.numOuts, kParamSeq1Out1)) : 0;
+    }
+    
+    return alg;
+}
+
+// Trigger pulse length for gate tracks
+static const int kTriggerSamples = 240;  // ~5ms at 48kHz
+
+// Groove templates: how late each of 16 steps plays, in hundredths of a step.
+// MPC-style swing N% puts the off-beat 16th at N% of the 8th note, i.e. (2N - 100)
+// hundredths of a step late. Swing (0) and User (8) are not in this table.
+static const uint8_t kGrooveTemplates[7][16] = {
+    { 0,  8, 0,  8, 0,  8, 0,  8, 0,  8, 0,  8, 0,  8, 0,  8 },  // MPC 54%
+    { 0, 16, 0, 16, 0, 16, 0, 16, 0, 16, 0, 16, 0, 16, 0, 16 },  // MPC 58%
+    { 0, 24, 0, 24, 0, 24, 0, 24, 0, 24, 0, 24, 0, 24, 0, 24 },  // MPC 62%
+    { 0, 32, 0, 32, 0, 32, 0, 32, 0, 32, 0, 32, 0, 32, 0, 32 },  // MPC 66% (triplet)
+    { 0, 42, 0, 42, 0, 42, 0, 42, 0, 42, 0, 42, 0, 42, 0, 42 },  // MPC 71%
+    { 0, 33, 0, 20, 0, 33, 0, 25, 0, 33, 0, 20, 0, 33, 0, 30 },  // Shuffle: uneven off-beats
+    { 0,  6, 4, 10, 2,  6, 4, 12, 0,  6, 4, 10, 2,  6, 4, 14 }   // Lazy: everything drags a little
+};
+
+// Quantizer scales as 12-bit masks, bit n = n semitones above the root is in the scale.
+// Index is the Scale parameter - 1 (Off has no mask).
+static const uint16_t kScaleMasks[13] = {
+    0xFFF,  // Chromatic
+    0xAB5,  // Major
+    0x5AD,  // Minor
+    0x9AD,  // Harmonic minor
+    0x6AD,  // Dorian
+    0x5AB,  // Phrygian
+    0xAD5,  // Lydian
+    0x6B5,  // Mixolydian
+    0x56B,  // Locrian
+    0x295,  // Major pentatonic
+    0x4A9,  // Minor pentatonic
+    0x4E9,  // Blues
+    0x555   // Whole tone
+};
+
+// Quantized notes are semitones above 0V (0-120 over the 0-10V range).
+// MIDI note = note + kQuantizeMidiBase, so 0V = C1 (MIDI 24).
+static const int kQuantizeMidiBase = 24;
+
+// Map clockDiv parameter to actual divisor/multiplier
+// 0-14: divisions (/16, /15, /14, /13, /12, /11, /10, /9, /8, /7, /6, /5, /4, /3, /2)
+// 15-30: multiplications (x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16)
+static inline void decodeClockDiv(int clockDiv, int& divisor, int& multiplier) {
+    divisor = 1;
+    multiplier = 1;
+    if (clockDiv < 15) {
+        divisor = 16 - clockDiv;     // 0->16, 1->15, 2->14, ..., 14->2
+    } else {
+        multiplier = clockDiv - 14;  // 15->1, 16->2, 17->3, ..., 30->16
+    }
+}
+
+// Swap in the queued pattern of a sequencer (slot 0-2 = CV seq, 3 = gate sequencer)
+void VSeq::switchQueuedPattern(int slot) {
+    int next = param(patternParam(slot)) - 1;  // Parameter is 1-16
+    if (next != activePattern[slot]) {
+        selectPattern(slot, next);
+    }
+}
+
+// Every slot this instance has: its CV seqs, then the gate sequencer
+void VSeq::switchQueuedPatterns() {
+    for (int seq = 0; seq < numSeqs; seq++) {
+        switchQueuedPattern(seq);
+    }
+    if (numTracks > 0) {
+        switchQueuedPattern(kGateSlot);
+    }
+}
+
+// True when the last advance brought a CV sequencer back to the start of its loop
+bool VSeq::cvAtLoopStart(int seq) {
+    int direction = played(seqParam(seq, kParamSeq1Direction));
+    LoopPlan plan;
+    buildCvLoop(plan, direction, played(seqParam(seq, kParamSeq1StepCount)), param(seqParam(seq, kParamSeq1SplitPoint)),
+                param(seqParam(seq, kParamSeq1Section1Reps)), param(seqParam(seq, kParamSeq1Section2Reps)));
+    
+    // Pingpong ignores sections; the other directions ignore the bounce flag
+    if (direction == 2) {
+        return plan.isCycleStart(seqs[seq].currentStep, 0, 0, false, seqs[seq].pingpongForward);
+    }
+    return plan.isCycleStart(seqs[seq].currentStep, seqs[seq].section1Counter, seqs[seq].section2Counter,
+                             seqs[seq].inSection2, true);
+}
+
+// True when the last advance brought a gate track back to the start of its loop
+bool VSeq::gateAtLoopStart(int track) {
+    int direction = played(kParamGate1Direction + (track * 9));
+    LoopPlan plan;
+    buildTrackLoop(plan, direction, played(kParamGate1Length + (track * 9)), param(kParamGate1SplitPoint + (track * 9)),
+                  param(kParamGate1Section1Reps + (track * 9)), param(kParamGate1Section2Reps + (track * 9)),
+                  param(kParamGate1FillStart + (track * 9)));
+    
+    if (direction == 2) {
+        return plan.isCycleStart(gates[track].currentStep, 0, 0, false, gates[track].pingpongForward);
+    }
+    return plan.isCycleStart(gates[track].currentStep, gates[track].section1Counter, gates[track].section2Counter,
+                             gates[track].inSection2, true);
+}
+
+// Pattern transforms. The stored pattern is never touched while playing: every
+// read goes through a view (index remap for rotate/reverse, arithmetic for the
+// values), so changing or modulating a transform costs nothing up front.
+// View index 0-7 = CV sequencers 1-8, kGateSlot + track = gate tracks 1-6.
+
+// Stored step played at view step `step` of a loop of `length` steps.
+// The view is the stored loop moved `rotate` steps later, then mirrored.
+// Steps past the loop are never played and stay where they are.
+static inline int viewStep(int step, int length, int rotate, bool reverse) {
+    if (step < 0 || step >= length) return step;
+    int p = reverse ? (length - 1 - step) : step;
+    p = (p - rotate) % length;
+    if (p < 0) p += length;
+    return p;
+}
+
+// Value arithmetic of a CV view: scale around 0V, then transpose and offset.
+// Works on the stored 0-10V range (-32768 = 0V, 32767 = 10V) and clamps to it,
+// so a quantized output transposes within its scale. Neutral settings return
+// the stored value unchanged.
+static inline int16_t transformValue(int16_t value, int scale, int transpose, int offset) {
+    int32_t x = (int32_t)value + 32768;        // 0-65535 = 0-10V
+    x = (x * scale) / 100;                     // Scale %
+    x += (transpose * 65535) / 120;            // Semitones, 120 over 10V
+    x += (offset * 65535) / 100;               // Tenths of a volt
+    if (x < 0) x = 0;
+    if (x > 65535) x = 65535;
+    return (int16_t)(x - 32768);
+}
+
+int VSeq::cvViewStep(int seq, int step, int length) {
+    if (transformBypass & (1 << seq)) return step;
+    int base = seqParam(seq, kParamSeq1Rotate);
+    return viewStep(step, length, param(base), param(base + 1) != 0);
+}
+
+int16_t VSeq::cvValue(int seq, int step, int out, int length) {
+    int16_t value = turing(seq) ? turingValue(seq, out) : seqs[seq].stepValues[cvViewStep(seq, step, length)][out];
+    if (transformBypass & (1 << seq)) return value;
+    int base = seqParam(seq, kParamSeq1Rotate);
+    return transformValue(value, param(base + 3), param(base + 2), param(base + 4));
+}
+
+// Step value as played: the view over the played Step Count plus any Transpose
+// modulation. The played Transpose is clamped to the parameter's range, so only
+// the part it moves past the set Transpose is added here.
+int16_t VSeq::playedCvValue(int seq, int step, int out) {
+    int16_t value = cvValue(seq, step, out, played(seqParam(seq, kParamSeq1StepCount)));
+    int transpose = seqParam(seq, kParamSeq1Transpose);
+    int extra = played(transpose) - param(transpose);
+    return (extra != 0) ? transformValue(value, 100, extra, 0) : value;
+}
+
+bool VSeq::turing(int seq) {
+    return param(seqParam(seq, kParamSeq1TmMode)) != 0;
+}
+
+// One clocked step of a Turing seq: the bit leaving the loop (bit Length-1) is
+// fed back in at bit 0, flipped with the Flip probability (plus 10% per volt on
+// the Flip CV input). 0% repeats the loop forever, 100% flips every time (which
+// is locked again, at twice the length).
+void VSeq::shiftTuring(int seq) {
+    int base = seqParam(seq, kParamSeq1TmMode);
+    int length = param(base + 1);
+    int flip = param(base + 2) + (int)(seqs[seq].tmFlipCv * 10.0f);
+    
+    uint32_t reg = seqs[seq].tmRegister;
+    uint32_t bit = (reg >> (length - 1)) & 1u;
+    if (flip >= 100) {
+        bit ^= 1u;
+    } else if (flip > 0) {
+        // Top 16 bits of the rng scaled to 0-99
+        if ((int)(((seqs[seq].tmRng.next() >> 16) * 100u) >> 16) < flip) bit ^= 1u;
+    }
+    seqs[seq].tmRegister = (reg << 1) | bit;
+}
+
+// Output voltages of a Turing seq, read straight from the register:
+// out 1 = the newest 8 bits scaled to 0-Range volts, out 2 = out 1 moved by the
+// Harmony interval, out 3 = bits 8-15, i.e. what out 1 played 8 steps ago (a canon
+// when the loop is 16 or longer). Set a Scale on the outputs to quantize them.
+int16_t VSeq::turingValue(int seq, int out) {
+    int base = seqParam(seq, kParamSeq1TmMode);
+    uint32_t reg = seqs[seq].tmRegister;
+    uint32_t byte = (out == 2) ? ((reg >> 8) & 0xFFu) : (reg & 0xFFu);
+    
+    // 0-255 -> 0-Range volts (Range is in tenths of a volt) in the 0-65535 domain
+    int32_t raw = (int32_t)((byte * (uint32_t)param(base + 4) * 65535u) / (255u * 100u));
+    if (out == 1) {
+        raw += (param(base + 5) * 65535) / 120;  // 120 semitones over 10V
+        if (raw < 0) raw = 0;
+        if (raw > 65535) raw = 65535;
+    }
+    return (int16_t)(raw - 32768);
+}
+
+int VSeq::gateViewStep(int track, int step, int length) {
+    if (transformBypass & (1 << (kGateSlot + track))) return step;
+    int base = kParamGate1Rotate + (track * 3);
+    return viewStep(step, length, param(base), param(base + 1) != 0);
+}
+
+bool VSeq::gateOn(int track, int step, int length) {
+    int stored = gateViewStep(track, step, length);
+    if (transformBypass & (1 << (kGateSlot + track))) return gateStep(track, stored);
+    bool gate = generated(track) ? gates[track].euclidMask.get(stored) : gateStep(track, stored);
+    // Invert only flips steps inside the track length (the others never play)
+    if (param(kParamGate1Invert + (track * 3)) && step < length) gate = !gate;
+    return gate;
+}
+
+// Track is playing its Euclidean pattern. Hits is checked live as well, so
+// turning the generator off (or a commit resetting it) is heard at once, before
+// the next block has rebuilt the masks.
+bool VSeq::generated(int track) {
+    return ((generatedTracks >> track) & 1) && param(kParamGate1EuclidHits + (track * 3)) > 0;
+}
+
+// Accented hit of a generated track (always false for stored steps)
+bool VSeq::gateAccent(int track, int step, int length) {
+    if (!generated(track) || (transformBypass & (1 << (kGateSlot + track)))) return false;
+    return gates[track].accentMask.get(gateViewStep(track, step, length));
+}
+
+// Rebuild a gate track's generated steps from its Euclid parameters. Runs once
+// per parameter change (from step(), see euclidDirty), never per tick.
+void VSeq::regenerate(int track) {
+    int base = kParamGate1EuclidHits + (track * 3);
+    int hits = param(base);
+    int length = param(kParamGate1Length + (track * 9));
+    if (length > maxSteps) length = maxSteps;
+    
+    StepBits& pattern = gates[track].euclidMask;
+    StepBits& accents = gates[track].accentMask;
+    pattern.clear();
+    accents.clear();
+    if (hits > 0) {
+        euclidPattern(pattern, hits, length);
+        
+        // Accents are a second Euclidean pattern laid over the hits in order
+        if (param(base + 2) > 0) {
+            StepBits accentPattern;
+            euclidPattern(accentPattern, param(base + 2), pattern.count());
+            int k = 0;
+            for (int step = 0; step < length; step++) {
+                if (pattern.get(step) && accentPattern.get(k++)) accents.set(step);
+            }
+        }
+        
+        rotateSteps(pattern, length, param(base + 1));
+        rotateSteps(accents, length, param(base + 1));
+    }
+
+    if (hits > 0) {
+        generatedTracks |= (uint8_t)(1 << track);
+    } else {
+        generatedTracks &= (uint8_t)~(1 << track);
+    }
+}
+
+// True if the view differs from the stored pattern (a running Euclidean
+// generator counts, so committing a gate track also freezes it)
+bool VSeq::transformActive(int view) {
+    if (view < kGateSlot) {
+        int base = seqParam(view, kParamSeq1Rotate);
+        return param(base) != 0 || param(base + 1) != 0 || param(base + 2) != 0 || param(base + 3) != 100 || param(base + 4) != 0;
+    }
+    int base = kParamGate1Rotate + ((view - kGateSlot) * 3);
+    return param(base) != 0 || param(base + 1) != 0 || param(base + 2) != 0 || param(kParamGate1EuclidHits + ((view - kGateSlot) * 3)) != 0;
+}
+
+// UI side: bake a view into the playing pattern. The whole view goes through the
+// edit log as one batch (so step() never sees it half-written), followed by a
+// commit marker; step() then plays the view untransformed until its parameters
+// are back at neutral. Returns false if there was nothing to commit or the log
+// could not take the whole batch (nothing is written then).
+bool VSeq::commitTransform(int view) {
+    if (!transformActive(view) || (transformBypass & (1 << view))) return false;
+    
+    if (view < kGateSlot) {
+        if (turing(view)) return false;  // Nothing in the steps to bake
+        int stepCount = param(seqParam(view, kParamSeq1StepCount));
+        if (editLog.space() < (uint32_t)(stepCount * numOuts) + 1) return false;
+        
+        // Read the whole view first, the stored steps are the source of it
+        int16_t baked[kMaxSteps][3];
+        for (int step = 0; step < stepCount; step++) {
+            for (int out = 0; out < numOuts; out++) {
+                baked[step][out] = cvValue(view, step, out);
+            }
+        }
+        for (int step = 0; step < stepCount; step++) {
+            for (int out = 0; out < numOuts; out++) {
+                editLog.add(kEditCvValue, view, activePattern[view], step, out, baked[step][out]);
+            }
+        }
+        editLog.add(kEditCommit, view, activePattern[view], 0, 0, 0);
+    } else {
+        int track = view - kGateSlot;
+        int trackLength = param(kParamGate1Length + (track * 9));
+        if (editLog.space() < (uint32_t)trackLength + 1) return false;
+        
+        bool baked[kMaxSteps];
+        for (int step = 0; step < trackLength; step++) {
+            baked[step] = gateOn(track, step);
+        }
+        for (int step = 0; step < trackLength; step++) {
+            editLog.add(kEditGate, 0, activePattern[kGateSlot], step, track, baked[step] ? 1 : 0);
+        }
+        editLog.add(kEditCommit, kGateSlot, activePattern[kGateSlot], 0, track, 0);
+    }
+    editLog.publish();
+    return true;
+}
+
+// Audio side: the baked pattern is in place, so stop applying the view and
+// return its transform parameters to neutral
+void VSeq::finishCommit(int view) {
+    transformBypass |= (1 << view);
+    
+    if (view < kGateSlot) {
+        int base = seqParam(view, kParamSeq1Rotate);
+        setParameterFromAudio(base, 0);
+        setParameterFromAudio(base + 1, 0);
+        setParameterFromAudio(base + 2, 0);
+        setParameterFromAudio(base + 3, 100);
+        setParameterFromAudio(base + 4, 0);
+    } else {
+        int base = kParamGate1Rotate + ((view - kGateSlot) * 3);
+        for (int i = 0; i < 3; i++) {
+            setParameterFromAudio(base + i, 0);
+        }
+        setParameterFromAudio(kParamGate1EuclidHits + ((view - kGateSlot) * 3), 0);
+    }
+}
+
+void VSeq::schedule(uint32_t time, uint8_t type, uint8_t target, uint8_t data1, uint8_t data2) {
+    SeqEvent e;
+    e.time = time;
+    e.type = type;
+    e.target = target;
+    e.data1 = data1;
+    e.data2 = data2;
+    if (events.push(e)) return;
+    
+    // Queue full: a pulse end or note/CC release must still happen, so it happens
+    // now (early) rather than never. Anything else is dropped.
+    bool release = (type == kEvtTrigOff) || (type == kEvtClockOutOff) || (type == kEvtMidiNoteOff) ||
+                   (type == kEvtMidiCC && data2 == 0);
+    if (release) dispatchEvent(e);
+}
+
+void VSeq::handleReset() {
+    resetEpoch++;   // Cancel pending swing-delayed triggers
+    clockEpoch++;   // Cancel pending subdivision ticks
+    
+    // Silence every sounding note before the sequencers restart
+    releaseAllVoices();
+    
+    for (int seq = 0; seq < numSeqs; seq++) {
+        resetSequencer(seq);
+        seqs[seq].clockCounter = 0;
+    }
+    
+    // Reset is a pattern boundary too: queued patterns start from the top
+    barClockCount = 0;
+    switchQueuedPatterns();
+    
+    for (int track = 0; track < numTracks; track++) {
+        // Stopped tracks keep their position
+        if (param(kParamGate1Run + (track * 9)) == 0) continue;
+        
+        gates[track].currentStep = 0;
+        gates[track].pingpongForward = true;
+        gates[track].section1Counter = 0;
+        gates[track].section2Counter = 0;
+        gates[track].inSection2 = false;
+        gates[track].inFill = false;
+        gates[track].clockCounter = 0;
+    }
+}
+
+void VSeq::handleClock(uint32_t time, int source) {
+    // Measure clock period for multiplication and swing
+    // (MIDI clock uses the PLL tempo; its pulse spacing is block-quantized.
+    // The internal clock knows its exact period.)
+    int period;
+    if (source == kClockFromMidi) {
+        period = midiClock.pulsePeriod();
+    } else if (source == kClockFromInternal) {
+        period = (int)(InternalClock::period(param(kParamBpm), param(kParamPpqn)) + 0.5);
+    } else {
+        period = (int)(time - lastClockTime);
+    }
+    if (period > 100 && period < 96000) {
+        clockPeriod = period;
+    }
+    lastClockTime = time;
+    clockEpoch++;
+    
+    // Bar switching: a bar is 16 clock pulses (16th notes), or 4 × PPQN on the internal clock
+    if (param(kParamPatternSwitch) == 1) {
+        uint32_t barLength = (source == kClockFromInternal) ? (uint32_t)(4 * param(kParamPpqn)) : 16;
+        if ((barClockCount % barLength) == 0) {
+            switchQueuedPatterns();
+        }
+    }
+    barClockCount++;
+    
+    // CV sequencers
+    for (int seq = 0; seq < numSeqs; seq++) {
+        int divisor, multiplier;
+        decodeClockDiv(played(seqParam(seq, kParamSeq1ClockDiv)), divisor, multiplier);
+        
+        if (divisor > 1) {
+            // Division mode: count clocks before advancing
+            seqs[seq].clockCounter++;
+            if (seqs[seq].clockCounter < divisor) continue;
+            seqs[seq].clockCounter = 0;
+        }
+        stepCvSequencer(seq, time, 0);
+        
+        // Multiplication mode: schedule the first subdivision between external clocks
+        if (multiplier > 1) {
+            schedule(time + (clockPeriod / multiplier), kEvtCvTick, seq, 1, clockEpoch);
+        }
+    }
+    
+    // Gate tracks
+    for (int track = 0; track < numTracks; track++) {
+        if (param(kParamGate1Run + (track * 9)) == 0) continue;
+        
+        int divisor, multiplier;
+        decodeClockDiv(played(kParamGate1ClockDiv + (track * 9)), divisor, multiplier);
+        
+        if (divisor > 1) {
+            gates[track].clockCounter++;
+            if (gates[track].clockCounter < divisor) continue;
+            gates[track].clockCounter = 0;
+        }
+        stepGateTrack(track, time, 0);
+        
+        if (multiplier > 1) {
+            schedule(time + (clockPeriod / multiplier), kEvtGateTick, track, 1, clockEpoch);
+        }
+    }
+}
+
+// Advance a CV sequencer and schedule its MIDI notes
+void VSeq::stepCvSequencer(int seq, uint32_t time, uint8_t subdivision) {
+    (void)subdivision;
+    int direction = played(seqParam(seq, kParamSeq1Direction));    // 0=Forward, 1=Backward, 2=Pingpong
+    int stepCount = played(seqParam(seq, kParamSeq1StepCount));    // 1 to maxSteps
+    int splitPoint = param(seqParam(seq, kParamSeq1SplitPoint));   // 1 to maxSteps-1
+    int sec1Reps = param(seqParam(seq, kParamSeq1Section1Reps));   // 1-99
+    int sec2Reps = param(seqParam(seq, kParamSeq1Section2Reps));   // 1-99
+    
+    advanceSequencer(seq, direction, stepCount, splitPoint, sec1Reps, sec2Reps);
+    
+    // Clamp current step to step count (safety check)
+    if (seqs[seq].currentStep >= stepCount) {
+        seqs[seq].currentStep = stepCount - 1;
+    }
+    
+    // Turing mode: the register moves on every step (the step position still
+    // runs, for pattern switching and the display)
+    if (turing(seq)) {
+        shiftTuring(seq);
+    }
+    
+    // Queued pattern takes over when the loop wraps, so its first step plays now
+    if (param(kParamPatternSwitch) == 0 && cvAtLoopStart(seq)) {
+        switchQueuedPattern(seq);
+    }
+    
+    // Send MIDI note for each output with a channel configured
+    int step = seqs[seq].currentStep;
+    for (int out = 0; out < numOuts; out++) {
+        int midiChannel = param(seqOutParam(seq, out, kParamSeq1Midi1));  // 0 = off, 1-16 = MIDI channels
+        if (midiChannel < 1 || midiChannel > 16) continue;
+        
+        // Convert CV value to MIDI note (0-127)
+        int16_t value = playedCvValue(seq, step, out);
+        uint8_t midiNote;
+        if (param(seqOutParam(seq, out, kParamSeq1Scale1)) > 0) {
+            // Quantized: the same note the CV output plays
+            int note = quantizedNote(seq, out, value) + kQuantizeMidiBase;
+            midiNote = (uint8_t)((note > 127) ? 127 : note);
+        } else {
+            float normalized = (value + 32768) / 65535.0f;  // 0.0-1.0
+            midiNote = (uint8_t)(normalized * 127.0f);
+            if (midiNote > 127) midiNote = 127;
+        }
+        
+        schedule(time, kEvtMidiNoteOn, voice(seq, out), midiNote, 100);  // Fixed velocity
+    }
+}
+
+// Trigger delay in samples for a gate track step under the current groove.
+// The 16 delays are recomputed only when the track's step length or the groove changes.
+uint32_t VSeq::grooveDelayFor(int track, int step) {
+    int groove = param(kParamGroove);
+    
+    if (groove == 0) {
+        // Swing: delay odd-numbered steps
+        // swing=100 = delay by 50% of clock period (triplet feel)
+        // swing=0 = no delay (straight)
+        int swing = played(kParamGate1Swing + (track * 9));  // 0-100 (percentage of swing delay)
+        if ((step % 2) == 1 && swing > 0 && clockPeriod > 0) {
+            return (uint32_t)(clockPeriod * swing) / 200;  // divide by 200 = (100 * 2)
+        }
+        return 0;
+    }
+    
+    int divisor, multiplier;
+    decodeClockDiv(played(kParamGate1ClockDiv + (track * 9)), divisor, multiplier);
+    int stepLen = (clockPeriod * divisor) / multiplier;
+    
+    if (stepLen != gates[track].grooveStepLength || gates[track].grooveTrackVersion != grooveVersion) {
+        for (int i = 0; i < 16; i++) {
+            int hundredths = (groove == 8) ? param(kParamGrooveStep1 + i) : kGrooveTemplates[groove - 1][i];
+            gates[track].grooveDelay[i] = (uint32_t)((stepLen * hundredths) / 100);
+        }
+        gates[track].grooveStepLength = stepLen;
+        gates[track].grooveTrackVersion = grooveVersion;
+    }
+    return gates[track].grooveDelay[step % 16];
+}
+
+// Fill an output's quantizer table. Each of the 1024 entries covers 64 step values;
+// its centre is snapped to the nearest note of the scale (the lower one on a tie).
+void VSeq::buildQuantTable(int index, int scale, int root) {
+    uint16_t mask = kScaleMasks[(scale > 0) ? scale - 1 : 0];
+    
+    for (int i = 0; i < 1024; i++) {
+        // Centre of this slice of the int16_t range, in semitones above 0V
+        float semitones = (((i * 64) + 32) / 65535.0f) * 120.0f;
+        int below = (int)semitones;
+        int above = below + 1;
+        
+        // Walk outwards to the nearest notes in the scale (at most 11 steps each way)
+        while (below > 0 && !((mask >> ((below - root + 12) % 12)) & 1)) below--;
+        while (above < 120 && !((mask >> ((above - root + 12) % 12)) & 1)) above++;
+        bool belowIn = (mask >> ((below - root + 12) % 12)) & 1;
+        bool aboveIn = (mask >> ((above - root + 12) % 12)) & 1;
+        
+        int note;
+        if (!belowIn) note = above;
+        else if (!aboveIn) note = below;
+        else note = (semitones - below <= above - semitones) ? below : above;
+        if (note > 120) note = 120;
+        voices[index].quantTable[i] = (uint8_t)note;
+    }
+}
+
+// Quantized note of a step value on one CV output (the table is kept up to
+// date by parameterChanged)
+int VSeq::quantizedNote(int seq, int out, int16_t value) {
+    return voices[voice(seq, out)].quantTable[(uint16_t)(value + 32768) >> 6];
+}
+
+// Advance a gate track and schedule its trigger (delayed by the groove)
+void VSeq::stepGateTrack(int track, uint32_t time, uint8_t subdivision) {
+    (void)subdivision;
+    int trackLength = played(kParamGate1Length + (track * 9));    // 1 to maxSteps
+    int direction = played(kParamGate1Direction + (track * 9));   // 0=Forward, 1=Backward, 2=Pingpong
+    int splitPoint = param(kParamGate1SplitPoint + (track * 9));  // 0 to maxSteps-1 (0 = no split)
+    int sec1Reps = param(kParamGate1Section1Reps + (track * 9));  // 1-99
+    int sec2Reps = param(kParamGate1Section2Reps + (track * 9));  // 1-99
+    int fillStart = param(kParamGate1FillStart + (track * 9));    // 1 to maxSteps (step where fill replaces section 1 on last rep)
+    
+    advanceGateSequencer(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
+    
+    // The gate pattern ends when the first running track wraps
+    if (param(kParamPatternSwitch) == 0 && gateAtLoopStart(track)) {
+        int leadTrack = 0;
+        while (leadTrack < numTracks - 1 && param(kParamGate1Run + (leadTrack * 9)) == 0) leadTrack++;
+        if (track == leadTrack) {
+            switchQueuedPattern(kGateSlot);
+        }
+    }
+    
+    int step = gates[track].currentStep;
+    if (step < 0 || step >= maxSteps || !gateOn(track, step, trackLength)) return;
+    
+    // Accent level: 0 = plain step, 1 = unaccented hit of a track with accents, 2 = accented
+    uint8_t accent = 0;
+    if (generated(track) && param(kParamGate1EuclidAccent + (track * 3)) > 0) {
+        accent = gateAccent(track, step, trackLength) ? 2 : 1;
+    }
+    
+    // Groove delay, landing on its exact frame through the event queue
+    schedule(time + grooveDelayFor(track, step), kEvtTrigOn, track, accent, resetEpoch);
+}
 
-static char gate6RunName[] = "Gate 6 Run";
-static char gate6LenName[] = "Gate 6 Length";
-static char gate6DirName[] = "Gate 6 Direction";
-static char gate6DivName[] = "Gate 6 ClockDiv";
-static char gate6SwingName[] = "Gate 6 Swing";
-static char gate6SplitName[] = "Gate 6 Split";
-static char gate6Sec1Name[] = "Gate 6 Sec1 Reps";
-static char gate6Sec2Name[] = "Gate 6 Sec2 Reps";
-static char gate6FillName[] = "Gate 6 Fill Start";
+void VSeq::dispatchEvent(const SeqEvent& e) {
+    switch (e.type) {
+        case kEvtReset:
+            handleReset();
+            break;
+            
+        case kEvtClock:
+            handleClock(e.time, e.data1);
+            if (e.data1 == kClockFromInternal) {
+                clockOutHigh = true;
+                clockOutOffTime = e.time + kTriggerSamples;
+                schedule(clockOutOffTime, kEvtClockOutOff, 0);
+            }
+            break;
+            
+        case kEvtClockOutOff:
+            if (e.time == clockOutOffTime) {
+                clockOutHigh = false;
+            }
+            break;
+            
+        case kEvtCvTick:
+        case kEvtGateTick: {
+            // Ignore ticks scheduled before the latest clock edge or reset
+            if (e.data2 != clockEpoch) break;
+            
+            bool isGate = (e.type == kEvtGateTick);
+            int track = e.target;
+            if (isGate && param(kParamGate1Run + (track * 9)) == 0) break;
+            
+            int divisor, multiplier;
+            int divParam = isGate ? kParamGate1ClockDiv + (track * 9) : seqParam(track, kParamSeq1ClockDiv);
+            decodeClockDiv(played(divParam), divisor, multiplier);
+            if (e.data1 >= multiplier) break;  // Multiplier lowered since the tick was scheduled
+            
+            if (isGate) {
+                stepGateTrack(track, e.time, e.data1);
+            } else {
+                stepCvSequencer(track, e.time, e.data1);
+            }
+            
+            // Schedule the next subdivision relative to the clock edge (no accumulated rounding)
+            int next = e.data1 + 1;
+            if (next < multiplier) {
+                uint32_t nextTime = lastClockTime + (uint32_t)((clockPeriod * next) / multiplier);
+                schedule(nextTime, e.type, track, next, clockEpoch);
+            }
+            break;
+        }
+            
+        case kEvtTrigOn: {
+            if (e.data2 != resetEpoch) break;  // Cancelled by reset
+            int track = e.target;
+            gates[track].high = true;
+            gates[track].level = (e.data1 == 2) ? 10.0f : 5.0f;  // Accents fire at 10V
+            gates[track].offTime = e.time + kTriggerSamples;
+            schedule(gates[track].offTime, kEvtTrigOff, track);
+            
+            // Send MIDI CC if configured
+            int triggerMidiChannel = param(kParamTriggerMidiChannel);  // 0 = off, 1-16 = MIDI channels
+            if (triggerMidiChannel > 0 && triggerMidiChannel <= 16) {
+                int ccNumber = param(kParamGate1CC + (track * 2));  // 0-127
+                // CC value 127 when trigger fires; unaccented hits of a track with accents send 100
+                schedule(e.time, kEvtMidiCC, track, ccNumber, (e.data1 == 1) ? 100 : 127);
+            }
+            break;
+        }
+            
+        case kEvtTrigOff:
+            // A retrigger moves the off time; only the latest pulse's off event applies
+            if (e.time == gates[e.target].offTime) {
+                gates[e.target].high = false;
+                
+                // Release: the CC goes back to 0 when the pulse ends
+                if (param(kParamTriggerMidiChannel) > 0) {
+                    schedule(e.time, kEvtMidiCC, e.target, param(kParamGate1CC + (e.target * 2)), 0);
+                }
+            }
+            break;
+            
+        case kEvtMidiNoteOn:
+            startNote(e.target, e.data1, e.data2, e.time);
+            break;
+            
+        case kEvtMidiNoteOff:
+            // A newer note on this output moves the off time; only its own off applies
+            if (voices[e.target].note == (int8_t)e.data1 && e.time == voices[e.target].offTime) {
+                releaseVoice(e.target);
+            }
+            break;
+            
+        case kEvtMidiCC: {
+            int triggerMidiChannel = param(kParamTriggerMidiChannel);
+            if (triggerMidiChannel < 1 || triggerMidiChannel > 16) break;
+            uint8_t channel = (triggerMidiChannel - 1) & 0x0F;
+            NT_sendMidi3ByteMessage(kNT_destinationInternal, 0xB0 | channel, e.data1, e.data2);
+            break;
+        }
+    }
+}
 
-// Global parameter array
-static _NT_parameter parameters[kNumParameters];
+// Length of one step of a CV sequencer in samples, from the measured clock period
+int VSeq::stepLength(int seq) {
+    int divisor, multiplier;
+    decodeClockDiv(played(seqParam(seq, kParamSeq1ClockDiv)), divisor, multiplier);
+    return (clockPeriod * divisor) / multiplier;
+}
 
-// Initialize parameter definitions
-static void initParameters() {
-    // Clock and Reset inputs
-    parameters[kParamClockIn].name = "Clock in";
-    parameters[kParamClockIn].min = 0;
-    parameters[kParamClockIn].max = 28;
-    parameters[kParamClockIn].def = 1;
-    parameters[kParamClockIn].unit = kNT_unitCvInput;
-    parameters[kParamClockIn].scaling = kNT_scalingNone;
+// Play a note on a CV output's voice and schedule its note-off from the gate length
+void VSeq::startNote(int out, uint8_t note, uint8_t velocity, uint32_t time) {
+    int seq = out / numOuts;
+    int midiChannel = param(seqOutParam(seq, out % numOuts, kParamSeq1Midi1));  // 0 = off, 1-16 = MIDI channels
+    if (midiChannel < 1 || midiChannel > 16) return;
+    uint8_t channel = (midiChannel - 1) & 0x0F;
     
-    parameters[kParamResetIn].name = "Reset in";
-    parameters[kParamResetIn].min = 0;
-    parameters[kParamResetIn].max = 28;
-    parameters[kParamResetIn].def = 2;
-    parameters[kParamResetIn].unit = kNT_unitCvInput;
-    parameters[kParamResetIn].scaling = kNT_scalingNone;
+    int gateLength = param(seqParam(seq, kParamSeq1GateLength));  // 1-100%
+    bool tie = (gateLength >= 100);
     
-    // CV Outputs (12 total)
-    const char* outNames[] = {
-        "Seq 1 Out 1", "Seq 1 Out 2", "Seq 1 Out 3",
-        "Seq 2 Out 1", "Seq 2 Out 2", "Seq 2 Out 3",
-        "Seq 3 Out 1", "Seq 3 Out 2", "Seq 3 Out 3",
-        "Seq 4 Out 1", "Seq 4 Out 2", "Seq 4 Out 3"
-    };
+    int8_t prevNote = voices[out].note;
+    uint8_t prevChannel = voices[out].channel;
     
-    for (int i = 0; i < 12; i++) {
-        int paramIdx = kParamSeq1Out1 + i;
-        parameters[paramIdx].name = outNames[i];
-        parameters[paramIdx].min = 0;
-        parameters[paramIdx].max = 28;
-        parameters[paramIdx].def = 0;
-        parameters[paramIdx].unit = kNT_unitCvOutput;
-        parameters[paramIdx].scaling = kNT_scalingNone;
+    if (prevNote >= 0) {
+        // Tied repeat of the same note: keep it sounding, no retrigger
+        if (tie && prevNote == (int8_t)note && prevChannel == channel) return;
+        
+        // Previous note outlived its gate (e.g. the clock sped up): close it first
+        if (!tie) {
+            releaseVoice(out);
+            prevNote = -1;
+        }
     }
     
-    // MIDI channel parameters (9 total: 3 sequencers × 3 outputs each)
-    const char* midiNames[] = {
-        seq1Midi1Name, seq1Midi2Name, seq1Midi3Name,
-        seq2Midi1Name, seq2Midi2Name, seq2Midi3Name,
-        seq3Midi1Name, seq3Midi2Name, seq3Midi3Name
-    };
+    NT_sendMidi3ByteMessage(kNT_destinationInternal, 0x90 | channel, note, velocity);
+    voices[out].note = (int8_t)note;
+    voices[out].channel = channel;
     
-    for (int i = 0; i < 9; i++) {
-        int paramIdx = kParamSeq1Midi1 + i;
-        parameters[paramIdx].name = midiNames[i];
-        parameters[paramIdx].min = 0;  // 0 = Off
-        parameters[paramIdx].max = 16; // 1-16 = MIDI channels
-        parameters[paramIdx].def = 0;  // Off by default
-        parameters[paramIdx].unit = kNT_unitNone;
-        parameters[paramIdx].scaling = kNT_scalingNone;
+    if (tie) {
+        // Legato: release the old note only after the new one has started
+        if (prevNote >= 0) {
+            NT_sendMidi3ByteMessage(kNT_destinationInternal, 0x80 | prevChannel, (uint8_t)prevNote, 0);
+        }
+        voices[out].offTime = time;  // Invalidates any note-off still in the queue
+        return;
     }
     
-    // Trigger sequencer MIDI channel
-    parameters[kParamTriggerMidiChannel].name = triggerMidiChannelName;
-    parameters[kParamTriggerMidiChannel].min = 0;  // 0 = Off
-    parameters[kParamTriggerMidiChannel].max = 16; // 1-16 = MIDI channels
-    parameters[kParamTriggerMidiChannel].def = 0;  // Off by default
-    parameters[kParamTriggerMidiChannel].unit = kNT_unitNone;
-    parameters[kParamTriggerMidiChannel].scaling = kNT_scalingNone;
+    int gateSamples = (stepLength(seq) * gateLength) / 100;
+    if (gateSamples < 1) gateSamples = 1;
+    voices[out].offTime = time + gateSamples;
+    schedule(voices[out].offTime, kEvtMidiNoteOff, out, note);
+}
+
+// Send the note-off for a CV output's sounding note (exactly once)
+void VSeq::releaseVoice(int out) {
+    if (voices[out].note < 0) return;
+    NT_sendMidi3ByteMessage(kNT_destinationInternal, 0x80 | voices[out].channel, (uint8_t)voices[out].note, 0);
+    voices[out].note = -1;
+}
+
+void VSeq::releaseAllVoices() {
+    for (int out = 0; out < numSeqs * numOuts; out++) {
+        releaseVoice(out);
+    }
+}
+
+// MIDI Start: play from the top
+void VSeq::transportStart() {
+    handleReset();
+    midiClock.restart();
+    transportRunning = true;
+}
+
+// MIDI Stop: hold position and silence notes
+void VSeq::transportStop() {
+    transportRunning = false;
+    clockEpoch++;   // Cancel pending subdivision ticks
+    releaseAllVoices();
+}
+
+// MIDI Continue: resume from the current (or seeked) position
+void VSeq::transportContinue() {
+    midiClock.restart();
+    transportRunning = true;
+}
+
+// MIDI Song Position Pointer: position is in 16th notes, one clock pulse each.
+// Every sequencer and running gate track is put exactly where it would be after
+// that many pulses from reset, including clock division phase and section repeats.
+void VSeq::seekToPosition(uint32_t position) {
+    resetEpoch++;   // Cancel pending swing-delayed triggers
+    clockEpoch++;   // Cancel pending subdivision ticks
+    releaseAllVoices();
+    midiClock.restart();
+    barClockCount = position;  // Keep bar switching in step with the song
     
-    // Sequencer configuration parameters (seq 1-3 only now)
-    const char* divNames[] = {seq1DivName, seq2DivName, seq3DivName};
-    const char* dirNames[] = {seq1DirName, seq2DirName, seq3DirName};
-    const char* stepNames[] = {seq1StepName, seq2StepName, seq3StepName};
-    const char* splitNames[] = {seq1SplitName, seq2SplitName, seq3SplitName};
-    const char* sec1Names[] = {seq1Sec1Name, seq2Sec1Name, seq3Sec1Name};
-    const char* sec2Names[] = {seq1Sec2Name, seq2Sec2Name, seq3Sec2Name};
-    
-    for (int seq = 0; seq < 3; seq++) {
-        int divParam = kParamSeq1ClockDiv + (seq * 6);
-        int dirParam = kParamSeq1Direction + (seq * 6);
-        int stepParam = kParamSeq1StepCount + (seq * 6);
-        int splitParam = kParamSeq1SplitPoint + (seq * 6);
-        int sec1Param = kParamSeq1Section1Reps + (seq * 6);
-        int sec2Param = kParamSeq1Section2Reps + (seq * 6);
-        
-        // Clock Division parameter
-        parameters[divParam].name = divNames[seq];
-        parameters[divParam].min = 0;
-        parameters[divParam].max = 30;  // /16 to /2, x1 to x16 (31 options)
-        parameters[divParam].def = 14;  // Default to /2
-        parameters[divParam].unit = kNT_unitEnum;
-        parameters[divParam].scaling = kNT_scalingNone;
-        parameters[divParam].enumStrings = divisionStrings;
+    for (int seq = 0; seq < numSeqs; seq++) {
+        int divisor, multiplier;
+        decodeClockDiv(played(seqParam(seq, kParamSeq1ClockDiv)), divisor, multiplier);
+        uint32_t advances = (position / divisor) * multiplier;
+        seqs[seq].clockCounter = (divisor > 1) ? (int)(position % divisor) : 0;
         
-        // Direction parameter
-        parameters[dirParam].name = dirNames[seq];
-        parameters[dirParam].min = 0;
-        parameters[dirParam].max = 2;  // Forward, Backward, Pingpong
-        parameters[dirParam].def = 0;  // Forward
-        parameters[dirParam].unit = kNT_unitEnum;
-        parameters[dirParam].scaling = kNT_scalingNone;
-        parameters[dirParam].enumStrings = directionStrings;
+        LoopPlan plan;
+        buildCvLoop(plan, played(seqParam(seq, kParamSeq1Direction)), played(seqParam(seq, kParamSeq1StepCount)),
+                    param(seqParam(seq, kParamSeq1SplitPoint)), param(seqParam(seq, kParamSeq1Section1Reps)),
+                    param(seqParam(seq, kParamSeq1Section2Reps)));
+        LoopState st = plan.seek(advances);
         
-        // Step Count parameter
-        parameters[stepParam].name = stepNames[seq];
-        parameters[stepParam].min = 1;
-        parameters[stepParam].max = 32;
-        parameters[stepParam].def = 16;  // Default to 16 steps
-        parameters[stepParam].unit = kNT_unitNone;
-        parameters[stepParam].scaling = kNT_scalingNone;
+        seqs[seq].currentStep = st.step;
+        seqs[seq].section1Counter = st.section1Counter;
+        seqs[seq].section2Counter = st.section2Counter;
+        seqs[seq].inSection2 = st.inSection2;
+        seqs[seq].pingpongForward = st.pingpongForward;
+    }
+    
+    for (int track = 0; track < numTracks; track++) {
+        // Stopped tracks keep their position
+        if (param(kParamGate1Run + (track * 9)) == 0) continue;
         
-        // Split Point parameter
-        parameters[splitParam].name = splitNames[seq];
-        parameters[splitParam].min = 1;
-        parameters[splitParam].max = 31;
-        parameters[splitParam].def = 8;  // Default to middle of 16 steps
-        parameters[splitParam].unit = kNT_unitNone;
-        parameters[splitParam].scaling = kNT_scalingNone;
+        int divisor, multiplier;
+        decodeClockDiv(played(kParamGate1ClockDiv + (track * 9)), divisor, multiplier);
+        uint32_t advances = (position / divisor) * multiplier;
+        gates[track].clockCounter = (divisor > 1) ? (int)(position % divisor) : 0;
         
-        // Section 1 Repeats parameter
-        parameters[sec1Param].name = sec1Names[seq];
-        parameters[sec1Param].min = 1;
-        parameters[sec1Param].max = 99;
-        parameters[sec1Param].def = 1;
-        parameters[sec1Param].unit = kNT_unitNone;
-        parameters[sec1Param].scaling = kNT_scalingNone;
+        LoopPlan plan;
+        buildTrackLoop(plan, played(kParamGate1Direction + (track * 9)), played(kParamGate1Length + (track * 9)),
+                      param(kParamGate1SplitPoint + (track * 9)), param(kParamGate1Section1Reps + (track * 9)),
+                      param(kParamGate1Section2Reps + (track * 9)), param(kParamGate1FillStart + (track * 9)));
+        LoopState st = plan.seek(advances);
         
-        // Section 2 Repeats parameter
-        parameters[sec2Param].name = sec2Names[seq];
-        parameters[sec2Param].min = 1;
-        parameters[sec2Param].max = 99;
-        parameters[sec2Param].def = 1;
-        parameters[sec2Param].unit = kNT_unitNone;
-        parameters[sec2Param].scaling = kNT_scalingNone;
+        gates[track].currentStep = st.step;
+        gates[track].section1Counter = st.section1Counter;
+        gates[track].section2Counter = st.section2Counter;
+        gates[track].inSection2 = st.inSection2;
+        gates[track].pingpongForward = st.pingpongForward;
+        gates[track].inFill = false;
     }
+}
+
+// Group the routed outputs by bus for this block
+void VSeq::planOutputs() {
+    uint8_t writerBus[kMaxWriters];
+    bool writerReplace[kMaxWriters];
+    uint8_t writerIds[kMaxWriters];
+    int numWriters = 0;
     
-    // Gate outputs and MIDI CC parameters (6 tracks, 2 parameters each)
-    const char* gateOutNames[] = {gate1OutName, gate2OutName, gate3OutName, gate4OutName, gate5OutName, gate6OutName};
-    const char* gateCCNames[] = {gate1CCName, gate2CCName, gate3CCName, gate4CCName, gate5CCName, gate6CCName};
+    // CV outputs
+    for (int seq = 0; seq < numSeqs; seq++) {
+        for (int out = 0; out < numOuts; out++) {
+            int outputBus = param(seqOutParam(seq, out, kParamSeq1Out1));  // 0 = none, 1-28 = bus 0-27
+            if (outputBus < 1 || outputBus > 28) continue;
+            writerIds[numWriters] = (uint8_t)voice(seq, out);
+            writerBus[numWriters] = (uint8_t)(outputBus - 1);
+            writerReplace[numWriters] = param(seqOutParam(seq, out, kParamSeq1Out1Mode)) != 0;
+            numWriters++;
+        }
+    }
     
-    for (int track = 0; track < 6; track++) {
-        int outParam = kParamGate1Out + (track * 2);
-        int ccParam = kParamGate1CC + (track * 2);
-        
-        parameters[outParam].name = gateOutNames[track];
-        parameters[outParam].min = 0;
-        parameters[outParam].max = 28;
-        parameters[outParam].def = 0;
-        parameters[outParam].unit = kNT_unitCvOutput;
-        parameters[outParam].scaling = kNT_scalingNone;
-        
-        parameters[ccParam].name = gateCCNames[track];
-        parameters[ccParam].min = 0;  // 0-127
-        parameters[ccParam].max = 127;
-        parameters[ccParam].def = 0;  // Default to CC 0 for all
-        parameters[ccParam].unit = kNT_unitNone;
-        parameters[ccParam].scaling = kNT_scalingNone;
+    // Gate outputs of running tracks
+    for (int track = 0; track < numTracks; track++) {
+        if (param(kParamGate1Run + (track * 9)) == 0) continue;
+        int outputBus = param(kParamGate1Out + (track * 2));
+        if (outputBus < 1 || outputBus > 28) continue;
+        writerIds[numWriters] = (uint8_t)(kWriterGate + track);
+        writerBus[numWriters] = (uint8_t)(outputBus - 1);
+        writerReplace[numWriters] = param(kParamGate1OutMode + track) != 0;
+        numWriters++;
     }
     
-    // Gate Track parameters (6 tracks, 10 parameters each - minus the Out param which is now separate)
-    const char* gateRunNames[] = {gate1RunName, gate2RunName, gate3RunName, gate4RunName, gate5RunName, gate6RunName};
-    const char* gateLenNames[] = {gate1LenName, gate2LenName, gate3LenName, gate4LenName, gate5LenName, gate6LenName};
-    const char* gateDirNames[] = {gate1DirName, gate2DirName, gate3DirName, gate4DirName, gate5DirName, gate6DirName};
-    const char* gateDivNames[] = {gate1DivName, gate2DivName, gate3DivName, gate4DivName, gate5DivName, gate6DivName};
-    const char* gateSwingNames[] = {gate1SwingName, gate2SwingName, gate3SwingName, gate4SwingName, gate5SwingName, gate6SwingName};
-    const char* gateSplitNames[] = {gate1SplitName, gate2SplitName, gate3SplitName, gate4SplitName, gate5SplitName, gate6SplitName};
-    const char* gateSec1Names[] = {gate1Sec1Name, gate2Sec1Name, gate3Sec1Name, gate4Sec1Name, gate5Sec1Name, gate6Sec1Name};
-    const char* gateSec2Names[] = {gate1Sec2Name, gate2Sec2Name, gate3Sec2Name, gate4Sec2Name, gate5Sec2Name, gate6Sec2Name};
-    const char* gateFillNames[] = {gate1FillName, gate2FillName, gate3FillName, gate4FillName, gate5FillName, gate6FillName};
+    // Internal clock output
+    int clockOutBus = param(kParamClockOut);
+    if (clockOutBus >= 1 && clockOutBus <= 28) {
+        writerIds[numWriters] = (uint8_t)kWriterClock;
+        writerBus[numWriters] = (uint8_t)(clockOutBus - 1);
+        writerReplace[numWriters] = param(kParamClockOutMode) != 0;
+        numWriters++;
+    }
     
-    for (int track = 0; track < 6; track++) {
-        int runParam = kParamGate1Run + (track * 9);   // Now 9 params per track instead of 10
-        int lenParam = kParamGate1Length + (track * 9);
-        int dirParam = kParamGate1Direction + (track * 9);
-        int divParam = kParamGate1ClockDiv + (track * 9);
-        int swingParam = kParamGate1Swing + (track * 9);
-        int splitParam = kParamGate1SplitPoint + (track * 9);
-        int sec1Param = kParamGate1Section1Reps + (track * 9);
-        int sec2Param = kParamGate1Section2Reps + (track * 9);
-        int fillParam = kParamGate1FillStart + (track * 9);
-        
-        parameters[runParam].name = gateRunNames[track];
-        parameters[runParam].min = 0;
-        parameters[runParam].max = 1;
-        parameters[runParam].def = 0;  // Default to stopped
-        parameters[runParam].unit = kNT_unitNone;
-        parameters[runParam].scaling = kNT_scalingNone;
-        
-        parameters[lenParam].name = gateLenNames[track];
-        parameters[lenParam].min = 1;
-        parameters[lenParam].max = 32;
-        parameters[lenParam].def = 16;  // Default to 16 steps
-        parameters[lenParam].unit = kNT_unitNone;
-        parameters[lenParam].scaling = kNT_scalingNone;
-        
-        parameters[dirParam].name = gateDirNames[track];
-        parameters[dirParam].min = 0;
-        parameters[dirParam].max = 2;
-        parameters[dirParam].def = 0;
-        parameters[dirParam].unit = kNT_unitEnum;
-        parameters[dirParam].scaling = kNT_scalingNone;
-        parameters[dirParam].enumStrings = directionStrings;
-        
-        parameters[divParam].name = gateDivNames[track];
-        parameters[divParam].min = 0;
-        parameters[divParam].max = 30;
-        parameters[divParam].def = 14;  // Default to /2
-        parameters[divParam].unit = kNT_unitEnum;
-        parameters[divParam].scaling = kNT_scalingNone;
-        parameters[divParam].enumStrings = divisionStrings;
-        
-        parameters[swingParam].name = gateSwingNames[track];
-        parameters[swingParam].min = 0;
-        parameters[swingParam].max = 100;
-        parameters[swingParam].def = 0;
-        parameters[swingParam].unit = kNT_unitNone;
-        parameters[swingParam].scaling = kNT_scalingNone;
-        
-        parameters[splitParam].name = gateSplitNames[track];
-        parameters[splitParam].min = 0;
-        parameters[splitParam].max = 31;
-        parameters[splitParam].def = 0;
-        parameters[splitParam].unit = kNT_unitNone;
-        parameters[splitParam].scaling = kNT_scalingNone;
-        
-        parameters[sec1Param].name = gateSec1Names[track];
-        parameters[sec1Param].min = 1;
-        parameters[sec1Param].max = 99;
-        parameters[sec1Param].def = 1;
-        parameters[sec1Param].unit = kNT_unitNone;
-        parameters[sec1Param].scaling = kNT_scalingNone;
+    // One entry per bus in order of first use, counting its writers
+    OutputPlan& plan = outputPlan;
+    int8_t entryOf[28];
+    memset(entryOf, -1, sizeof(entryOf));
+    uint8_t count[28];
+    plan.numBuses = 0;
+    for (int i = 0; i < numWriters; i++) {
+        int entry = entryOf[writerBus[i]];
+        if (entry < 0) {
+            entry = plan.numBuses++;
+            entryOf[writerBus[i]] = (int8_t)entry;
+            plan.bus[entry] = writerBus[i];
+            plan.replace[entry] = false;
+            count[entry] = 0;
+        }
+        plan.replace[entry] |= writerReplace[i];
+        count[entry]++;
+    }
+    
+    // Writers of each entry together, in output order
+    plan.first[0] = 0;
+    for (int entry = 0; entry < plan.numBuses; entry++) {
+        plan.first[entry + 1] = plan.first[entry] + count[entry];
+        count[entry] = plan.first[entry];  // Now the next free slot of the entry
+    }
+    for (int i = 0; i < numWriters; i++) {
+        int entry = entryOf[writerBus[i]];
+        plan.writers[count[entry]++] = writerIds[i];
+    }
+}
+
+// Read the modulation inputs (one mean per block) and fold their offsets into
+// modValues. With no input assigned this is a check per input: played() then
+// reads the parameters directly.
+void VSeq::applyModulation(const float* busFrames, int numFrames) {
+    bool any = false;
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int base = kParamMod1In + (mod * 4);
+        int bus = param(base) - 1;
+        if (bus < 0) {
+            mods[mod].offset = 0;
+            continue;
+        }
+        any = true;
         
-        parameters[sec2Param].name = gateSec2Names[track];
-        parameters[sec2Param].min = 1;
-        parameters[sec2Param].max = 99;
-        parameters[sec2Param].def = 1;
-        parameters[sec2Param].unit = kNT_unitNone;
-        parameters[sec2Param].scaling = kNT_scalingNone;
+        // Units per volt at 100% depth: the target's whole range over 10V,
+        // Transpose 1V/octave
+        int target = param(base + 1);
+        float range = (target == kModLength) ? (float)(maxSteps - 1) : (target == kModDirection) ? 2.0f :
+                      (target == kModClockDiv) ? 30.0f : (target == kModSwing) ? 100.0f : 120.0f;
+        float volts = ModInput::mean(busFrames + (bus * numFrames), numFrames);
+        mods[mod].update(volts * range * param(base + 3) / 1000.0f);
+    }
+    if (!any) {
+        modulated = false;
+        return;
+    }
+    
+    memcpy(modValues, v, numParameters * sizeof(int16_t));
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int offset = mods[mod].offset;
+        if (offset == 0) continue;
+        int base = kParamMod1In + (mod * 4);
+        int target = param(base + 1);
+        int dest = param(base + 2);  // 0 = all, then Seq 1-numSeqs, then Track 1-numTracks
         
-        parameters[fillParam].name = gateFillNames[track];
-        parameters[fillParam].min = 1;
-        parameters[fillParam].max = 32;
-        parameters[fillParam].def = 1;  // Default to lowest value
-        parameters[fillParam].unit = kNT_unitNone;
-        parameters[fillParam].scaling = kNT_scalingNone;
+        for (int seq = 0; seq < numSeqs; seq++) {
+            if (dest != 0 && dest != seq + 1) continue;
+            switch (target) {
+                case kModLength:    modulate(seqParam(seq, kParamSeq1StepCount), offset); break;
+                case kModDirection: modulate(seqParam(seq, kParamSeq1Direction), offset); break;
+                case kModClockDiv:  modulate(seqParam(seq, kParamSeq1ClockDiv), offset); break;
+                case kModTranspose: modulate(seqParam(seq, kParamSeq1Transpose), offset); break;
+                default: break;
+            }
+        }
+        for (int track = 0; track < numTracks; track++) {
+            if (dest != 0 && dest != numSeqs + track + 1) continue;
+            switch (target) {
+                case kModLength:    modulate(kParamGate1Length + (track * 9), offset); break;
+                case kModDirection: modulate(kParamGate1Direction + (track * 9), offset); break;
+                case kModClockDiv:  modulate(kParamGate1ClockDiv + (track * 9), offset); break;
+                case kModSwing:     modulate(kParamGate1Swing + (track * 9), offset); break;
+                default: break;
+            }
+        }
+    }
+    modulated = true;
+}
+
+// Move one played setting, kept within its parameter's range
+void VSeq::modulate(int logical, int offset) {
+    uint8_t p = paramIndex[logical];
+    if (p == kNoParam) return;
+    int value = modValues[p] + offset;
+    if (value < parameters[p].min) value = parameters[p].min;
+    if (value > parameters[p].max) value = parameters[p].max;
+    modValues[p] = (int16_t)value;
+}
+
+// Current level of an output in volts
+float VSeq::outputLevel(int writer) {
+    if (writer < kWriterGate) {
+        // CV output: current step value, 0-10V
+        int seq = writer / numOuts;
+        int out = writer % numOuts;
+        int16_t value = playedCvValue(seq, seqs[seq].currentStep, out);
+        if (param(seqOutParam(seq, out, kParamSeq1Scale1)) > 0) {
+            // Quantized: exact 1V/octave
+            return quantizedNote(seq, out, value) / 12.0f;
+        }
+        // Convert from int16_t range (-32768 to 32767) to voltage (0.0V to 10.0V)
+        return ((value + 32768) / 65535.0f) * 10.0f;
+    }
+    if (writer < kWriterClock) {
+        // Gate output: the pulse level while a trigger is active
+        const GateTrackState& gate = gates[writer - kWriterGate];
+        return gate.high ? gate.level : 0.0f;
     }
+    return clockOutHigh ? 5.0f : 0.0f;
 }
 
-// Parameter pages
-static uint8_t paramPageInputs[] = { kParamClockIn, kParamResetIn, 0 };
-static uint8_t paramPageSeq1Out[] = { kParamSeq1Out1, kParamSeq1Midi1, kParamSeq1Out2, kParamSeq1Midi2, kParamSeq1Out3, kParamSeq1Midi3, 0 };
-static uint8_t paramPageSeq2Out[] = { kParamSeq2Out1, kParamSeq2Midi1, kParamSeq2Out2, kParamSeq2Midi2, kParamSeq2Out3, kParamSeq2Midi3, 0 };
-static uint8_t paramPageSeq3Out[] = { kParamSeq3Out1, kParamSeq3Midi1, kParamSeq3Out2, kParamSeq3Midi2, kParamSeq3Out3, kParamSeq3Midi3, 0 };
-static uint8_t paramPageSeq1Params[] = { kParamSeq1ClockDiv, kParamSeq1Direction, kParamSeq1StepCount, kParamSeq1SplitPoint, kParamSeq1Section1Reps, kParamSeq1Section2Reps, 0 };
-static uint8_t paramPageSeq2Params[] = { kParamSeq2ClockDiv, kParamSeq2Direction, kParamSeq2StepCount, kParamSeq2SplitPoint, kParamSeq2Section1Reps, kParamSeq2Section2Reps, 0 };
-static uint8_t paramPageSeq3Params[] = { kParamSeq3ClockDiv, kParamSeq3Direction, kParamSeq3StepCount, kParamSeq3SplitPoint, kParamSeq3Section1Reps, kParamSeq3Section2Reps, 0 };
-static uint8_t paramPageGateOuts[] = { kParamTriggerMidiChannel, kParamGate1Out, kParamGate1CC, kParamGate2Out, kParamGate2CC, kParamGate3Out, kParamGate3CC, kParamGate4Out, kParamGate4CC, kParamGate5Out, kParamGate5CC, kParamGate6Out, kParamGate6CC, 0 };
-static uint8_t paramPageGate1[] = { kParamGate1Run, kParamGate1Length, kParamGate1Direction, kParamGate1ClockDiv, kParamGate1Swing, kParamGate1SplitPoint, kParamGate1Section1Reps, kParamGate1Section2Reps, kParamGate1FillStart, 0 };
-static uint8_t paramPageGate2[] = { kParamGate2Run, kParamGate2Length, kParamGate2Direction, kParamGate2ClockDiv, kParamGate2Swing, kParamGate2SplitPoint, kParamGate2Section1Reps, kParamGate2Section2Reps, kParamGate2FillStart, 0 };
-static uint8_t paramPageGate3[] = { kParamGate3Run, kParamGate3Length, kParamGate3Direction, kParamGate3ClockDiv, kParamGate3Swing, kParamGate3SplitPoint, kParamGate3Section1Reps, kParamGate3Section2Reps, kParamGate3FillStart, 0 };
-static uint8_t paramPageGate4[] = { kParamGate4Run, kParamGate4Length, kParamGate4Direction, kParamGate4ClockDiv, kParamGate4Swing, kParamGate4SplitPoint, kParamGate4Section1Reps, kParamGate4Section2Reps, kParamGate4FillStart, 0 };
-static uint8_t paramPageGate5[] = { kParamGate5Run, kParamGate5Length, kParamGate5Direction, kParamGate5ClockDiv, kParamGate5Swing, kParamGate5SplitPoint, kParamGate5Section1Reps, kParamGate5Section2Reps, kParamGate5FillStart, 0 };
-static uint8_t paramPageGate6[] = { kParamGate6Run, kParamGate6Length, kParamGate6Direction, kParamGate6ClockDiv, kParamGate6Swing, kParamGate6SplitPoint, kParamGate6Section1Reps, kParamGate6Section2Reps, kParamGate6FillStart, 0 };
-
-static _NT_parameterPage pageArray[] = {
-    { .name = "Inputs", .numParams = 2, .params = paramPageInputs },
-    { .name = "Seq 1 Outs", .numParams = 6, .params = paramPageSeq1Out },
-    { .name = "Seq 2 Outs", .numParams = 6, .params = paramPageSeq2Out },
-    { .name = "Seq 3 Outs", .numParams = 6, .params = paramPageSeq3Out },
-    { .name = "Seq 1 Params", .numParams = 6, .params = paramPageSeq1Params },
-    { .name = "Seq 2 Params", .numParams = 6, .params = paramPageSeq2Params },
-    { .name = "Seq 3 Params", .numParams = 6, .params = paramPageSeq3Params },
-    { .name = "Gate Outs", .numParams = 13, .params = paramPageGateOuts },
-    { .name = "Trig Track 1", .numParams = 9, .params = paramPageGate1 },
-    { .name = "Trig Track 2", .numParams = 9, .params = paramPageGate2 },
-    { .name = "Trig Track 3", .numParams = 9, .params = paramPageGate3 },
-    { .name = "Trig Track 4", .numParams = 9, .params = paramPageGate4 },
-    { .name = "Trig Track 5", .numParams = 9, .params = paramPageGate5 },
-    { .name = "Trig Track 6", .numParams = 9, .params = paramPageGate6 }
-};
-
-static _NT_parameterPages pages = {
-    .numPages = 14,
-    .pages = pageArray
-};
-
-void calculateRequirements(_NT_algorithmRequirements& req, const int32_t*) {
-    req.numParameters = kNumParameters;
-    req.sram = sizeof(VSeq);
+// Write the current output levels over frames [fromFrame, toFrame): each planned
+// bus once, with the sum of its outputs
+void VSeq::renderOutputs(float* busFrames, int numFrames, int fromFrame, int toFrame) {
+    if (toFrame <= fromFrame) return;
+    
+    const OutputPlan& plan = outputPlan;
+    for (int entry = 0; entry < plan.numBuses; entry++) {
+        float level = 0.0f;
+        for (int i = plan.first[entry]; i < plan.first[entry + 1]; i++) {
+            level += outputLevel(plan.writers[i]);
+        }
+        
+        float* outBus = busFrames + (plan.bus[entry] * numFrames);
+        if (plan.replace[entry]) {
+            for (int frame = fromFrame; frame < toFrame; frame++) {
+                outBus[frame] = level;
+            }
+        } else {
+            for (int frame = fromFrame; frame < toFrame; frame++) {
+                outBus[frame] += level;
+            }
+        }
+    }
 }
 
-_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t*) {
-    VSeq* alg = new (ptrs.sram) VSeq();
-    initParameters();
-    alg->parameters = parameters;
-    alg->parameterPages = &pages;
-    
-    // Initialize debug output bus array from default parameter values
-    for (int i = 0; i < 12; i++) {
-        alg->debugOutputBus[i] = parameters[kParamSeq1Out1 + i].def;
+// Scan an input bus for rising edges and schedule an event at each edge's frame.
+// Returns the frame of the last edge, or -1 if there was none.
+static inline int scheduleEdges(VSeq* a, const float* busFrames, int bus, int numFrames,
+                                float& lastIn, uint8_t type) {
+    if (bus < 0 || bus >= 28) {
+        lastIn = 0.0f;
+        return -1;
     }
-    
-    return alg;
+    const float* in = busFrames + (bus * numFrames);
+    float last = lastIn;
+    int lastEdge = -1;
+    for (int frame = 0; frame < numFrames; frame++) {
+        float x = in[frame];
+        if (x > 0.5f && last <= 0.5f) {
+            a->schedule(a->sampleTime + frame, type, 0);
+            lastEdge = frame;
+        }
+        last = x;
+    }
+    lastIn = last;
+    return lastEdge;
 }
 
 void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     VSeq* a = (VSeq*)self;
     
     // Get input bus indices from parameters
-    int clockBus = self->v[kParamClockIn] - 1;  // 0-27 (parameter is 1-28)
-    int resetBus = self->v[kParamResetIn] - 1;
+    int clockBus = a->param(kParamClockIn) - 1;  // 0-27 (parameter is 1-28)
+    int resetBus = a->param(kParamResetIn) - 1;
     
     // Calculate number of actual frames
     int numFrames = numFramesBy4 * 4;
+    uint32_t blockEnd = a->sampleTime + numFrames;
     
-    // Get first sample from each input bus (for edge detection)
-    float clockIn = (clockBus >= 0 && clockBus < 28) ? busFrames[clockBus * numFrames] : 0.0f;
-    float resetIn = (resetBus >= 0 && resetBus < 28) ? busFrames[resetBus * numFrames] : 0.0f;
-    
-    // Clock edge detection (rising edge)
-    bool clockTrig = (clockIn > 0.5f && a->lastClockIn <= 0.5f);
-    bool resetTrig = (resetIn > 0.5f && a->lastResetIn <= 0.5f);
-    
-    a->lastClockIn = clockIn;
-    a->lastResetIn = resetIn;
-    
-    // Process each CV sequencer (3 total)
-    for (int seq = 0; seq < 3; seq++) {
-        int divParam = kParamSeq1ClockDiv + (seq * 6);
-        int dirParam = kParamSeq1Direction + (seq * 6);
-        int stepParam = kParamSeq1StepCount + (seq * 6);
-        int splitParam = kParamSeq1SplitPoint + (seq * 6);
-        int sec1Param = kParamSeq1Section1Reps + (seq * 6);
-        int sec2Param = kParamSeq1Section2Reps + (seq * 6);
-        
-        int clockDiv = self->v[divParam];   // 0-30: /16 to /2, x1 to x16
-        int direction = self->v[dirParam];  // 0=Forward, 1=Backward, 2=Pingpong
-        int stepCount = self->v[stepParam]; // 1-32
-        int splitPoint = self->v[splitParam]; // 1-31
-        int sec1Reps = self->v[sec1Param];  // 1-99
-        int sec2Reps = self->v[sec2Param];  // 1-99
-        
-        // Map clockDiv parameter to actual divisor/multiplier
-        // 0-14: divisions (/16, /15, /14, /13, /12, /11, /10, /9, /8, /7, /6, /5, /4, /3, /2)
-        // 15-30: multiplications (x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16)
-        int divisor = 1;
-        int multiplier = 1;
-        bool isDivision = (clockDiv < 15);
-        
-        if (isDivision) {
-            divisor = 16 - clockDiv;  // 0->16, 1->15, 2->14, ..., 14->2
-        } else {
-            multiplier = clockDiv - 14;  // 15->1, 16->2, 17->3, ..., 30->16
-        }
-        
-        // Reset handling
-        if (resetTrig) {
-            a->resetSequencer(seq);
-            a->clockCounter[seq] = 0;
-            a->internalClockCounter[seq] = 0;
-            a->samplesSinceLastClock[seq] = 0;
-        }
-        
-        // Track samples for multiplication modes
-        a->samplesSinceLastClock[seq] += numFrames;
-        
-        // Clock handling with division/multiplication
-        bool seqStepped = false;
-        if (clockTrig) {
-            // Measure clock period for multiplication
-            if (a->samplesSinceLastClock[seq] > 100 && a->samplesSinceLastClock[seq] < 96000) {
-                a->lastClockPeriod[seq] = a->samplesSinceLastClock[seq];
-            }
-            a->samplesSinceLastClock[seq] = 0;
-            a->internalClockCounter[seq] = 0;
-            
-            if (isDivision) {
-                // Division mode: count clocks before advancing
-                a->clockCounter[seq]++;
-                if (a->clockCounter[seq] >= divisor) {
-                    a->clockCounter[seq] = 0;
-                    a->advanceSequencer(seq, direction, stepCount, splitPoint, sec1Reps, sec2Reps);
-                    seqStepped = true;
-                }
-            } else {
-                // Multiplication mode: step on external clock
-                a->advanceSequencer(seq, direction, stepCount, splitPoint, sec1Reps, sec2Reps);
-                seqStepped = true;
-            }
-        }
-        
-        // Internal clock multiplication - generate additional steps between external clocks
-        if (!isDivision && multiplier > 1 && !clockTrig && a->lastClockPeriod[seq] > 0) {
-            int subdivisionPeriod = a->lastClockPeriod[seq] / multiplier;
-            
-            if (subdivisionPeriod > numFrames && a->samplesSinceLastClock[seq] >= subdivisionPeriod * (a->internalClockCounter[seq] + 1)) {
-                a->internalClockCounter[seq]++;
-                if (a->internalClockCounter[seq] < multiplier) {
-                    a->advanceSequencer(seq, direction, stepCount, splitPoint, sec1Reps, sec2Reps);
-                    seqStepped = true;
-                }
-            }
-        }
-        
-        // Clamp current step to step count (safety check)
-        if (a->currentStep[seq] >= stepCount) {
-            a->currentStep[seq] = stepCount - 1;
+    // Pick up step edits published by the UI since the last block, then a preset load
+    a->applyEdits();
+    a->applyLoad();
+    
+    // Euclidean tracks whose parameters changed since the last block
+    uint32_t dirty = __atomic_exchange_n(&a->euclidDirty, 0u, __ATOMIC_ACQUIRE);
+    for (; dirty; dirty &= dirty - 1) {
+        a->regenerate(__builtin_ctz(dirty));
+    }
+    
+    // Turing Flip CV: one mean per block is plenty for a probability
+    for (int seq = 0; seq < a->numSeqs; seq++) {
+        int flipBus = a->param(seqParam(seq, kParamSeq1TmFlipCv)) - 1;
+        if (flipBus < 0 || !a->turing(seq)) {
+            a->seqs[seq].tmFlipCv = 0.0f;
+            continue;
         }
-        
-        // Output current step values to all output buses
-        int step = a->currentStep[seq];
-        for (int out = 0; out < 3; out++) {
-            int paramIdx = kParamSeq1Out1 + (seq * 3) + out;
-            int outputBus = self->v[paramIdx];  // 0 = none, 1-28 = bus 0-27
-            
-            // Store actual bus assignment for debug
-            int debugIdx = seq * 3 + out;
-            a->debugOutputBus[debugIdx] = outputBus;  // Store as 0-28
-            
-            if (outputBus > 0 && outputBus <= 28) {
-                int16_t value = a->stepValues[seq][step][out];
-                // Convert from int16_t range (-32768 to 32767) to voltage (0.0V to 10.0V)
-                float outputValue = ((value + 32768) / 65535.0f) * 10.0f;
-                
-                // Write to all frames in the output bus
-                float* outBus = busFrames + ((outputBus - 1) * numFrames);
-                for (int frame = 0; frame < numFrames; frame++) {
-                    outBus[frame] = outputValue;
-                }
-            }
-            
-            // Send MIDI note if channel is configured and sequencer just stepped
-            if (seqStepped) {
-                int midiParam = kParamSeq1Midi1 + (seq * 3) + out;
-                int midiChannel = self->v[midiParam];  // 0 = off, 1-16 = MIDI channels
-                
-                if (midiChannel > 0 && midiChannel <= 16) {
-                    // Convert CV value to MIDI note (0-127)
-                    int16_t value = a->stepValues[seq][step][out];
-                    float normalized = (value + 32768) / 65535.0f;  // 0.0-1.0
-                    uint8_t midiNote = (uint8_t)(normalized * 127.0f);
-                    if (midiNote > 127) midiNote = 127;
-                    
-                    uint8_t channel = (midiChannel - 1) & 0x0F;
-                    
-                    // Send note on
-                    NT_sendMidi3ByteMessage(
-                        kNT_destinationInternal,
-                        0x90 | channel,  // Note On
-                        midiNote,
-                        100              // Fixed velocity
-                    );
-                }
-            }
+        const float* in = busFrames + (flipBus * numFrames);
+        float sum = 0.0f;
+        for (int i = 0; i < numFrames; i++) sum += in[i];
+        a->seqs[seq].tmFlipCv = sum / numFrames;
+    }
+    
+    // Modulation inputs, read before anything this block plays
+    a->applyModulation(busFrames, numFrames);
+    
+    int clockSource = a->param(kParamClockSource);      // 0=CV, 1=MIDI, 2=CV+MIDI
+    int internalMode = a->param(kParamInternalClock);   // 0=Off, 1=Auto, 2=On
+    bool externalEnabled = (internalMode != 2);
+    
+    // Schedule clock and reset edges at their exact frames
+    // (inputs are scanned before any output is written, since they may share a bus)
+    scheduleEdges(a, busFrames, resetBus, numFrames, a->lastResetIn, kEvtReset);
+    int lastExternal = -1;
+    if (clockSource != 1 && externalEnabled) {
+        lastExternal = scheduleEdges(a, busFrames, clockBus, numFrames, a->lastClockIn, kEvtClock);
+    }
+    
+    // MIDI clock pulses received since the last block (always drained, only used if
+    // selected and the MIDI transport is running)
+    int pulseFrames[8];
+    int numPulses = a->midiClock.process(numFrames, pulseFrames, 8);
+    if (clockSource != 0 && externalEnabled && a->transportRunning) {
+        for (int i = 0; i < numPulses; i++) {
+            a->schedule(a->sampleTime + pulseFrames[i], kEvtClock, 0, kClockFromMidi);
+            if (pulseFrames[i] > lastExternal) lastExternal = pulseFrames[i];
         }
     }
     
-    // Process gate sequencer (6 tracks)
-    for (int track = 0; track < 6; track++) {
-        int outParam = kParamGate1Out + (track * 2);   // Gate outputs are now paired with CC params
-        int runParam = kParamGate1Run + (track * 9);   // 9 params per track now
-        int lenParam = kParamGate1Length + (track * 9);
-        int dirParam = kParamGate1Direction + (track * 9);
-        int divParam = kParamGate1ClockDiv + (track * 9);
-        int swingParam = kParamGate1Swing + (track * 9);
-        int splitParam = kParamGate1SplitPoint + (track * 9);
-        int sec1Param = kParamGate1Section1Reps + (track * 9);
-        int sec2Param = kParamGate1Section2Reps + (track * 9);
-        int fillParam = kParamGate1FillStart + (track * 9);
-        
-        int outputBus = self->v[outParam];     // 0 = none, 1-28 = bus 0-27
-        int isRunning = self->v[runParam];     // 0 = stopped, 1 = running
-        int trackLength = self->v[lenParam];   // 1-32
-        int direction = self->v[dirParam];     // 0=Forward, 1=Backward, 2=Pingpong
-        int clockDiv = self->v[divParam];      // 0-30: /16 to /2, x1 to x16
-        int swing = self->v[swingParam];       // 0-100 (percentage of swing delay)
-        int splitPoint = self->v[splitParam];  // 0-31 (0 = no split)
-        int sec1Reps = self->v[sec1Param];     // 1-99
-        int sec2Reps = self->v[sec2Param];     // 1-99
-        int fillStart = self->v[fillParam];    // 1-32 (step where fill replaces section 1 on last rep)
-        
-        // Map clockDiv parameter to actual divisor/multiplier
-        int gateDivisor = 1;
-        int gateMultiplier = 1;
-        bool gateIsDivision = (clockDiv < 15);
-        
-        if (gateIsDivision) {
-            gateDivisor = 16 - clockDiv;  // 0->16, 1->15, 2->14, ..., 14->2
+    if (lastExternal >= 0) {
+        a->lastExternalTime = a->sampleTime + lastExternal;
+        a->externalSeen = true;
+    }
+    
+    // Internal clock: always when On; when Auto, from the moment the external clock
+    // has been missing for "Takeover" periods (or has never arrived) until it returns
+    bool useInternal = (internalMode == 2);
+    int firstFrame = 0;
+    if (internalMode == 1 && lastExternal < 0) {
+        if (a->internalClock.active || !a->externalSeen) {
+            useInternal = true;
         } else {
-            gateMultiplier = clockDiv - 14;  // 15->1, 16->2, 17->3, ..., 30->16
-        }
-        
-        // Skip sequencer advancement if not running
-        if (isRunning == 0) continue;
-        
-        // Reset handling
-        if (resetTrig) {
-            a->gateCurrentStep[track] = 0;
-            a->gatePingpongForward[track] = true;
-            a->gateSwingCounter[track] = 0;
-            a->gateSection1Counter[track] = 0;
-            a->gateSection2Counter[track] = 0;
-            a->gateInSection2[track] = false;
-            a->gateInFill[track] = false;
-            a->gateClockCounter[track] = 0;
-            a->gateInternalClockCounter[track] = 0;
-            a->gateSamplesSinceLastClock[track] = 0;
-        }
-        
-        // Track samples for multiplication modes
-        a->gateSamplesSinceLastClock[track] += numFrames;
-        
-        // Clock handling with division/multiplication
-        bool gateStepped = false;
-        if (clockTrig) {
-            // Measure clock period for multiplication
-            if (a->gateSamplesSinceLastClock[track] > 100 && a->gateSamplesSinceLastClock[track] < 96000) {
-                a->gateLastClockPeriod[track] = a->gateSamplesSinceLastClock[track];
-            }
-            a->gateSamplesSinceLastClock[track] = 0;
-            a->gateInternalClockCounter[track] = 0;
-            
-            if (gateIsDivision) {
-                // Division mode: count clocks before advancing
-                a->gateClockCounter[track]++;
-                if (a->gateClockCounter[track] >= gateDivisor) {
-                    a->gateClockCounter[track] = 0;
-                    a->advanceGateSequencer(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
-                    gateStepped = true;
-                }
-            } else {
-                // Multiplication mode: step on external clock
-                a->advanceGateSequencer(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
-                gateStepped = true;
+            uint32_t deadline = a->lastExternalTime + (uint32_t)(a->param(kParamTakeover) * a->clockPeriod);
+            if ((int32_t)(blockEnd - deadline) > 0) {
+                useInternal = true;
+                firstFrame = (int32_t)(deadline - a->sampleTime) > 0 ? (int)(deadline - a->sampleTime) : 0;
             }
         }
-        
-        // Internal clock multiplication - generate additional steps between external clocks
-        if (!gateIsDivision && gateMultiplier > 1 && !clockTrig && a->gateLastClockPeriod[track] > 0) {
-            int subdivisionPeriod = a->gateLastClockPeriod[track] / gateMultiplier;
-            
-            if (subdivisionPeriod > numFrames && a->gateSamplesSinceLastClock[track] >= subdivisionPeriod * (a->gateInternalClockCounter[track] + 1)) {
-                a->gateInternalClockCounter[track]++;
-                if (a->gateInternalClockCounter[track] < gateMultiplier) {
-                    a->advanceGateSequencer(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
-                    gateStepped = true;
-                }
-            }
+    }
+    if (useInternal) {
+        if (!a->internalClock.active) {
+            a->internalClock.startAt(firstFrame, a->param(kParamBpm), a->param(kParamPpqn));
         }
-        
-        // After potential advancement, mark if current step should trigger
-        if (gateStepped) {  // Only trigger when we actually stepped
-            int currentStep = a->gateCurrentStep[track];
-            if (currentStep >= 0 && currentStep < 32 && a->gateSteps[track][currentStep]) {
-                // Apply swing: delay odd-numbered steps
-                bool isOddStep = (currentStep % 2) == 1;
-                int swingDelay = 0;
-                
-                if (isOddStep && swing > 0 && a->gateLastClockPeriod[track] > 0) {
-                    // Swing delays the trigger by a percentage of half the clock period
-                    // swing=100 = delay by 50% of clock period (triplet feel)
-                    // swing=0 = no delay (straight)
-                    swingDelay = (a->gateLastClockPeriod[track] * swing) / 200;  // divide by 200 = (100 * 2)
-                }
-                
-                // If no swing delay, trigger immediately
-                if (swingDelay == 0) {
-                    a->gateTriggerCounter[track] = 240;  // ~5ms at 48kHz
-                    
-                    // Send MIDI CC if configured
-                    int triggerMidiChannel = self->v[kParamTriggerMidiChannel];  // 0 = off, 1-16 = MIDI channels
-                    
-                    if (triggerMidiChannel > 0 && triggerMidiChannel <= 16) {
-                        int ccParam = kParamGate1CC + (track * 2);
-                        int ccNumber = self->v[ccParam];  // 0-127
-                        
-                        uint8_t channel = (triggerMidiChannel - 1) & 0x0F;
-                        
-                        // Send CC value 127 when trigger fires
-                        NT_sendMidi3ByteMessage(
-                            kNT_destinationInternal,
-                            0xB0 | channel, // CC message on configured channel
-                            ccNumber,       // CC number
-                            127             // CC value (full on)
-                        );
-                    }
-                } else {
-                    // Set swing counter to delay the trigger
-                    a->gateSwingCounter[track] = swingDelay;
-                }
-            }
+        int numInternal = a->internalClock.process(numFrames, a->param(kParamBpm), a->param(kParamPpqn),
+                                                   pulseFrames, 8);
+        for (int i = 0; i < numInternal; i++) {
+            a->schedule(a->sampleTime + pulseFrames[i], kEvtClock, 0, kClockFromInternal);
         }
-        
-        // Handle swing delay countdown
-        if (a->gateSwingCounter[track] > 0) {
-            a->gateSwingCounter[track] -= numFrames;
-            if (a->gateSwingCounter[track] <= 0) {
-                a->gateSwingCounter[track] = 0;
-                // Trigger now after swing delay
-                a->gateTriggerCounter[track] = 240;  // ~5ms at 48kHz
-                
-                // Send MIDI CC if configured
-                int triggerMidiChannel = self->v[kParamTriggerMidiChannel];
-                
-                if (triggerMidiChannel > 0 && triggerMidiChannel <= 16) {
-                    int ccParam = kParamGate1CC + (track * 2);
-                    int ccNumber = self->v[ccParam];
-                    
-                    uint8_t channel = (triggerMidiChannel - 1) & 0x0F;
-                    
-                    NT_sendMidi3ByteMessage(
-                        kNT_destinationInternal,
-                        0xB0 | channel,
-                        ccNumber,
-                        127
-                    );
-                }
-            }
+    }
+    a->internalClock.active = useInternal;
+    
+    // Release notes whose MIDI channel was changed or switched off while sounding
+    for (int out = 0; out < a->numSeqs * a->numOuts; out++) {
+        if (a->voices[out].note < 0) continue;
+        int midiChannel = a->param(seqOutParam(out / a->numOuts, out % a->numOuts, kParamSeq1Midi1));
+        if (midiChannel < 1 || midiChannel > 16 || (midiChannel - 1) != a->voices[out].channel) {
+            a->releaseVoice(out);
         }
-        
-        // Countdown trigger pulses every buffer
-        if (a->gateTriggerCounter[track] > 0) {
-            a->gateTriggerCounter[track] -= numFrames;  // Countdown by buffer size
-            if (a->gateTriggerCounter[track] < 0) {
-                a->gateTriggerCounter[track] = 0;
-            }
+    }
+    
+    // Clamp current step to step count (step count may have been lowered)
+    for (int seq = 0; seq < a->numSeqs; seq++) {
+        int stepCount = a->played(seqParam(seq, kParamSeq1StepCount));
+        if (a->seqs[seq].currentStep >= stepCount) {
+            a->seqs[seq].currentStep = stepCount - 1;
         }
+    }
+    
+    // Which outputs write which bus this block
+    a->planOutputs();
+    
+    // Drain events due in this block, rendering outputs up to each event's frame
+    int frame = 0;
+    while (a->events.dueBefore(blockEnd)) {
+        SeqEvent e = a->events.top();
+        a->events.pop();
         
-        // Output trigger pulse
-        if (outputBus > 0 && outputBus <= 28) {
-            bool triggerActive = a->gateTriggerCounter[track] > 0;
-            
-            // Write to all frames in the output bus
-            float* outBus = busFrames + ((outputBus - 1) * numFrames);
-            for (int frame = 0; frame < numFrames; frame++) {
-                outBus[frame] = triggerActive ? 5.0f : 0.0f;  // 5V trigger
-            }
+        int eventFrame = (int)(e.time - a->sampleTime);
+        if (eventFrame > frame) {
+            a->renderOutputs(busFrames, numFrames, frame, eventFrame);
+            frame = eventFrame;
         }
+        a->dispatchEvent(e);
     }
+    a->renderOutputs(busFrames, numFrames, frame, numFrames);
+    
+    a->sampleTime = blockEnd;
 }
 
 bool draw(_NT_algorithm* self) {
@@ -1297,31 +3498,53 @@ bool draw(_NT_algorithm* self) {
     // Clear screen
     NT_drawShapeI(kNT_rectangle, 0, 0, 256, 64, 0);  // Black background
     
-    int seq = a->selectedSeq;  // 0-2 for CV, 3 for gate
+    int seq = a->selectedSeq;  // 0 to numSeqs-1 for CV, numSeqs for gate
+    
+    // One page bar per view: the CV sequencers, then the gate sequencer
+    int numViews = a->numSeqs + ((a->numTracks > 0) ? 1 : 0);
     
-    // If seq 3 (4th sequencer), draw gate sequencer instead
-    if (seq == 3) {
+    // If the view after the CV sequencers, draw gate sequencer instead
+    if (seq == a->numSeqs) {
         // Show track and step info
         char info[32];
         snprintf(info, sizeof(info), "T%d S%d", a->selectedTrack + 1, a->selectedStep + 1);
         NT_drawText(0, 0, info, 255);
         
         // Show gate state for current selection
-        bool currentGateState = a->gateSteps[a->selectedTrack][a->selectedStep];
+        bool currentGateState = a->gateOn(a->selectedTrack, a->selectedStep);
         NT_drawText(60, 0, currentGateState ? "ON" : "off", currentGateState ? 255 : 100);
         
+        // Playing gate pattern
+        char patternText[16];
+        snprintf(patternText, sizeof(patternText), "P%d", a->activePattern[kGateSlot] + 1);
+        NT_drawText(90, 0, patternText, 255);
+        
+        // Longer patterns: the grid shows the 32-step page holding the selected step
+        int gridPage = a->selectedStep / kPageSteps;
+        int numGridPages = (a->maxSteps + kPageSteps - 1) / kPageSteps;
+        if (numGridPages > 1) {
+            char pageText[24];  // Two ints and a slash
+            snprintf(pageText, sizeof(pageText), "%d/%d", gridPage + 1, numGridPages);
+            NT_drawText(120, 0, pageText, 128);
+        }
+        
+        // Selected track is playing a transformed view (Button 4 commits it)
+        if (a->transformActive(kGateSlot + a->selectedTrack)) {
+            NT_drawText(200, 0, "XFORM", 200);
+        }
+        
         // Draw page indicators at top - same as CV sequencers
-        // 4 lines representing the 4 sequencer pages (CV1, CV2, CV3, Gate)
+        // One line per sequencer page (CV1, CV2, CV3, Gate by default)
         int pageBarY = 4;
-        int pageBarWidth = 64;  // 256px / 4 = 64px per sequencer
-        for (int i = 0; i < 4; i++) {
+        int pageBarWidth = 256 / numViews;  // 64px per sequencer by default
+        for (int i = 0; i < numViews; i++) {
             int barStartX = (i * pageBarWidth) + 4;
             int barEndX = ((i + 1) * pageBarWidth) - 4;
             int brightness = (i == seq) ? 255 : 80;  // Bright if current page, dim otherwise
             NT_drawShapeI(kNT_line, barStartX, pageBarY, barEndX, pageBarY, brightness);
         }
         
-        // 6 tracks × 32 steps
+        // Up to 6 tracks × 32 steps (one grid page)
         // Screen: 256px wide, 64px tall
         // Step size: 256/32 = 8px per step
         // Track height: (64-8)/6 = ~9px per track (leave 8px for title)
@@ -1330,15 +3553,15 @@ bool draw(_NT_algorithm* self) {
         int trackHeight = 9;
         int startY = 8;
         
-        for (int track = 0; track < 6; track++) {
+        for (int track = 0; track < a->numTracks; track++) {
             int y = startY + (track * trackHeight);
             
             // Get track parameters (now 9 params per track, not 10)
             int lenParam = kParamGate1Length + (track * 9);
             int splitParam = kParamGate1SplitPoint + (track * 9);
-            int trackLength = self->v[lenParam];
-            int splitPoint = self->v[splitParam];
-            int currentStep = a->gateCurrentStep[track];
+            int trackLength = a->param(lenParam);
+            int splitPoint = a->param(splitParam);
+            int currentStep = a->gates[track].currentStep;
             
             // Highlight selected track with a line on the left
             if (track == a->selectedTrack) {
@@ -1346,14 +3569,16 @@ bool draw(_NT_algorithm* self) {
                 NT_drawShapeI(kNT_line, 1, y, 1, y + trackHeight - 1, 255);
             }
             
-            // Draw split point line if active
-            if (splitPoint > 0 && splitPoint < trackLength) {
-                int splitX = splitPoint * stepWidth;
+            // Draw split point line if active (and on this page)
+            int pageSplit = splitPoint - (gridPage * kPageSteps);
+            if (splitPoint > 0 && splitPoint < trackLength && pageSplit > 0 && pageSplit < kPageSteps) {
+                int splitX = pageSplit * stepWidth;
                 NT_drawShapeI(kNT_line, splitX, y, splitX, y + trackHeight - 1, 200);
             }
             
-            for (int step = 0; step < 32; step++) {
-                int x = step * stepWidth;
+            for (int i = 0; i < kPageSteps; i++) {
+                int step = (gridPage * kPageSteps) + i;
+                int x = i * stepWidth;
                 
                 // Determine if this step is active (within track length)
                 bool isActive = (step < trackLength);
@@ -1362,7 +3587,7 @@ bool draw(_NT_algorithm* self) {
                 if (!isActive) continue;  // Skip inactive steps entirely
                 
                 // Get gate state for this track/step
-                bool hasGate = a->gateSteps[track][step];
+                bool hasGate = a->gateOn(track, step);
                 
                 // Calculate center position
                 int centerX = x + (stepWidth / 2);
@@ -1370,8 +3595,14 @@ bool draw(_NT_algorithm* self) {
                 
                 // If gate is active, draw filled 5x5 square
                 if (hasGate) {
-                    // Draw filled 5x5 square (very obvious)
-                    NT_drawShapeI(kNT_rectangle, centerX - 2, centerY - 2, centerX + 2, centerY + 2, 255);
+                    // Draw filled 5x5 square (very obvious); unaccented hits of a
+                    // generated track with accents get a smaller 3x3 square
+                    int size = 2;
+                    if (a->generated(track) && a->param(kParamGate1EuclidAccent + (track * 3)) > 0 &&
+                        !a->gateAccent(track, step)) {
+                        size = 1;
+                    }
+                    NT_drawShapeI(kNT_rectangle, centerX - size, centerY - size, centerX + size, centerY + size, 255);
                 } else {
                     // Just draw center pixel for inactive steps
                     NT_drawShapeI(kNT_rectangle, centerX, centerY, centerX, centerY, 255);
@@ -1395,19 +3626,62 @@ bool draw(_NT_algorithm* self) {
         return true;  // Suppress default parameter drawing
     }
     
-    // Original CV sequencer view for seq 0-2
+    // Turing mode: the register instead of the steps
+    if (a->turing(seq)) {
+        char title[24];
+        snprintf(title, sizeof(title), "SEQ %d TM", seq + 1);
+        NT_drawText(0, 0, title, 255);
+        
+        // One cell per bit, newest (bit 0) on the left; bits outside the loop dimmed
+        int length = a->param(seqParam(seq, kParamSeq1TmLength));
+        uint32_t reg = a->seqs[seq].tmRegister;
+        for (int bit = 0; bit < 32; bit++) {
+            int x = bit * 8;
+            int brightness = (bit < length) ? 255 : 40;
+            if ((reg >> bit) & 1u) {
+                NT_drawShapeI(kNT_rectangle, x, 12, x + 5, 22, brightness);
+            } else {
+                NT_drawShapeI(kNT_box, x, 12, x + 5, 22, brightness / 2);
+            }
+        }
+        
+        // Current voltage of each output as a horizontal bar
+        for (int out = 0; out < a->numOuts; out++) {
+            int16_t value = a->cvValue(seq, 0, out);
+            int width = (int)(((value + 32768.0f) / 65535.0f) * 255.0f);
+            int y = 30 + (out * 10);
+            NT_drawShapeI(kNT_rectangle, 0, y, (width < 1) ? 1 : width, y + 5, 200);
+        }
+        return true;
+    }
+    
+    // Original CV sequencer view for the CV seqs
     // Get parameters for current sequencer
-    int stepParam = kParamSeq1StepCount + (seq * 6);
-    int splitParam = kParamSeq1SplitPoint + (seq * 6);
-    int stepCount = self->v[stepParam];
-    int splitPoint = self->v[splitParam];
+    int stepParam = seqParam(seq, kParamSeq1StepCount);
+    int splitParam = seqParam(seq, kParamSeq1SplitPoint);
+    int stepCount = a->param(stepParam);
+    int splitPoint = a->param(splitParam);
     
     // Draw step view
-    char title[16];
-    snprintf(title, sizeof(title), "SEQ %d", seq + 1);
+    char title[32];
+    snprintf(title, sizeof(title), "SEQ %d P%d", seq + 1, a->activePattern[seq] + 1);
     NT_drawText(0, 0, title, 255);
     
-    // Draw 32 steps in 2 rows of 16
+    // Sequencer is playing a transformed view (Button 4 commits it)
+    if (a->transformActive(seq)) {
+        NT_drawText(200, 0, "XFORM", 200);
+    }
+    
+    // Longer patterns: the grid shows the 32-step page holding the selected step
+    int gridPage = a->selectedStep / kPageSteps;
+    int numGridPages = (a->maxSteps + kPageSteps - 1) / kPageSteps;
+    if (numGridPages > 1) {
+        char pageText[24];  // Two ints and a slash
+        snprintf(pageText, sizeof(pageText), "%d/%d", gridPage + 1, numGridPages);
+        NT_drawText(120, 0, pageText, 128);
+    }
+    
+    // Draw 32 steps (one grid page) in 2 rows of 16
     // Each step gets 3 skinny bars for 3 outputs
     // Screen is 256 wide, divided into 2 rows of 16 steps
     
@@ -1420,9 +3694,11 @@ bool draw(_NT_algorithm* self) {
     int rowHeight = 26; // Height of each row
     int maxBarHeight = 22; // Maximum bar height
     
-    for (int step = 0; step < 32; step++) {
-        int row = step / 16;     // 0 or 1
-        int col = step % 16;     // 0-15
+    for (int i = 0; i < kPageSteps; i++) {
+        int step = (gridPage * kPageSteps) + i;
+        if (step >= a->maxSteps) break;
+        int row = i / 16;        // 0 or 1
+        int col = i % 16;        // 0-15
         
         int x = col * stepWidth;
         int y = startY + (row * rowHeight);
@@ -1431,9 +3707,9 @@ bool draw(_NT_algorithm* self) {
         bool isActive = (step < stepCount);
         int brightness = isActive ? 255 : 40;  // Dim inactive steps
         
-        // Draw 3 vertical bars for this step
-        for (int out = 0; out < 3; out++) {
-            int16_t value = a->stepValues[seq][step][out];
+        // Draw a vertical bar per output for this step
+        for (int out = 0; out < a->numOuts; out++) {
+            int16_t value = a->cvValue(seq, step, out);
             // Convert int16_t (-32768 to 32767) to 0.0-1.0
             float normalized = (value + 32768.0f) / 65535.0f;
             // Convert to bar height (1 to maxBarHeight pixels)
@@ -1449,7 +3725,7 @@ bool draw(_NT_algorithm* self) {
         }
         
         // Draw step indicator dot if this is the current step
-        if (step == a->currentStep[seq]) {
+        if (step == a->seqs[seq].currentStep) {
             // Draw more visible indicator above the step (2x2 box)
             int dotX = x + (barWidth + barSpacing);  // Above middle bar
             NT_drawShapeI(kNT_rectangle, dotX, y - 3, dotX + barWidth - 1, y - 2, 255);
@@ -1501,10 +3777,10 @@ bool draw(_NT_algorithm* self) {
     NT_drawShapeI(kNT_line, x3, separatorY2 - 3, x3, separatorY2, 128);
     
     // Draw page indicators at the very top (above step view)
-    // 4 bars representing 4 sequencers, centered above groups of 4 steps
+    // One bar per sequencer; by default 4 bars centered above groups of 4 steps
     int pageBarY = 4;  // Just below the top separator lines
-    int groupWidth = 4 * stepWidth;  // Width of 4 steps including gaps
-    for (int i = 0; i < 4; i++) {
+    int groupWidth = (16 * stepWidth) / numViews;  // Width of 4 steps including gaps by default
+    for (int i = 0; i < numViews; i++) {
         int barStartX = (i * groupWidth) + (stepGap / 2);
         int barEndX = ((i + 1) * groupWidth) - (stepGap / 2) - stepGap;
         int brightness = (i == seq) ? 255 : 80;  // Bright if active, dim otherwise
@@ -1526,32 +3802,36 @@ uint32_t hasCustomUi(_NT_algorithm* self) {
 void customUi(_NT_algorithm* self, const _NT_uiData& data) {
     VSeq* a = (VSeq*)self;
     
-    // Left encoder: select sequencer (0-2 for CV, 3 for gate)
+    // Button 4: commit the transforms of the sequencer (or gate track) on screen
+    // into its playing pattern
+    if ((data.controls & kNT_button4) && !(a->lastButton4State & kNT_button4)) {
+        a->commitTransform(a->selectedSeq < a->numSeqs ? a->selectedSeq : kGateSlot + a->selectedTrack);
+    }
+    a->lastButton4State = data.controls;
+    
+    // Left encoder: select sequencer (CV seqs, then the gate sequencer if there are tracks)
     if (data.encoders[0] != 0) {
         int delta = data.encoders[0];
         int oldSeq = a->selectedSeq;
+        int lastView = (a->numTracks > 0) ? a->numSeqs : a->numSeqs - 1;
         a->selectedSeq += delta;
-        // Clamp to 0-3 range (no wraparound)
+        // Clamp to the views there are (no wraparound)
         if (a->selectedSeq < 0) a->selectedSeq = 0;
-        if (a->selectedSeq > 3) a->selectedSeq = 3;
+        if (a->selectedSeq > lastView) a->selectedSeq = lastView;
         
         // If sequencer changed, clamp selectedStep to new sequencer's length
         if (a->selectedSeq != oldSeq) {
             // Determine new sequencer's length
             int newLength;
-            if (a->selectedSeq == 3) {
+            if (a->selectedSeq == a->numSeqs) {
                 // Gate sequencer - get current track's length (9 params per track now)
                 int lenParam = kParamGate1Length + (a->selectedTrack * 9);
-                newLength = self->v[lenParam];
+                newLength = a->param(lenParam);
                 // Reset track pot catch when entering gate sequencer
                 a->trackPotCaught = false;
             } else {
                 // CV sequencer - get step count
-                int lengthParam;
-                if (a->selectedSeq == 0) lengthParam = kParamSeq1StepCount;
-                else if (a->selectedSeq == 1) lengthParam = kParamSeq2StepCount;
-                else lengthParam = kParamSeq3StepCount;
-                newLength = self->v[lengthParam];
+                newLength = a->param(seqParam(a->selectedSeq, kParamSeq1StepCount));
             }
             
             // Clamp selectedStep to new length
@@ -1561,16 +3841,18 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         }
     }
     
-    // Gate sequencer mode (seq 3)
-    if (a->selectedSeq == 3) {
-        // Left pot: select track (0-5) with catch behavior
-        // Each track has a virtual position: track 0 = 0%, track 1 = 20%, ..., track 5 = 100%
+    // Gate sequencer mode (the view after the CV seqs)
+    if (a->selectedSeq == a->numSeqs) {
+        // Left pot: select track with catch behavior
+        // Each track has a virtual position spread over the pot: with 6 tracks,
+        // track 0 = 0%, track 1 = 20%, ..., track 5 = 100%
         // Pot must "catch" current track position before it can change tracks
         if (data.controls & kNT_potL) {
             float potValue = data.pots[0];
+            int lastTrack = a->numTracks - 1;
             
-            // Calculate virtual position for current track (0-5 maps to 0.0-1.0)
-            float trackPosition = a->selectedTrack / 5.0f;
+            // Calculate virtual position for current track (0.0-1.0)
+            float trackPosition = (lastTrack > 0) ? (float)a->selectedTrack / lastTrack : 0.0f;
             
             // Check if pot has caught the track position (within 5% tolerance)
             if (!a->trackPotCaught) {
@@ -1581,15 +3863,10 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
             
             // Only allow track changes when caught
             if (a->trackPotCaught) {
-                // Map pot to track with hysteresis to prevent flickering
-                // 0.00-0.10 = track 0, 0.10-0.30 = track 1, etc.
-                int newTrack;
-                if (potValue < 0.10f) newTrack = 0;
-                else if (potValue < 0.30f) newTrack = 1;
-                else if (potValue < 0.50f) newTrack = 2;
-                else if (potValue < 0.70f) newTrack = 3;
-                else if (potValue < 0.90f) newTrack = 4;
-                else newTrack = 5;
+                // Map pot to the nearest track position
+                // (6 tracks: 0.00-0.10 = track 0, 0.10-0.30 = track 1, etc.)
+                int newTrack = (int)((potValue * lastTrack) + 0.5f);
+                if (newTrack > lastTrack) newTrack = lastTrack;
                 
                 // If track changed, update selection and reset catch
                 if (newTrack != a->selectedTrack) {
@@ -1598,8 +3875,8 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
                     
                     // Clamp selected step to new track's length (9 params per track now)
                     int lenParam = kParamGate1Length + (a->selectedTrack * 9);
-                    if (a->selectedStep >= self->v[lenParam]) {
-                        a->selectedStep = self->v[lenParam] - 1;
+                    if (a->selectedStep >= a->param(lenParam)) {
+                        a->selectedStep = a->param(lenParam) - 1;
                     }
                 }
             }
@@ -1607,7 +3884,7 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         
         // Get current track length for encoder bounds (9 params per track now)
         int lenParam = kParamGate1Length + (a->selectedTrack * 9);
-        int trackLength = self->v[lenParam];  // 1-32
+        int trackLength = a->param(lenParam);  // 1 to maxSteps
         
         // Right encoder: select step (0 to trackLength-1)
         if (data.encoders[1] != 0) {
@@ -1623,13 +3900,24 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         uint16_t currentEncoderRButton = data.controls & kNT_encoderButtonR;
         uint16_t lastEncoderRButton = a->lastEncoderRButton & kNT_encoderButtonR;
         if (currentEncoderRButton && !lastEncoderRButton) {  // Rising edge
-            // Toggle the gate
+            // Toggle the gate (applied by step() at the next block)
+            // Edits the stored step behind the selected view step, so the view flips.
+            // A generated track is frozen first (its view is committed, which
+            // leaves the view and the stored steps the same), then the step flips.
             int track = a->selectedTrack;
-            int step = a->selectedStep;
-            a->gateSteps[track][step] = !a->gateSteps[track][step];
+            if (a->generated(track)) {
+                bool gate = a->gateOn(track, a->selectedStep);
+                if (a->commitTransform(kGateSlot + track)) {
+                    a->editLog.add(kEditGate, 0, a->activePattern[kGateSlot], a->selectedStep, track, gate ? 0 : 1);
+                }
+            } else {
+                int step = a->gateViewStep(track, a->selectedStep);
+                a->editLog.add(kEditGate, 0, a->activePattern[kGateSlot], step, track, a->gateStep(track, step) ? 0 : 1);
+            }
+            a->editLog.publish();
             
             // Force update by incrementing a counter to verify button is being pressed
-            a->selectedSeq = 3;  // Force redraw
+            a->selectedSeq = a->numSeqs;  // Force redraw
         }
         a->lastEncoderRButton = data.controls;
         
@@ -1643,16 +3931,11 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         return;  // Skip CV sequencer controls
     }
     
-    // CV Sequencer mode (seq 0-2)
+    // CV Sequencer mode
     
     // Get current sequencer's length
     int seq = a->selectedSeq;
-    int lengthParam;
-    if (seq == 0) lengthParam = kParamSeq1StepCount;
-    else if (seq == 1) lengthParam = kParamSeq2StepCount;
-    else lengthParam = kParamSeq3StepCount;
-    
-    int seqLength = self->v[lengthParam];  // 1-32
+    int seqLength = a->param(seqParam(seq, kParamSeq1StepCount));  // 1 to maxSteps
     
     // Right encoder: select step (0 to seqLength-1)
     if (data.encoders[1] != 0) {
@@ -1669,13 +3952,13 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         a->potCaught[2] = false;
     }
     
-    // Button 4: (currently unused - previously was ratchet/repeat mode cycling)
-    a->lastButton4State = data.controls;
-    
-    // Pots control the 3 values for the selected step with catch logic
+    // Pots control the 3 values for the selected step with catch logic.
+    // They edit the stored step behind the selected view step (the raw value,
+    // before any transpose/scale/offset).
+    int storedStep = a->cvViewStep(a->selectedSeq, a->selectedStep);
     if (data.controls & kNT_potL) {
         float potValue = data.pots[0];
-        int16_t currentValue = a->stepValues[a->selectedSeq][a->selectedStep][0];
+        int16_t currentValue = a->seqs[a->selectedSeq].stepValues[storedStep][0];
         float currentNormalized = (currentValue + 32768) / 65535.0f;
         
         // Check if pot has caught the current value (within 2% tolerance)
@@ -1687,13 +3970,15 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         
         // Only update if caught
         if (a->potCaught[0]) {
-            a->stepValues[a->selectedSeq][a->selectedStep][0] = (int16_t)((potValue * 65535.0f) - 32768);
+            a->editLog.add(kEditCvValue, a->selectedSeq, a->activePattern[a->selectedSeq], storedStep, 0,
+                           (int16_t)((potValue * 65535.0f) - 32768));
         }
     }
     
-    if (data.controls & kNT_potC) {
+    // Centre and right pots only where the seq has a 2nd and 3rd output
+    if ((data.controls & kNT_potC) && a->numOuts > 1) {
         float potValue = data.pots[1];
-        int16_t currentValue = a->stepValues[a->selectedSeq][a->selectedStep][1];
+        int16_t currentValue = a->seqs[a->selectedSeq].stepValues[storedStep][1];
         float currentNormalized = (currentValue + 32768) / 65535.0f;
         
         if (!a->potCaught[1]) {
@@ -1703,13 +3988,14 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         }
         
         if (a->potCaught[1]) {
-            a->stepValues[a->selectedSeq][a->selectedStep][1] = (int16_t)((potValue * 65535.0f) - 32768);
+            a->editLog.add(kEditCvValue, a->selectedSeq, a->activePattern[a->selectedSeq], storedStep, 1,
+                           (int16_t)((potValue * 65535.0f) - 32768));
         }
     }
     
-    if (data.controls & kNT_potR) {
+    if ((data.controls & kNT_potR) && a->numOuts > 2) {
         float potValue = data.pots[2];
-        int16_t currentValue = a->stepValues[a->selectedSeq][a->selectedStep][2];
+        int16_t currentValue = a->seqs[a->selectedSeq].stepValues[storedStep][2];
         float currentNormalized = (currentValue + 32768) / 65535.0f;
         
         if (!a->potCaught[2]) {
@@ -1719,9 +4005,13 @@ void customUi(_NT_algorithm* self, const _NT_uiData& data) {
         }
         
         if (a->potCaught[2]) {
-            a->stepValues[a->selectedSeq][a->selectedStep][2] = (int16_t)((potValue * 65535.0f) - 32768);
+            a->editLog.add(kEditCvValue, a->selectedSeq, a->activePattern[a->selectedSeq], storedStep, 2,
+                           (int16_t)((potValue * 65535.0f) - 32768));
         }
     }
+    
+    // All pot edits from this call reach step() together
+    a->editLog.publish();
 }
 
 void setupUi(_NT_algorithm* self, _NT_float3& pots) {
@@ -1730,8 +4020,10 @@ void setupUi(_NT_algorithm* self, _NT_float3& pots) {
     // Only update pot positions when step changes
     if (a->selectedStep != a->lastSelectedStep) {
         a->lastSelectedStep = a->selectedStep;
-        for (int i = 0; i < 3; i++) {
-            int16_t value = a->stepValues[a->selectedSeq][a->selectedStep][i];
+        if (a->selectedSeq >= a->numSeqs) return;  // Gate sequencer page has no step values
+        int storedStep = a->cvViewStep(a->selectedSeq, a->selectedStep);
+        for (int i = 0; i < a->numOuts; i++) {
+            int16_t value = a->seqs[a->selectedSeq].stepValues[storedStep][i];
             // Convert from int16_t to 0.0-1.0
             pots[i] = (value + 32768) / 65535.0f;
         }
@@ -1741,26 +4033,50 @@ void setupUi(_NT_algorithm* self, _NT_float3& pots) {
 void parameterChanged(_NT_algorithm* self, int parameterIndex) {
     VSeq* a = (VSeq*)self;
     
+    // Work in logical indices; the table only has this instance's parameters
+    int p = a->logicalParam[parameterIndex];
+    int seq = paramSeq[p];
+    int track = paramTrack[p];
+    
     // Update debug output bus tracking when output parameters change
-    if (parameterIndex >= kParamSeq1Out1 && parameterIndex <= kParamSeq3Out3) {
-        int debugIdx = parameterIndex - kParamSeq1Out1;
-        a->debugOutputBus[debugIdx] = self->v[parameterIndex];  // Store parameter value (1-28)
+    if (seq >= 0 && paramOut[p] >= 0 && p == seqOutParam(seq, paramOut[p], kParamSeq1Out1)) {
+        a->syncDebugOutputBus();
+    }
+    
+    // Scale or Root of an output changed: rebuild its quantizer table here, off the
+    // audio thread. step() may read it mid-build for one block; every entry is a
+    // valid note of the old or the new scale.
+    int out = paramOut[p];
+    if (seq >= 0 && out >= 0 && (p == seqOutParam(seq, out, kParamSeq1Scale1) || p == seqOutParam(seq, out, kParamSeq1Root1))) {
+        a->buildQuantTable(a->voice(seq, out), a->param(seqOutParam(seq, out, kParamSeq1Scale1)),
+                           a->param(seqOutParam(seq, out, kParamSeq1Root1)));
+    }
+    
+    // Groove template or User step changed: delays are rebuilt on the next trigger
+    if (p >= kParamGroove && p <= kParamGrooveStep16) {
+        a->grooveVersion++;
+    }
+    
+    // A committed view plays untransformed until its parameters are back at neutral
+    int view = -1;
+    if (seq >= 0 && p >= seqParam(seq, kParamSeq1Rotate) && p <= seqParam(seq, kParamSeq1ValueOffset)) {
+        view = seq;
+    } else if (p >= kParamGate1Rotate && p <= kParamGate6EuclidAccent) {
+        view = kGateSlot + track;
+    }
+    if (view >= 0 && !a->transformActive(view)) {
+        a->transformBypass &= ~(1 << view);
+    }
+    
+    // Euclid parameter or track Length changed: regenerate that track at the next block
+    if (track >= 0 && (p == kParamGate1Length + (track * 9) ||
+        (p >= kParamGate1EuclidHits + (track * 3) && p <= kParamGate1EuclidAccent + (track * 3)))) {
+        __atomic_fetch_or(&a->euclidDirty, 1u << track, __ATOMIC_RELEASE);
     }
     
     // Reset split/section parameters when step count changes
-    if (parameterIndex == kParamSeq1StepCount || 
-        parameterIndex == kParamSeq2StepCount ||
-        parameterIndex == kParamSeq3StepCount) {
-        
-        int seq = 0;
-        if (parameterIndex == kParamSeq1StepCount) seq = 0;
-        else if (parameterIndex == kParamSeq2StepCount) seq = 1;
-        else if (parameterIndex == kParamSeq3StepCount) seq = 2;
-        
-        int stepCount = self->v[parameterIndex];
-        int splitParam = kParamSeq1SplitPoint + (seq * 6);
-        int sec1Param = kParamSeq1Section1Reps + (seq * 6);
-        int sec2Param = kParamSeq1Section2Reps + (seq * 6);
+    if (seq >= 0 && p == seqParam(seq, kParamSeq1StepCount)) {
+        int stepCount = a->param(p);
         
         // Calculate new split point (middle of sequence)
         int newSplit = stepCount / 2;
@@ -1768,15 +4084,81 @@ void parameterChanged(_NT_algorithm* self, int parameterIndex) {
         if (newSplit >= stepCount) newSplit = stepCount - 1;
         
         // Reset parameters using NT_setParameterFromAudio
-        int32_t algoIdx = NT_algorithmIndex(self);
-        NT_setParameterFromAudio(algoIdx, splitParam + NT_parameterOffset(), newSplit);
-        NT_setParameterFromAudio(algoIdx, sec1Param + NT_parameterOffset(), 1);
-        NT_setParameterFromAudio(algoIdx, sec2Param + NT_parameterOffset(), 1);
+        a->setParameterFromAudio(seqParam(seq, kParamSeq1SplitPoint), newSplit);
+        a->setParameterFromAudio(seqParam(seq, kParamSeq1Section1Reps), 1);
+        a->setParameterFromAudio(seqParam(seq, kParamSeq1Section2Reps), 1);
         
         // Reset section counters
-        a->section1Counter[seq] = 0;
-        a->section2Counter[seq] = 0;
-        a->inSection2[seq] = false;
+        a->seqs[seq].section1Counter = 0;
+        a->seqs[seq].section2Counter = 0;
+        a->seqs[seq].inSection2 = false;
+    }
+}
+
+// Patterns are saved up to their last step that differs from a fresh one (the
+// test voltages for CV, off for gates), so a long instance with short patterns
+// saves and loads like a short one. On load the missing steps go back to fresh,
+// and steps past this instance's Max Steps are read and dropped, so the parse
+// stays in step with the preset.
+
+static void writeCvPattern(_NT_jsonStream& stream, const CvStep* cv, int seq, int maxSteps) {
+    int used = maxSteps;
+    while (used > 0 && cv[used - 1][0] == VSeq::initialStepValue(seq, 0) &&
+           cv[used - 1][1] == VSeq::initialStepValue(seq, 1) && cv[used - 1][2] == VSeq::initialStepValue(seq, 2)) {
+        used--;
+    }
+    stream.openArray();
+    for (int step = 0; step < used; step++) {
+        stream.openArray();
+        for (int out = 0; out < 3; out++) {
+            stream.addNumber((int)cv[step][out]);
+        }
+        stream.closeArray();
+    }
+    stream.closeArray();
+}
+
+static void writeGateTrack(_NT_jsonStream& stream, const bool* gate, int maxSteps) {
+    int used = maxSteps;
+    while (used > 0 && !gate[used - 1]) used--;
+    stream.openArray();
+    for (int step = 0; step < used; step++) {
+        stream.addNumber(gate[step] ? 1 : 0);
+    }
+    stream.closeArray();
+}
+
+static void readCvPattern(_NT_jsonParse& parse, CvStep* cv, int seq, int maxSteps) {
+    int numSteps = 0;
+    if (!parse.numberOfArrayElements(numSteps)) return;
+    for (int step = 0; step < numSteps; step++) {
+        int numOuts = 0;
+        if (!parse.numberOfArrayElements(numOuts)) continue;
+        for (int out = 0; out < numOuts; out++) {
+            int value;
+            if (parse.number(value) && step < maxSteps && out < 3) {
+                cv[step][out] = (int16_t)value;
+            }
+        }
+    }
+    for (int step = numSteps; step < maxSteps; step++) {
+        for (int out = 0; out < 3; out++) {
+            cv[step][out] = VSeq::initialStepValue(seq, out);
+        }
+    }
+}
+
+static void readGateTrack(_NT_jsonParse& parse, bool* gate, int maxSteps) {
+    int numSteps = 0;
+    if (!parse.numberOfArrayElements(numSteps)) return;
+    for (int step = 0; step < numSteps; step++) {
+        int value;
+        if (parse.number(value) && step < maxSteps) {
+            gate[step] = (value != 0);
+        }
+    }
+    for (int step = numSteps; step < maxSteps; step++) {
+        gate[step] = false;
     }
 }
 
@@ -1786,16 +4168,8 @@ void serialise(_NT_algorithm* self, _NT_jsonStream& stream) {
     // Save all step values as 3D array
     stream.addMemberName("stepValues");
     stream.openArray();
-    for (int seq = 0; seq < 3; seq++) {
-        stream.openArray();
-        for (int step = 0; step < 32; step++) {
-            stream.openArray();
-            for (int out = 0; out < 3; out++) {
-                stream.addNumber((int)a->stepValues[seq][step][out]);
-            }
-            stream.closeArray();
-        }
-        stream.closeArray();
+    for (int seq = 0; seq < a->numSeqs; seq++) {
+        writeCvPattern(stream, a->seqs[seq].stepValues, seq, a->maxSteps);
     }
     stream.closeArray();
     
@@ -1807,44 +4181,75 @@ void serialise(_NT_algorithm* self, _NT_jsonStream& stream) {
     }
     stream.closeArray();
     
-    // Save gate sequencer data (6 tracks × 32 steps)
+    // Save gate sequencer data (numTracks tracks × maxSteps steps)
     stream.addMemberName("gateSteps");
     stream.openArray();
-    for (int track = 0; track < 6; track++) {
+    for (int track = 0; track < a->numTracks; track++) {
+        writeGateTrack(stream, &a->gateStep(track, 0), a->maxSteps);
+    }
+    stream.closeArray();
+    
+    // Save the whole pattern banks (stepValues/gateSteps above are the playing
+    // patterns, kept so older versions still load the preset)
+    stream.addMemberName("cvPatterns");
+    stream.openArray();
+    for (int seq = 0; seq < a->numSeqs; seq++) {
+        stream.openArray();
+        for (int pattern = 0; pattern < kNumPatterns; pattern++) {
+            writeCvPattern(stream, a->bank.cvPattern(seq, pattern), seq, a->maxSteps);
+        }
+        stream.closeArray();
+    }
+    stream.closeArray();
+    
+    stream.addMemberName("gatePatterns");
+    stream.openArray();
+    for (int pattern = 0; pattern < kNumPatterns; pattern++) {
         stream.openArray();
-        for (int step = 0; step < 32; step++) {
-            stream.addNumber(a->gateSteps[track][step] ? 1 : 0);
+        for (int track = 0; track < a->numTracks; track++) {
+            writeGateTrack(stream, a->bank.gatePattern(pattern) + (track * a->maxSteps), a->maxSteps);
         }
         stream.closeArray();
     }
     stream.closeArray();
+    
+    // The CV seqs, then the gate sequencer last (so 3 seqs save as before)
+    stream.addMemberName("activePatterns");
+    stream.openArray();
+    for (int seq = 0; seq < a->numSeqs; seq++) {
+        stream.addNumber(a->activePattern[seq]);
+    }
+    stream.addNumber(a->activePattern[kGateSlot]);
+    stream.closeArray();
+    
+    // Turing registers, so a preset comes back playing the same loop
+    // (stored as int: the top bit round-trips as the sign)
+    stream.addMemberName("tmRegisters");
+    stream.openArray();
+    for (int seq = 0; seq < a->numSeqs; seq++) {
+        stream.addNumber((int)a->seqs[seq].tmRegister);
+    }
+    stream.closeArray();
 }
 
 bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
     VSeq* a = (VSeq*)self;
     
-    // Match "stepValues"
+    // Presets may come from an instance with more or fewer seqs/tracks: the ones
+    // this instance has are loaded, the others are read and dropped
+    
+    // Patterns go to the load bank; step() swaps it in (see beginLoad)
+    a->beginLoad();
+    
+    // Match "stepValues" (1 to 8 sequencer presets, 16 to 128 steps)
     if (parse.matchName("stepValues")) {
         int numSeqs = 0;
         if (parse.numberOfArrayElements(numSeqs)) {
-            // Support both 3 and 4 sequencer presets (backwards compatibility)
-            int seqsToLoad = (numSeqs < 3) ? numSeqs : 3;
-            for (int seq = 0; seq < seqsToLoad; seq++) {
-                int numSteps = 0;
-                if (parse.numberOfArrayElements(numSteps)) {
-                    // Support both 16 and 32 step presets
-                    int stepsToLoad = (numSteps < 32) ? numSteps : 32;
-                    for (int step = 0; step < stepsToLoad; step++) {
-                        int numOuts = 0;
-                        if (parse.numberOfArrayElements(numOuts) && numOuts == 3) {
-                            for (int out = 0; out < 3; out++) {
-                                int value;
-                                if (parse.number(value)) {
-                                    a->stepValues[seq][step][out] = (int16_t)value;
-                                }
-                            }
-                        }
-                    }
+            for (int seq = 0; seq < numSeqs; seq++) {
+                if (seq < a->numSeqs) {
+                    readCvPattern(parse, a->loadBank.cvPattern(seq, a->loadActive[seq]), seq, a->maxSteps);
+                } else {
+                    readCvPattern(parse, nullptr, seq, 0);
                 }
             }
         }
@@ -1867,15 +4272,50 @@ bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
     if (parse.matchName("gateSteps")) {
         int numTracks = 0;
         if (parse.numberOfArrayElements(numTracks)) {
-            int tracksToLoad = (numTracks < 6) ? numTracks : 6;
-            for (int track = 0; track < tracksToLoad; track++) {
-                int numSteps = 0;
-                if (parse.numberOfArrayElements(numSteps)) {
-                    int stepsToLoad = (numSteps < 32) ? numSteps : 32;
-                    for (int step = 0; step < stepsToLoad; step++) {
-                        int value;
-                        if (parse.number(value)) {
-                            a->gateSteps[track][step] = (value != 0);
+            for (int track = 0; track < numTracks; track++) {
+                if (track < a->numTracks) {
+                    readGateTrack(parse, a->loadBank.gatePattern(a->loadActive[kGateSlot]) + (track * a->maxSteps),
+                                  a->maxSteps);
+                } else {
+                    readGateTrack(parse, nullptr, 0);
+                }
+            }
+        }
+    }
+    
+    // Match "cvPatterns" (optional, presets saved before pattern banks only have stepValues)
+    if (parse.matchName("cvPatterns")) {
+        int numSeqs = 0;
+        if (parse.numberOfArrayElements(numSeqs)) {
+            for (int seq = 0; seq < numSeqs; seq++) {
+                int numPatterns = 0;
+                if (parse.numberOfArrayElements(numPatterns)) {
+                    int patternsToLoad = (numPatterns < kNumPatterns) ? numPatterns : kNumPatterns;
+                    for (int pattern = 0; pattern < patternsToLoad; pattern++) {
+                        if (seq < a->numSeqs) {
+                            readCvPattern(parse, a->loadBank.cvPattern(seq, pattern), seq, a->maxSteps);
+                        } else {
+                            readCvPattern(parse, nullptr, seq, 0);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    // Match "gatePatterns" (optional)
+    if (parse.matchName("gatePatterns")) {
+        int numPatterns = 0;
+        if (parse.numberOfArrayElements(numPatterns)) {
+            int patternsToLoad = (numPatterns < kNumPatterns) ? numPatterns : kNumPatterns;
+            for (int pattern = 0; pattern < patternsToLoad; pattern++) {
+                int numTracks = 0;
+                if (parse.numberOfArrayElements(numTracks)) {
+                    for (int track = 0; track < numTracks; track++) {
+                        if (track < a->numTracks) {
+                            readGateTrack(parse, a->loadBank.gatePattern(pattern) + (track * a->maxSteps), a->maxSteps);
+                        } else {
+                            readGateTrack(parse, nullptr, 0);
                         }
                     }
                 }
@@ -1883,24 +4323,97 @@ bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
         }
     }
     
+    // Match "activePatterns" (optional): the CV seqs, the gate sequencer last
+    if (parse.matchName("activePatterns")) {
+        int numSlots = 0;
+        if (parse.numberOfArrayElements(numSlots)) {
+            for (int slot = 0; slot < numSlots; slot++) {
+                int pattern;
+                int loadSlot = (slot == numSlots - 1) ? kGateSlot : slot;
+                if (parse.number(pattern) && pattern >= 0 && pattern < kNumPatterns && loadSlot <= kGateSlot) {
+                    a->loadActive[loadSlot] = pattern;
+                }
+            }
+        }
+    }
+    
+    // Match "tmRegisters" (optional)
+    if (parse.matchName("tmRegisters")) {
+        int numSeqs = 0;
+        if (parse.numberOfArrayElements(numSeqs)) {
+            for (int seq = 0; seq < numSeqs; seq++) {
+                int reg;
+                if (parse.number(reg) && seq < a->numSeqs) {
+                    a->loadTm[seq] = (uint32_t)reg;
+                    a->loadTmMask |= 1u << seq;
+                }
+            }
+        }
+    }
+    
+    a->endLoad();
+    
     // After deserialization, sync debug array from current parameter values
     // (in case parameters were loaded but custom data wasn't)
-    for (int i = 0; i < 12; i++) {
-        a->debugOutputBus[i] = self->v[kParamSeq1Out1 + i];
-    }
+    a->syncDebugOutputBus();
     
     return true;
 }
 
+void midiRealtime(_NT_algorithm* self, uint8_t byte) {
+    VSeq* a = (VSeq*)self;
+    
+    if (byte == 0xF8) {
+        a->midiClock.receiveTick();  // Timing clock (24 PPQN)
+        return;
+    }
+    
+    // Transport only applies when following MIDI clock
+    if (a->param(kParamClockSource) == 0) return;
+    
+    switch (byte) {
+        case 0xFA: a->transportStart(); break;
+        case 0xFB: a->transportContinue(); break;
+        case 0xFC: a->transportStop(); break;
+    }
+}
+
+void midiMessage(_NT_algorithm* self, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    VSeq* a = (VSeq*)self;
+    
+    // Song Position Pointer: 14-bit count of 16th notes since song start
+    if (byte0 == 0xF2 && a->param(kParamClockSource) != 0) {
+        uint32_t position = (byte1 & 0x7F) | ((uint32_t)(byte2 & 0x7F) << 7);
+        a->seekToPosition(position);
+    }
+}
+
 // Factory
 extern "C" {
 
+static const _NT_specification specifications[] = {
+    {
+        .name = "Max Steps",
+        .min = kMinSteps,
+        .max = kMaxSteps,
+        .def = kMinSteps,
+        .type = kNT_typeGeneric
+    },
+    {
+        .name = "Layout",
+        .min = 1,
+        .max = kNumLayouts,
+        .def = kDefaultLayout,
+        .type = kNT_typeGeneric
+    }
+};
+
 static const _NT_factory factory = {
     .guid = NT_MULTICHAR('V','S','E','Q'),
     .name = "VSeq",
     .description = "4-channel 16-step sequencer with clock/reset",
-    .numSpecifications = 0,
-    .specifications = NULL,
+    .numSpecifications = 2,
+    .specifications = specifications,
     .calculateStaticRequirements = NULL,
     .initialise = NULL,
     .calculateRequirements = calculateRequirements,
@@ -1908,8 +4421,8 @@ static const _NT_factory factory = {
     .parameterChanged = parameterChanged,
     .step = step,  // Note: step callback processes audio
     .draw = draw,
-    .midiRealtime = NULL,
-    .midiMessage = NULL,
+    .midiRealtime = midiRealtime,
+    .midiMessage = midiMessage,
     .tags = kNT_tagUtility,
     .hasCustomUi = hasCustomUi,
     .customUi = customUi,
@@ -0,0 +1,572 @@
+#include <distingnt/api.h>
+#include <cstdint>
+#include <iostream>
+
+// The real Song Position Pointer seek: LoopPlan and the loop builders
+#include "seq_common.h"
+
+// Simple test framework
+int totalTests = 0;
+int passedTests = 0;
+int failedTests = 0;
+
+#define EXPECT_EQ(actual, expected) do { \
+    totalTests++; \
+    if ((actual) != (expected)) { \
+        std::cout << "  FAIL: " << #actual << " == " << #expected << " (line " << __LINE__ << ")\n"; \
+        std::cout << "    Expected: " << (expected) << ", Got: " << (actual) << "\n"; \
+        failedTests++; \
+    } else { \
+        passedTests++; \
+    } \
+} while(0)
+
+#define TEST_F(fixture, name) void test_##fixture##_##name()
+
+class SeekTest {
+protected:
+    void SetUp() {}
+};
+
+// Every length from 1 step up to this is tried, with every split, fill and
+// first/last step that fits, so each branch of the walkers is hit
+static const int kTestLength = 16;
+static const int kTestReps = 3;
+
+// Playback state of one VSeq CV sequencer, VSeq gate track, VTrig track or
+// V3Seq, as the walkers below leave it. Starts in the reset state.
+// The walkers are copies of the ones in the plugins; keep them in sync, so a
+// change to a walker that the loop builders in seq_common.h do not follow
+// shows up here as a seek mismatch.
+struct Track {
+    int currentStep;
+    bool pingpongForward;
+    int section1Counter;
+    int section2Counter;
+    bool inSection2;
+    uint32_t passes;            // Wraps reported by walkTrack (VTrig trig conditions)
+    
+    Track() {
+        currentStep = 0;
+        pingpongForward = true;
+        section1Counter = 0;
+        section2Counter = 0;
+        inSection2 = false;
+        passes = 0;
+    }
+    
+    // Copy of VSeq::advanceSequencer (CV sequencers)
+    void advanceCv(int direction, int stepCount, int splitPoint, int sec1Reps, int sec2Reps) {
+        // If no sections (splitPoint >= stepCount), use simple wrapping logic
+        if (splitPoint >= stepCount) {
+            if (direction == 0) {
+                currentStep++;
+                if (currentStep >= stepCount) {
+                    currentStep = 0;
+                }
+            } else if (direction == 1) {
+                currentStep--;
+                if (currentStep < 0) {
+                    currentStep = stepCount - 1;
+                }
+            } else {
+                if (pingpongForward) {
+                    currentStep++;
+                    if (currentStep >= stepCount) {
+                        currentStep = stepCount - 1;
+                        pingpongForward = false;
+                    }
+                } else {
+                    currentStep--;
+                    if (currentStep < 0) {
+                        currentStep = 0;
+                        pingpongForward = true;
+                    }
+                }
+            }
+            return;
+        }
+        
+        if (direction == 0) {
+            currentStep++;
+            if (!inSection2) {
+                if (currentStep >= splitPoint) {
+                    section1Counter++;
+                    if (section1Counter >= sec1Reps) {
+                        inSection2 = true;
+                        section1Counter = 0;
+                    } else {
+                        currentStep = 0;
+                    }
+                }
+            } else {
+                if (currentStep >= stepCount) {
+                    section2Counter++;
+                    if (section2Counter >= sec2Reps) {
+                        inSection2 = false;
+                        section2Counter = 0;
+                        currentStep = 0;
+                    } else {
+                        currentStep = splitPoint;
+                    }
+                }
+            }
+        } else if (direction == 1) {
+            currentStep--;
+            if (inSection2) {
+                if (currentStep < splitPoint) {
+                    section2Counter++;
+                    if (section2Counter >= sec2Reps) {
+                        inSection2 = false;
+                        section2Counter = 0;
+                    } else {
+                        currentStep = stepCount - 1;
+                    }
+                }
+            } else {
+                if (currentStep < 0) {
+                    section1Counter++;
+                    if (section1Counter >= sec1Reps) {
+                        inSection2 = true;
+                        section1Counter = 0;
+                        currentStep = stepCount - 1;
+                    } else {
+                        currentStep = splitPoint - 1;
+                    }
+                }
+            }
+        } else {
+            // Pingpong (with sections only the last step plays twice)
+            if (pingpongForward) {
+                currentStep++;
+                if (currentStep >= stepCount) {
+                    currentStep = stepCount - 1;
+                    pingpongForward = false;
+                }
+            } else {
+                currentStep--;
+                if (currentStep <= 0) {
+                    currentStep = 0;
+                    pingpongForward = true;
+                }
+            }
+        }
+    }
+    
+    // Copy of VTrig::walkTrack. VSeq::advanceGateSequencer is the same walk
+    // without the wrap flag.
+    void walkTrack(int direction, int trackLength, int splitPoint,
+                   int sec1Reps, int sec2Reps, int fillStart) {
+        bool wrapped = false;
+        if (splitPoint >= trackLength) {
+            if (direction == 0) {
+                currentStep++;
+                if (currentStep >= trackLength) {
+                    currentStep = 0;
+                    wrapped = true;
+                }
+            } else if (direction == 1) {
+                currentStep--;
+                if (currentStep < 0) {
+                    currentStep = trackLength - 1;
+                    wrapped = true;
+                }
+            } else if (direction == 2) {
+                if (pingpongForward) {
+                    currentStep++;
+                    if (currentStep >= trackLength) {
+                        currentStep = trackLength - 2;
+                        if (currentStep < 0) currentStep = 0;
+                        pingpongForward = false;
+                        wrapped = true;
+                    }
+                } else {
+                    currentStep--;
+                    if (currentStep < 0) {
+                        currentStep = 1;
+                        if (currentStep >= trackLength) currentStep = trackLength - 1;
+                        pingpongForward = true;
+                        wrapped = true;
+                    }
+                }
+            }
+            if (wrapped) passes++;
+            return;
+        }
+        
+        int section1End = (splitPoint > 0 && splitPoint < trackLength) ? splitPoint : trackLength;
+        
+        if (direction == 0) {
+            currentStep++;
+            if (!inSection2 &&
+                splitPoint > 0 &&
+                splitPoint < trackLength &&
+                fillStart > 0 &&
+                fillStart < splitPoint &&
+                sec1Reps > 1 &&
+                section1Counter == sec1Reps - 1 &&
+                currentStep >= fillStart) {
+                // Fill: jump to section 2
+                section1Counter = 0;
+                inSection2 = true;
+                currentStep = splitPoint;
+                wrapped = true;
+            } else if (!inSection2 && currentStep >= section1End) {
+                wrapped = true;
+                section1Counter++;
+                if (section1Counter >= sec1Reps) {
+                    section1Counter = 0;
+                    inSection2 = true;
+                    if (splitPoint > 0) {
+                        currentStep = splitPoint;
+                    } else {
+                        currentStep = 0;
+                    }
+                } else {
+                    currentStep = 0;
+                }
+            } else if (inSection2 && currentStep >= trackLength) {
+                wrapped = true;
+                section2Counter++;
+                if (section2Counter >= sec2Reps) {
+                    section2Counter = 0;
+                    inSection2 = false;
+                }
+                currentStep = (splitPoint > 0) ? splitPoint : 0;
+                if (!inSection2) {
+                    currentStep = 0;
+                }
+            }
+        } else if (direction == 1) {
+            currentStep--;
+            if (inSection2 && currentStep < splitPoint) {
+                wrapped = true;
+                section2Counter++;
+                if (section2Counter >= sec2Reps) {
+                    section2Counter = 0;
+                    inSection2 = false;
+                    currentStep = section1End - 1;
+                } else {
+                    currentStep = trackLength - 1;
+                }
+            } else if (!inSection2 && currentStep < 0) {
+                wrapped = true;
+                section1Counter++;
+                if (section1Counter >= sec1Reps) {
+                    section1Counter = 0;
+                    inSection2 = true;
+                    currentStep = trackLength - 1;
+                } else {
+                    currentStep = section1End - 1;
+                }
+            }
+        } else if (direction == 2) {
+            if (pingpongForward) {
+                currentStep++;
+                if (currentStep >= trackLength) {
+                    currentStep = trackLength - 2;
+                    if (currentStep < 0) currentStep = 0;
+                    pingpongForward = false;
+                    wrapped = true;
+                }
+            } else {
+                currentStep--;
+                if (currentStep < 0) {
+                    currentStep = 1;
+                    if (currentStep >= trackLength) currentStep = trackLength - 1;
+                    pingpongForward = true;
+                    wrapped = true;
+                }
+            }
+        }
+        if (wrapped) passes++;
+    }
+    
+    // Copy of V3Seq::advanceSequencer, followed by the First/Last Step clamp
+    // that step() applies after every advance
+    void advanceV3(int direction, int firstStep, int lastStep, int splitPoint,
+                   int sec1Reps, int sec2Reps) {
+        int startIndex = firstStep - 1;
+        int endIndex = lastStep - 1;
+        
+        if (splitPoint >= lastStep) {
+            if (direction == 0) {
+                currentStep++;
+                if (currentStep > endIndex) {
+                    currentStep = startIndex;
+                }
+            } else if (direction == 1) {
+                currentStep--;
+                if (currentStep < startIndex) {
+                    currentStep = endIndex;
+                }
+            } else {
+                if (pingpongForward) {
+                    currentStep++;
+                    if (currentStep > endIndex) {
+                        currentStep = endIndex;
+                        pingpongForward = false;
+                    }
+                } else {
+                    currentStep--;
+                    if (currentStep < startIndex) {
+                        currentStep = startIndex;
+                        pingpongForward = true;
+                    }
+                }
+            }
+        } else if (direction == 0) {
+            currentStep++;
+            if (!inSection2) {
+                if (currentStep >= splitPoint) {
+                    section1Counter++;
+                    if (section1Counter >= sec1Reps) {
+                        inSection2 = true;
+                        section1Counter = 0;
+                    } else {
+                        currentStep = startIndex;
+                    }
+                }
+            } else {
+                if (currentStep > endIndex) {
+                    section2Counter++;
+                    if (section2Counter >= sec2Reps) {
+                        inSection2 = false;
+                        section2Counter = 0;
+                        currentStep = startIndex;
+                    } else {
+                        currentStep = splitPoint;
+                    }
+                }
+            }
+        } else if (direction == 1) {
+            currentStep--;
+            if (inSection2) {
+                if (currentStep < splitPoint) {
+                    section2Counter++;
+                    if (section2Counter >= sec2Reps) {
+                        inSection2 = false;
+                        section2Counter = 0;
+                    } else {
+                        currentStep = endIndex;
+                    }
+                }
+            } else {
+                if (currentStep < startIndex) {
+                    section1Counter++;
+                    if (section1Counter >= sec1Reps) {
+                        inSection2 = true;
+                        section1Counter = 0;
+                        currentStep = endIndex;
+                    } else {
+                        currentStep = splitPoint - 1;
+                    }
+                }
+            }
+        } else {
+            if (pingpongForward) {
+                currentStep++;
+                if (currentStep > endIndex) {
+                    currentStep = endIndex;
+                    pingpongForward = false;
+                }
+            } else {
+                currentStep--;
+                if (currentStep < startIndex) {
+                    currentStep = startIndex;
+                    pingpongForward = true;
+                }
+            }
+        }
+        
+        clamp(firstStep, lastStep);
+    }
+    
+    // step()'s First/Last Step clamp (also applied right after reset)
+    void clamp(int firstStep, int lastStep) {
+        if (currentStep < firstStep - 1) currentStep = firstStep - 1;
+        if (currentStep > lastStep - 1) currentStep = lastStep - 1;
+    }
+};
+
+// Seek and replay disagreements in the current test; only the first few are printed
+int mismatches = 0;
+
+// Compare the walked state after `advances` advances with plan.seek(advances)
+void checkSeek(const char* what, const LoopPlan& plan, uint32_t advances, const Track& t,
+               bool checkPasses, int direction, int length, int split, int sec1Reps, int sec2Reps,
+               int extra) {
+    LoopState st = plan.seek(advances);
+    bool same = st.step == t.currentStep &&
+                st.section1Counter == t.section1Counter &&
+                st.section2Counter == t.section2Counter &&
+                st.inSection2 == t.inSection2 &&
+                st.pingpongForward == t.pingpongForward &&
+                (!checkPasses || st.passes == t.passes);
+    if (same) return;
+    
+    if (mismatches < 5) {
+        std::cout << "  MISMATCH: " << what << " dir=" << direction << " len=" << length
+                  << " split=" << split << " reps=" << sec1Reps << "/" << sec2Reps
+                  << " fill/first=" << extra << " after " << advances << " advances\n";
+        std::cout << "    Replay: step " << t.currentStep << " s1 " << t.section1Counter
+                  << " s2 " << t.section2Counter << " sec2 " << t.inSection2
+                  << " fwd " << t.pingpongForward << " passes " << t.passes << "\n";
+        std::cout << "    Seek:   step " << st.step << " s1 " << st.section1Counter
+                  << " s2 " << st.section2Counter << " sec2 " << st.inSection2
+                  << " fwd " << st.pingpongForward << " passes " << st.passes << "\n";
+    }
+    mismatches++;
+}
+
+// Advances to replay for one combination: the lead-in plus at least two whole cycles
+static int replayLength(int length, int sec1Reps, int sec2Reps) {
+    return (4 * length * (sec1Reps + sec2Reps)) + 8;
+}
+
+// ============================================================================
+// Seek vs Step-by-Step Replay
+// ============================================================================
+
+TEST_F(SeekTest, CvSequencerSeekMatchesReplay) {
+    mismatches = 0;
+    for (int direction = 0; direction < 3; direction++) {
+        for (int length = 1; length <= kTestLength; length++) {
+            // Split Point is 1 or more; at or past the length there are no sections
+            for (int split = 1; split <= length + 1; split++) {
+                for (int sec1Reps = 1; sec1Reps <= kTestReps; sec1Reps++) {
+                    for (int sec2Reps = 1; sec2Reps <= kTestReps; sec2Reps++) {
+                        LoopPlan plan;
+                        buildCvLoop(plan, direction, length, split, sec1Reps, sec2Reps);
+                        
+                        Track t;
+                        int replay = replayLength(length, sec1Reps, sec2Reps);
+                        for (int n = 0; n <= replay; n++) {
+                            checkSeek("CV seq", plan, n, t, false, direction, length, split, sec1Reps, sec2Reps, 0);
+                            t.advanceCv(direction, length, split, sec1Reps, sec2Reps);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_F(SeekTest, TriggerTrackSeekMatchesReplay) {
+    mismatches = 0;
+    for (int direction = 0; direction < 3; direction++) {
+        for (int length = 1; length <= kTestLength; length++) {
+            // Split 0 is section 1 only; Fill Start 1 to the length, past the split is off
+            for (int split = 0; split <= length; split++) {
+                for (int fill = 1; fill <= length; fill++) {
+                    for (int sec1Reps = 1; sec1Reps <= kTestReps; sec1Reps++) {
+                        for (int sec2Reps = 1; sec2Reps <= kTestReps; sec2Reps++) {
+                            LoopPlan plan;
+                            buildTrackLoop(plan, direction, length, split, sec1Reps, sec2Reps, fill);
+                            
+                            Track t;
+                            int replay = replayLength(length, sec1Reps, sec2Reps);
+                            for (int n = 0; n <= replay; n++) {
+                                checkSeek("Track", plan, n, t, true, direction, length, split, sec1Reps, sec2Reps, fill);
+                                t.walkTrack(direction, length, split, sec1Reps, sec2Reps, fill);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_F(SeekTest, V3SeqSeekMatchesReplay) {
+    mismatches = 0;
+    for (int direction = 0; direction < 3; direction++) {
+        for (int first = 1; first <= kTestLength; first++) {
+            // First Step <= Last Step is kept by parameterChanged
+            for (int last = first; last <= kTestLength; last++) {
+                for (int split = 0; split <= kTestLength; split++) {
+                    for (int sec1Reps = 1; sec1Reps <= kTestReps; sec1Reps++) {
+                        for (int sec2Reps = 1; sec2Reps <= kTestReps; sec2Reps++) {
+                            LoopPlan plan;
+                            buildLoop(plan, direction, first, last, split, sec1Reps, sec2Reps);
+                            
+                            // Reset puts the step at 0; step() clamps it into range
+                            Track t;
+                            t.clamp(first, last);
+                            int replay = replayLength(kTestLength, sec1Reps, sec2Reps);
+                            for (int n = 0; n <= replay; n++) {
+                                checkSeek("V3Seq", plan, n, t, false, direction, last, split, sec1Reps, sec2Reps, first);
+                                t.advanceV3(direction, first, last, split, sec1Reps, sec2Reps);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_F(SeekTest, SeekFarIntoTheSong) {
+    // Seeking wraps the repeating cycle arithmetically; check a position far past
+    // the first cycle against a full replay
+    const uint32_t kFar = 1000003;
+    mismatches = 0;
+    
+    for (int direction = 0; direction < 3; direction++) {
+        LoopPlan cv;
+        buildCvLoop(cv, direction, 13, 5, 3, 2);
+        Track tc;
+        for (uint32_t n = 0; n < kFar; n++) tc.advanceCv(direction, 13, 5, 3, 2);
+        checkSeek("CV seq", cv, kFar, tc, false, direction, 13, 5, 3, 2, 0);
+        
+        LoopPlan track;
+        buildTrackLoop(track, direction, 13, 5, 3, 2, 3);
+        Track tt;
+        for (uint32_t n = 0; n < kFar; n++) tt.walkTrack(direction, 13, 5, 3, 2, 3);
+        checkSeek("Track", track, kFar, tt, true, direction, 13, 5, 3, 2, 3);
+        
+        LoopPlan v3;
+        buildLoop(v3, direction, 3, 15, 7, 3, 2);
+        Track tv;
+        tv.clamp(3, 15);
+        for (uint32_t n = 0; n < kFar; n++) tv.advanceV3(direction, 3, 15, 7, 3, 2);
+        checkSeek("V3Seq", v3, kFar, tv, false, direction, 15, 7, 3, 2, 3);
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+// Main function for running tests
+int main(int argc, char **argv) {
+    std::cout << "Running Seek Unit Tests\n";
+    std::cout << "=======================\n\n";
+    
+    std::cout << "Test: CvSequencerSeekMatchesReplay\n";
+    test_SeekTest_CvSequencerSeekMatchesReplay();
+    
+    std::cout << "Test: TriggerTrackSeekMatchesReplay\n";
+    test_SeekTest_TriggerTrackSeekMatchesReplay();
+    
+    std::cout << "Test: V3SeqSeekMatchesReplay\n";
+    test_SeekTest_V3SeqSeekMatchesReplay();
+    
+    std::cout << "Test: SeekFarIntoTheSong\n";
+    test_SeekTest_SeekFarIntoTheSong();
+    
+    // Summary
+    std::cout << "\n=======================\n";
+    std::cout << "Test Results:\n";
+    std::cout << "  Total:  " << totalTests << "\n";
+    std::cout << "  Passed: " << passedTests << "\n";
+    std::cout << "  Failed: " << failedTests << "\n";
+    
+    if (failedTests == 0) {
+        std::cout << "\n✓ All tests passed!\n";
+        return 0;
+    } else {
+        std::cout << "\n✗ Some tests failed.\n";
+        return 1;
+    }
+}
@@ -6,81 +6,462 @@
 #include <cmath>
 #include <cstring>
 
-// VTrig: 6-track trigger/gate sequencer
+#include "seq_common.h"
+
+// VTrig: 6 to 16 track trigger/gate sequencer
 // - Shared Clock and Reset inputs
-// - 6 independent trigger tracks with CV outputs
-// - 6 MIDI CC outputs (one per track)
-// - 32 steps per track
+// - 6-16 independent trigger tracks with CV outputs (Tracks specification)
+// - MIDI note per track (note-off at the end of the trigger pulse)
+// - 32-128 steps per track (Max Steps specification), stored in DRAM
 // - Direction control: Forward, Backward, Pingpong
 // - Clock division/multiplication (31 options: /16 to x16)
 // - Swing (0-100%)
 // - Section looping with configurable repeats
 // - Fill feature (jumps to section 2 on last repeat of section 1)
+// - Follows a CV clock, 24 PPQN MIDI clock, or either
+// - MIDI Start/Stop/Continue and Song Position Pointer
+
+// Per-step attributes, packed into 16 bits:
+// bits 0-6 = probability (0-100%), bits 7-9 = ratchet count - 1 (1-8 hits),
+// bits 10-15 = microtiming nudge, signed, in 64ths of a step (-32..+31 = -50%..+48%)
+static const uint16_t kDefaultStepAttr = 100;  // 100%, 1 hit
+
+static inline int stepProbability(uint16_t attr) {
+    return attr & 0x7F;
+}
+
+static inline int stepRatchets(uint16_t attr) {
+    return ((attr >> 7) & 0x07) + 1;
+}
+
+static inline int stepNudge(uint16_t attr) {
+    return ((int16_t)attr) >> 10;  // Arithmetic shift keeps the sign
+}
+
+static inline uint16_t makeStepAttr(int probability, int ratchets, int nudge = 0) {
+    return (uint16_t)((probability & 0x7F) | (((ratchets - 1) & 0x07) << 7) | ((nudge & 0x3F) << 10));
+}
+
+// Trig conditions, one per step (Elektron style). Each pass through a track
+// works out which conditions hold for that pass as one 64-bit mask, so
+// deciding whether a step plays is a single bit test.
+//   Fill / Not Fill   - the pass that ends in the fill jump (last Section 1 repeat)
+//   First / Not First - the first pass after reset or Start
+//   A:B               - pass A of every B (B = 2-8)
+enum {
+    kCondNone,
+    kCondFill,
+    kCondNotFill,
+    kCondFirst,
+    kCondNotFirst,
+    kCondRatioFirst,            // 1:2, 2:2, 1:3, 2:3, 3:3 ... 8:8
+    kNumConditions = kCondRatioFirst + 35
+};
+
+static const char* const conditionNames[kNumConditions] = {
+    "", "Fill", "!Fill", "1st", "!1st",
+    "1:2", "2:2",
+    "1:3", "2:3", "3:3",
+    "1:4", "2:4", "3:4", "4:4",
+    "1:5", "2:5", "3:5", "4:5", "5:5",
+    "1:6", "2:6", "3:6", "4:6", "5:6", "6:6",
+    "1:7", "2:7", "3:7", "4:7", "5:7", "6:7", "7:7",
+    "1:8", "2:8", "3:8", "4:8", "5:8", "6:8", "7:8", "8:8"
+};
+
+// Conditions that hold on a pass: pass counts from 0 at reset
+static uint64_t conditionsFor(uint32_t pass, bool fillPass) {
+    uint64_t mask = 1ull << kCondNone;
+    mask |= 1ull << (fillPass ? kCondFill : kCondNotFill);
+    mask |= 1ull << ((pass == 0) ? kCondFirst : kCondNotFirst);
+    int cond = kCondRatioFirst;
+    for (int b = 2; b <= 8; b++) {
+        mask |= 1ull << (cond + (int)(pass % (uint32_t)b));
+        cond += b;
+    }
+    return mask;
+}
+
+// Modulation targets: the playback setting of a track (or of all of them) that
+// a modulation input moves
+enum {
+    kModLength,
+    kModDirection,
+    kModClockDiv,
+    kModSwing,
+    kNumModTargets
+};
+
+// Up to 16 tracks, chosen by the "Tracks" specification. Trigger decisions are
+// made on whole words: bit t of a mask is track t.
+static const int kMaxTracks = 16;
+static const int kDefaultTracks = 6;
+
+// Clock ratios, one per Clock Div setting (/16 .. x16)
+static const int kNumClockRatios = 31;
+
+// Per-track playback state. numTracks of these live in SRAM right after the
+// VTrig object (calculateRequirements sizes it from the specification); the
+// per-step data they point at is in DRAM.
+struct TrackState {
+    uint16_t* stepAttr;         // Probability, ratchets and nudge per step (see makeStepAttr)
+    uint8_t* stepCond;          // Trig condition per step (kCondNone ...)
+    int currentStep;            // Current step (0 to maxSteps-1)
+    bool pingpongForward;       // Direction state for pingpong mode
+    int section1Counter;        // Section 1 repeat count
+    int section2Counter;        // Section 2 repeat count
+    bool inSection2;            // Which section is currently playing
+    bool inFill;                // This pass ends in the fill jump
+    uint32_t passCount;         // Passes completed since reset
+    uint64_t passConds;         // Conditions that hold on this pass (see conditionsFor)
+    int triggerCounter;         // Countdown for trigger pulse duration
+    
+    // Probability and ratchets
+    XorShift32 rng;             // One generator per track, reseeded on reset
+    int pendingHits;            // Hits of an early-nudged step, started when pendingCountdown runs out
+    int pendingSpacing;
+    int pendingCountdown;       // Samples until the early step starts
+    int earlyStep;              // Step already rolled and scheduled from the previous tick (-1 = none)
+    int hitsLeft;               // Hits still to fire for the current step
+    int hitSpacing;             // Samples between ratchet hits
+    int hitCountdown;           // Samples until the next hit
+    int hitLength;              // Trigger pulse length for this step's hits
+    float hitLevel;             // Trigger level of this step's hits (accents are higher)
+    float pendingLevel;         // Level of the early step's hits
+    
+    // MIDI note output
+    int8_t midiNote;            // Note sounding on this track (-1 = none)
+    uint8_t midiStatus;         // Note-on status byte it was sent with (channel)
+    
+    TrackState(int track, int maxSteps, uint16_t* attrMemory, uint8_t* condMemory) {
+        stepAttr = attrMemory;
+        stepCond = condMemory;
+        for (int step = 0; step < maxSteps; step++) {
+            stepAttr[step] = kDefaultStepAttr;
+            stepCond[step] = kCondNone;
+        }
+        currentStep = 0;
+        pingpongForward = true;
+        section1Counter = 0;
+        section2Counter = 0;
+        inSection2 = false;
+        inFill = false;
+        passCount = 0;
+        passConds = conditionsFor(0, false);
+        triggerCounter = 0;
+        pendingHits = 0;
+        pendingSpacing = 0;
+        pendingCountdown = 0;
+        earlyStep = -1;
+        hitsLeft = 0;
+        hitSpacing = 0;
+        hitCountdown = 0;
+        hitLength = 240;
+        hitLevel = 5.0f;
+        pendingLevel = 5.0f;
+        midiNote = -1;
+        midiStatus = 0x90;
+        rng.seed(1u, (uint32_t)track);  // Seed parameter default (1)
+    }
+    
+    // Nothing left to fire: the output is a constant 0V for the whole block
+    bool idle() const {
+        return pendingHits == 0 && hitsLeft == 0 && triggerCounter == 0;
+    }
+};
+
+// Division/multiplication state, shared by every track on the same Clock Div
+// setting. Tracks on one ratio always step together, so each block decides
+// once per ratio instead of once per track.
+struct ClockRatio {
+    int clockCounter;           // Clock division counter
+    int internalClockCounter;   // Internal subdivision counter for multiplication
+    int lastClockPeriod;        // Samples between last two clocks (for multiplication)
+    int samplesSinceLastClock;  // Sample counter since last clock
+    
+    ClockRatio() {
+        clockCounter = 0;
+        internalClockCounter = 0;
+        lastClockPeriod = 4800;  // Default ~10Hz at 48kHz
+        samplesSinceLastClock = 0;
+    }
+    
+    void reset() {
+        clockCounter = 0;
+        internalClockCounter = 0;
+        samplesSinceLastClock = 0;
+    }
+};
+
+// Per-instance step data in DRAM, maxSteps entries per array (per track for
+// the step attributes)
+struct StepMemory {
+    uint32_t* columns;
+    uint32_t* activeColumns;
+    uint32_t* genColumns;
+    uint32_t* accentColumns;
+    uint16_t* stepAttr;         // [track][step]
+    uint8_t* stepCond;          // [track][step]
+    
+    static uint32_t bytesFor(int numTracks, int maxSteps) {
+        return (maxSteps * 4 * sizeof(uint32_t)) + (numTracks * maxSteps * (sizeof(uint16_t) + sizeof(uint8_t)));
+    }
+    
+    StepMemory(uint8_t* dram, int numTracks, int maxSteps) {
+        columns = (uint32_t*)dram;
+        activeColumns = columns + maxSteps;
+        genColumns = activeColumns + maxSteps;
+        accentColumns = genColumns + maxSteps;
+        stepAttr = (uint16_t*)(accentColumns + maxSteps);
+        stepCond = (uint8_t*)(stepAttr + (numTracks * maxSteps));
+    }
+};
+
+// A note message waiting for the end of the block. The block's messages are
+// sorted by frame, then track, and go out together at the end of the block.
+// Note-offs are sent as note-on with velocity 0.
+static const int kMaxMidiHits = 64;
+
+// MIDI parameters, in order after the modulation inputs: shared settings, then
+// one note per track
+enum {
+    kMidiChannel,
+    kMidiDest,
+    kMidiVelocity,
+    kMidiAccent,
+    kMidiNote1
+};
+
+struct MidiHit {
+    uint32_t order;             // frame << 8 | track << 1 | on, so a retrigger's off goes first
+    uint8_t status;
+    uint8_t note;
+    uint8_t velocity;
+};
 
 struct VTrig : public _NT_algorithm {
-    // Trigger data: 6 tracks × 32 steps
-    bool steps[6][32];
-    
-    // Track state (6 tracks)
-    int currentStep[6];         // Current step for each track (0-31)
-    bool pingpongForward[6];    // Direction state for pingpong mode
-    int swingCounter[6];        // Counter for swing timing
-    int section1Counter[6];     // Track section 1 repeat count
-    int section2Counter[6];     // Track section 2 repeat count
-    bool inSection2[6];         // Which section is currently playing
-    bool inFill[6];             // Whether we're in the fill section
-    int triggerCounter[6];      // Countdown for trigger pulse duration
-    bool triggered[6];          // Whether gate was just triggered this step
-    int clockCounter[6];        // Clock division counter for tracks
-    int internalClockCounter[6]; // Internal subdivision counter for multiplication
-    int lastClockPeriod[6];     // Samples between last two clocks (for multiplication)
-    int samplesSinceLastClock[6]; // Sample counter since last clock
+    int numTracks;              // From the Tracks specification (6-16)
+    TrackState* tracks;         // numTracks entries, placed after this object
+    int maxSteps;               // From the Max Steps specification (32-128)
+    
+    // Trigger data (DRAM): bit t of columns[step] = track t has a gate on that step
+    uint32_t* columns;
+    
+    // Tracks sitting on each step, kept up to date as tracks move. Tracks on the
+    // same step share one column lookup when a block's triggers are decided.
+    uint32_t positionMask[kMaxSteps];
+    
+    // Bit t of activeColumns[step] = that step's condition holds on track t's
+    // current pass. Rebuilt for a track whenever it starts a new pass. Only step()
+    // writes it: the UI changes stepCond and marks the track in condDirty, and the
+    // next block rebuilds its bits (every track shares these words).
+    uint32_t* activeColumns;
+    uint32_t condDirty;
+    
+    // Euclidean generator: tracks in generatedTracks play genColumns instead of
+    // columns, with accented hits in accentColumns. A track's bits are rebuilt only
+    // when one of its Euclid parameters (or its Length) changes: parameterChanged
+    // marks it in euclidDirty and the next block regenerates it.
+    uint32_t* genColumns;
+    uint32_t* accentColumns;
+    uint32_t generatedTracks;
+    uint32_t euclidDirty;
+    
+    ClockRatio ratios[kNumClockRatios];
     
     // Edge detection
     float lastClockIn;
     float lastResetIn;
     
+    // MIDI clock input
+    MidiClockFollower midiClock;
+    bool transportRunning;      // Cleared by MIDI Stop, set by Start/Continue
+    
+    // Internal clock
+    InternalClock internalClock;
+    uint32_t sampleTime;        // Samples processed since construction
+    uint32_t lastExternalTime;  // Block start of the last CV/MIDI clock
+    int externalPeriod;         // Samples between the last two external clocks
+    bool externalSeen;          // An external clock has arrived at least once
+    int clockOutCounter;        // Remaining samples of the Clock Out pulse
+    
     // UI state
-    int selectedStep;           // 0-31
-    int selectedTrack;          // 0-5
+    int selectedStep;           // 0 to maxSteps-1
+    int selectedTrack;          // 0 to numTracks-1
+    int firstVisibleTrack;      // Top row of the grid (6 rows fit on screen)
     int lastSelectedStep;       // Track when step changes to update pots
     uint16_t lastButton4State;  // For debouncing button 4
     uint16_t lastEncoderRButton; // For debouncing right encoder button
     float lastPotLValue;        // Track left pot position for relative movement
     bool trackPotCaught;        // Track if left pot has caught track position
+    bool attrPotCaught[3];      // Probability / ratchet / nudge pots have caught the step's value
     
-    VTrig() {
-        // Initialize track state
-        for (int track = 0; track < 6; track++) {
-            currentStep[track] = 0;
-            pingpongForward[track] = true;
-            swingCounter[track] = 0;
-            section1Counter[track] = 0;
-            section2Counter[track] = 0;
-            inSection2[track] = false;
-            inFill[track] = false;
-            triggerCounter[track] = 0;
-            clockCounter[track] = 0;
-            triggered[track] = false;
-            internalClockCounter[track] = 0;
-            lastClockPeriod[track] = 4800;  // Default ~10Hz at 48kHz
-            samplesSinceLastClock[track] = 0;
+    // Parameter pages (the number of track pages depends on the specification)
+    _NT_parameterPage pageArray[6 + kMaxTracks];
+    _NT_parameterPages pages;
+    uint8_t modPageParams[kNumModInputs * 4];
+    
+    // Modulation inputs, whose parameters follow the last track's (modBase).
+    // While any is assigned, modValues is this block's copy of the parameters
+    // with their offsets folded in, and played() reads it; the parameters
+    // themselves are never written.
+    int modBase;
+    ModInput mods[kNumModInputs];
+    bool modulated;
+    int16_t modValues[256];     // Parameter indices fit the uint8_t page lists
+    
+    // MIDI note output, whose parameters follow the modulation inputs (midiBase).
+    // Notes start and end with the trigger pulses and are queued in midiHits
+    // during the block, then sent in one batch. soundingMask has a bit per track
+    // with a note still on.
+    int midiBase;
+    uint8_t midiPageParams[kMidiNote1 + kMaxTracks];
+    MidiHit midiHits[kMaxMidiHits];
+    int numMidiHits;
+    uint32_t soundingMask;
+    
+    VTrig(int trackCount, TrackState* trackMemory, int stepCapacity, const StepMemory& steps) {
+        numTracks = trackCount;
+        tracks = trackMemory;
+        maxSteps = stepCapacity;
+        columns = steps.columns;
+        activeColumns = steps.activeColumns;
+        genColumns = steps.genColumns;
+        accentColumns = steps.accentColumns;
+        for (int track = 0; track < numTracks; track++) {
+            new (&tracks[track]) TrackState(track, maxSteps, steps.stepAttr + (track * maxSteps),
+                                            steps.stepCond + (track * maxSteps));
+        }
+        
+        // Every track starts on step 0
+        uint32_t allTracks = (numTracks >= 32) ? 0xFFFFFFFFu : ((1u << numTracks) - 1u);
+        for (int step = 0; step < kMaxSteps; step++) {
+            positionMask[step] = 0;
+        }
+        for (int step = 0; step < maxSteps; step++) {
+            columns[step] = 0;
+            activeColumns[step] = allTracks;  // No conditions yet
+            genColumns[step] = 0;
+            accentColumns[step] = 0;
         }
+        positionMask[0] = allTracks;
+        generatedTracks = 0;
+        euclidDirty = allTracks;  // First block builds from the loaded parameters
+        condDirty = 0;
         
         lastClockIn = 0.0f;
         lastResetIn = 0.0f;
         selectedStep = 0;
         selectedTrack = 0;
+        firstVisibleTrack = 0;
         lastSelectedStep = 0;
         lastButton4State = 0;
         lastEncoderRButton = 0;
         lastPotLValue = 0.5f;
         trackPotCaught = false;
+        attrPotCaught[0] = false;
+        attrPotCaught[1] = false;
+        attrPotCaught[2] = false;
+        transportRunning = true;
+        sampleTime = 0;
+        lastExternalTime = 0;
+        externalPeriod = 4800;
+        externalSeen = false;
+        clockOutCounter = 0;
+        modBase = 0;            // Set by initParameters
+        modulated = false;
+        midiBase = 0;           // Set by initParameters
+        numMidiHits = 0;
+        soundingMask = 0;
+    }
+    
+    // Value of a playback parameter as played this block: the parameter plus any
+    // modulation aimed at it. Only the audio side reads this; the UI and presets
+    // see the parameter as set.
+    int16_t played(int p) const {
+        return modulated ? modValues[p] : v[p];
+    }
+    
+    // Step data as stored (edited, saved with the preset)
+    bool storedGate(int track, int step) const {
+        return (columns[step] >> track) & 1u;
+    }
+    
+    // Gates as played: generated tracks play their Euclidean pattern
+    uint32_t gateColumn(int step) const {
+        return (columns[step] & ~generatedTracks) | genColumns[step];
+    }
+    
+    bool hasGate(int track, int step) const {
+        return (gateColumn(step) >> track) & 1u;
+    }
+    
+    void toggleGate(int track, int step) {
+        columns[step] ^= (1u << track);
+    }
+    
+    // Rebuild a track's bits in activeColumns from its pass conditions
+    void refreshActive(int track) {
+        const TrackState& t = tracks[track];
+        uint32_t bit = 1u << track;
+        for (int step = 0; step < maxSteps; step++) {
+            if ((t.passConds >> t.stepCond[step]) & 1u) {
+                activeColumns[step] |= bit;
+            } else {
+                activeColumns[step] &= ~bit;
+            }
+        }
+    }
+    
+    // Start a new pass: work out its conditions once for all the track's steps
+    void startPass(int track, uint32_t pass, bool fillPass) {
+        TrackState& t = tracks[track];
+        t.passCount = pass;
+        t.inFill = fillPass;
+        t.passConds = conditionsFor(pass, fillPass);
+        refreshActive(track);
+    }
+    
+    // Move a track to a step, keeping positionMask in sync
+    void moveTo(int track, int step) {
+        uint32_t bit = 1u << track;
+        int from = tracks[track].currentStep;
+        if (from >= 0 && from < maxSteps) positionMask[from] &= ~bit;
+        tracks[track].currentStep = step;
+        if (step >= 0 && step < maxSteps) positionMask[step] |= bit;
     }
     
     // Advance trigger track - will implement in Phase 2
     void advanceTrack(int track, int direction, int trackLength, int splitPoint, 
                       int sec1Reps, int sec2Reps, int fillStart);
+    bool walkTrack(int track, int direction, int trackLength, int splitPoint, 
+                   int sec1Reps, int sec2Reps, int fillStart);
+    void resetTrack(int track);
+    int peekNextStep(int track, int direction, int trackLength, int splitPoint,
+                     int sec1Reps, int sec2Reps, int fillStart, uint64_t& nextConds);
+    void playStep(int track, int step, bool gate, int stepLen, int swingDelay, int base);
+    void startHits(int track, int count, int spacing, int delay, float level);
+    void stepTracks(uint32_t steppedMask);
+    void renderTracks(float* busFrames, int numFrames, uint32_t runningMask, int fromFrame, int toFrame);
+    
+    // Euclidean generator
+    void regenerate(int track);
+    void freezeTrack(int track);
+    
+    // Modulation inputs
+    void applyModulation(const float* busFrames, int numFrames);
+    void modulate(int p, int offset);
+    
+    // MIDI note output
+    void noteOn(int track, int frame, float level);
+    void noteOff(int track, int frame);
+    void sendMidiHits();
+    
+    // MIDI transport
+    void transportStart();
+    void transportStop();
+    void transportContinue();
+    void seekToPosition(uint32_t position);
 };
 
 // =============================================================================
@@ -160,79 +541,86 @@ enum {
     kParamTrack6Section2Reps,
     kParamTrack6FillStart,
     
+    // Clock source: CV, MIDI, or either
+    kParamClockSource,
+    
+    // Internal clock
+    kParamInternalClock,
+    kParamBpm,
+    kParamPpqn,
+    kParamTakeover,
+    kParamClockOut,
+    
+    // Probability seed
+    kParamSeed,
+    
+    // Euclidean generator (6 tracks, 3 params each)
+    kParamTrack1EuclidHits,
+    kParamTrack1EuclidRotate,
+    kParamTrack1EuclidAccent,
+    kParamTrack6EuclidAccent = kParamTrack1EuclidHits + 17,
+    
     kNumParameters
 };
 
+// Tracks 7-16 (when the Tracks specification asks for them) are appended after
+// kNumParameters, 13 each: Out, then the same 9 + 3 Euclid as tracks 1-6. Tracks
+// 1-6 keep their original indices so 6-track presets load unchanged.
+static const int kExtraTrackParams = 13;
+
+// The modulation inputs come last, 4 each (In, Target, Dest, Depth), after
+// whatever tracks the instance has
+static inline int modParam(int numTracks, int mod) {
+    return kNumParameters + ((numTracks - kDefaultTracks) * kExtraTrackParams) + (mod * 4);
+}
+
+// Then the MIDI note output: Channel, Dest, Velocity, Accent and a Note per track
+static inline int midiParam(int numTracks) {
+    return modParam(numTracks, kNumModInputs);
+}
+
+static inline int numParametersFor(int numTracks) {
+    return midiParam(numTracks) + kMidiNote1 + numTracks;
+}
+
+static const int kMaxParameters = kNumParameters + ((kMaxTracks - kDefaultTracks) * kExtraTrackParams) + (kNumModInputs * 4) +
+                                  kMidiNote1 + kMaxTracks;
+
+// Output bus parameter of a track
+static inline int trackOutParam(int track) {
+    if (track < kDefaultTracks) return kParamTrack1Out + track;
+    return kNumParameters + ((track - kDefaultTracks) * kExtraTrackParams);
+}
+
+// Per-track parameter, named by its Track 1 enum (kParamTrack1Run .. kParamTrack1FillStart,
+// kParamTrack1EuclidHits .. kParamTrack1EuclidAccent)
+static inline int trackParam(int track, int param) {
+    if (param >= kParamTrack1EuclidHits) {
+        if (track < kDefaultTracks) return param + (track * 3);
+        return trackOutParam(track) + 10 + (param - kParamTrack1EuclidHits);
+    }
+    if (track < kDefaultTracks) return param + (track * 9);
+    return trackOutParam(track) + 1 + (param - kParamTrack1Run);
+}
+
 // Parameter name strings
 static char clockInName[] = "Clock In";
 static char resetInName[] = "Reset In";
+static char clockSourceName[] = "Clock Source";
+static char internalClockName[] = "Int Clock";
+static char bpmName[] = "BPM";
+static char ppqnName[] = "PPQN";
+static char takeoverName[] = "Takeover";
+static char clockOutName[] = "Clock Out";
+static char seedName[] = "Seed";
 
-static char track1OutName[] = "Track 1 Out";
-static char track2OutName[] = "Track 2 Out";
-static char track3OutName[] = "Track 3 Out";
-static char track4OutName[] = "Track 4 Out";
-static char track5OutName[] = "Track 5 Out";
-static char track6OutName[] = "Track 6 Out";
-
-static char track1RunName[] = "Track 1 Run";
-static char track1LenName[] = "Track 1 Length";
-static char track1DirName[] = "Track 1 Direction";
-static char track1DivName[] = "Track 1 Clock Div";
-static char track1SwingName[] = "Track 1 Swing";
-static char track1SplitName[] = "Track 1 Split Point";
-static char track1Sec1Name[] = "Track 1 Sec1 Reps";
-static char track1Sec2Name[] = "Track 1 Sec2 Reps";
-static char track1FillName[] = "Track 1 Fill Start";
-
-static char track2RunName[] = "Track 2 Run";
-static char track2LenName[] = "Track 2 Length";
-static char track2DirName[] = "Track 2 Direction";
-static char track2DivName[] = "Track 2 Clock Div";
-static char track2SwingName[] = "Track 2 Swing";
-static char track2SplitName[] = "Track 2 Split Point";
-static char track2Sec1Name[] = "Track 2 Sec1 Reps";
-static char track2Sec2Name[] = "Track 2 Sec2 Reps";
-static char track2FillName[] = "Track 2 Fill Start";
-
-static char track3RunName[] = "Track 3 Run";
-static char track3LenName[] = "Track 3 Length";
-static char track3DirName[] = "Track 3 Direction";
-static char track3DivName[] = "Track 3 Clock Div";
-static char track3SwingName[] = "Track 3 Swing";
-static char track3SplitName[] = "Track 3 Split Point";
-static char track3Sec1Name[] = "Track 3 Sec1 Reps";
-static char track3Sec2Name[] = "Track 3 Sec2 Reps";
-static char track3FillName[] = "Track 3 Fill Start";
-
-static char track4RunName[] = "Track 4 Run";
-static char track4LenName[] = "Track 4 Length";
-static char track4DirName[] = "Track 4 Direction";
-static char track4DivName[] = "Track 4 Clock Div";
-static char track4SwingName[] = "Track 4 Swing";
-static char track4SplitName[] = "Track 4 Split Point";
-static char track4Sec1Name[] = "Track 4 Sec1 Reps";
-static char track4Sec2Name[] = "Track 4 Sec2 Reps";
-static char track4FillName[] = "Track 4 Fill Start";
-
-static char track5RunName[] = "Track 5 Run";
-static char track5LenName[] = "Track 5 Length";
-static char track5DirName[] = "Track 5 Direction";
-static char track5DivName[] = "Track 5 Clock Div";
-static char track5SwingName[] = "Track 5 Swing";
-static char track5SplitName[] = "Track 5 Split Point";
-static char track5Sec1Name[] = "Track 5 Sec1 Reps";
-static char track5Sec2Name[] = "Track 5 Sec2 Reps";
-static char track5FillName[] = "Track 5 Fill Start";
-
-static char track6RunName[] = "Track 6 Run";
-static char track6LenName[] = "Track 6 Length";
-static char track6DirName[] = "Track 6 Direction";
-static char track6DivName[] = "Track 6 Clock Div";
-static char track6SwingName[] = "Track 6 Swing";
-static char track6SplitName[] = "Track 6 Split Point";
-static char track6Sec1Name[] = "Track 6 Sec1 Reps";
-static char track6Sec2Name[] = "Track 6 Sec2 Reps";
-static char track6FillName[] = "Track 6 Fill Start";
+// Per-track names, filled in by initParameters: Out, the 9 track parameters, then Euclid
+static const char* const trackParamSuffixes[] = {
+    "Out", "Run", "Length", "Direction", "Clock Div", "Swing", "Split Point", "Sec1 Reps", "Sec2 Reps", "Fill Start",
+    "Euclid Hits", "Euclid Rotate", "Euclid Accent", "Note"
+};
+static char trackParamNames[kMaxTracks][14][24];
+static char trackPageNames[kMaxTracks][12];
 
 static const char* const divisionStrings[] = {
     "/16", "/15", "/14", "/13", "/12", "/11", "/10", "/9", "/8", "/7", "/6", "/5", "/4", "/3", "/2",
@@ -243,9 +631,46 @@ static const char* const directionStrings[] = {
     "Forward", "Backward", "Pingpong", NULL
 };
 
-static _NT_parameter parameters[kNumParameters];
+static const char* const clockSourceStrings[] = {
+    "CV", "MIDI", "CV+MIDI", NULL
+};
+
+static const char* const internalClockStrings[] = {
+    "Off", "Auto", "On", NULL
+};
+
+static const char* const modTargetStrings[] = {
+    "Length", "Direction", "Clock Div", "Swing", NULL
+};
+
+// Where a modulation input goes: every track, or one of them
+static const char* const modDestStrings[] = {
+    "All", "Track 1", "Track 2", "Track 3", "Track 4", "Track 5", "Track 6", "Track 7", "Track 8",
+    "Track 9", "Track 10", "Track 11", "Track 12", "Track 13", "Track 14", "Track 15", "Track 16", NULL
+};
+static char modNames[kNumModInputs][4][16];
+
+static char midiChannelName[] = "MIDI Channel";
+static char midiDestName[] = "MIDI Dest";
+static char midiVelocityName[] = "Velocity";
+static char midiAccentName[] = "Accent Vel";
+
+static const char* const midiChannelStrings[] = {
+    "Off", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16", NULL
+};
 
-void initParameters(_NT_algorithm* self) {
+static const char* const midiDestStrings[] = {
+    "Breakout", "USB", "Breakout+USB", "Internal", "Select Bus", "All", NULL
+};
+
+// General MIDI drum map: kick, snare, hats, clap, rim, toms, cymbals, percussion
+static const uint8_t defaultTrackNotes[kMaxTracks] = {
+    36, 38, 42, 46, 39, 37, 41, 43, 45, 47, 48, 50, 49, 51, 56, 70
+};
+
+static _NT_parameter parameters[kMaxParameters];
+
+void initParameters(VTrig* alg) {
     // Clock and Reset inputs
     parameters[kParamClockIn].name = clockInName;
     parameters[kParamClockIn].min = 0;
@@ -261,13 +686,69 @@ void initParameters(_NT_algorithm* self) {
     parameters[kParamResetIn].unit = kNT_unitCvInput;
     parameters[kParamResetIn].scaling = kNT_scalingNone;
     
-    // Track outputs
-    const char* outNames[] = {track1OutName, track2OutName, track3OutName, track4OutName, track5OutName, track6OutName};
+    parameters[kParamClockSource].name = clockSourceName;
+    parameters[kParamClockSource].min = 0;
+    parameters[kParamClockSource].max = 2;  // CV, MIDI, CV+MIDI
+    parameters[kParamClockSource].def = 0;  // CV
+    parameters[kParamClockSource].unit = kNT_unitEnum;
+    parameters[kParamClockSource].scaling = kNT_scalingNone;
+    parameters[kParamClockSource].enumStrings = clockSourceStrings;
+    
+    // Internal clock
+    parameters[kParamInternalClock].name = internalClockName;
+    parameters[kParamInternalClock].min = 0;
+    parameters[kParamInternalClock].max = 2;  // Off, Auto, On
+    parameters[kParamInternalClock].def = 0;  // Off
+    parameters[kParamInternalClock].unit = kNT_unitEnum;
+    parameters[kParamInternalClock].scaling = kNT_scalingNone;
+    parameters[kParamInternalClock].enumStrings = internalClockStrings;
+    
+    parameters[kParamBpm].name = bpmName;
+    parameters[kParamBpm].min = 200;   // 20.0 BPM
+    parameters[kParamBpm].max = 3000;  // 300.0 BPM
+    parameters[kParamBpm].def = 1200;  // 120.0 BPM
+    parameters[kParamBpm].unit = kNT_unitBPM;
+    parameters[kParamBpm].scaling = kNT_scaling10;
     
-    for (int track = 0; track < 6; track++) {
-        int outParam = kParamTrack1Out + track;
+    parameters[kParamPpqn].name = ppqnName;
+    parameters[kParamPpqn].min = 1;
+    parameters[kParamPpqn].max = 24;
+    parameters[kParamPpqn].def = 4;    // 16th notes
+    parameters[kParamPpqn].unit = kNT_unitNone;
+    parameters[kParamPpqn].scaling = kNT_scalingNone;
+    
+    parameters[kParamTakeover].name = takeoverName;
+    parameters[kParamTakeover].min = 1;
+    parameters[kParamTakeover].max = 16;  // Missed external clock periods before Auto takes over
+    parameters[kParamTakeover].def = 4;
+    parameters[kParamTakeover].unit = kNT_unitNone;
+    parameters[kParamTakeover].scaling = kNT_scalingNone;
+    
+    parameters[kParamClockOut].name = clockOutName;
+    parameters[kParamClockOut].min = 0;
+    parameters[kParamClockOut].max = 28;
+    parameters[kParamClockOut].def = 0;   // None
+    parameters[kParamClockOut].unit = kNT_unitCvOutput;
+    parameters[kParamClockOut].scaling = kNT_scalingNone;
+    
+    // Probability: same seed, same pattern from reset
+    parameters[kParamSeed].name = seedName;
+    parameters[kParamSeed].min = 0;
+    parameters[kParamSeed].max = 9999;
+    parameters[kParamSeed].def = 1;
+    parameters[kParamSeed].unit = kNT_unitNone;
+    parameters[kParamSeed].scaling = kNT_scalingNone;
+    
+    // Track outputs (all 16; the specification decides how many are used)
+    for (int track = 0; track < kMaxTracks; track++) {
+        for (int i = 0; i < 14; i++) {
+            snprintf(trackParamNames[track][i], sizeof(trackParamNames[track][i]), "Track %d %s",
+                     track + 1, trackParamSuffixes[i]);
+        }
+        
+        int outParam = trackOutParam(track);
         
-        parameters[outParam].name = outNames[track];
+        parameters[outParam].name = trackParamNames[track][0];
         parameters[outParam].min = 0;
         parameters[outParam].max = 28;
         parameters[outParam].def = 0;
@@ -275,43 +756,33 @@ void initParameters(_NT_algorithm* self) {
         parameters[outParam].scaling = kNT_scalingNone;
     }
     
-    // Track parameters (6 tracks, 9 parameters each)
-    const char* runNames[] = {track1RunName, track2RunName, track3RunName, track4RunName, track5RunName, track6RunName};
-    const char* lenNames[] = {track1LenName, track2LenName, track3LenName, track4LenName, track5LenName, track6LenName};
-    const char* dirNames[] = {track1DirName, track2DirName, track3DirName, track4DirName, track5DirName, track6DirName};
-    const char* divNames[] = {track1DivName, track2DivName, track3DivName, track4DivName, track5DivName, track6DivName};
-    const char* swingNames[] = {track1SwingName, track2SwingName, track3SwingName, track4SwingName, track5SwingName, track6SwingName};
-    const char* splitNames[] = {track1SplitName, track2SplitName, track3SplitName, track4SplitName, track5SplitName, track6SplitName};
-    const char* sec1Names[] = {track1Sec1Name, track2Sec1Name, track3Sec1Name, track4Sec1Name, track5Sec1Name, track6Sec1Name};
-    const char* sec2Names[] = {track1Sec2Name, track2Sec2Name, track3Sec2Name, track4Sec2Name, track5Sec2Name, track6Sec2Name};
-    const char* fillNames[] = {track1FillName, track2FillName, track3FillName, track4FillName, track5FillName, track6FillName};
-    
-    for (int track = 0; track < 6; track++) {
-        int runParam = kParamTrack1Run + (track * 9);
-        int lenParam = kParamTrack1Length + (track * 9);
-        int dirParam = kParamTrack1Direction + (track * 9);
-        int divParam = kParamTrack1ClockDiv + (track * 9);
-        int swingParam = kParamTrack1Swing + (track * 9);
-        int splitParam = kParamTrack1SplitPoint + (track * 9);
-        int sec1Param = kParamTrack1Section1Reps + (track * 9);
-        int sec2Param = kParamTrack1Section2Reps + (track * 9);
-        int fillParam = kParamTrack1FillStart + (track * 9);
-        
-        parameters[runParam].name = runNames[track];
+    // Track parameters (9 parameters each)
+    for (int track = 0; track < kMaxTracks; track++) {
+        int runParam = trackParam(track, kParamTrack1Run);
+        int lenParam = trackParam(track, kParamTrack1Length);
+        int dirParam = trackParam(track, kParamTrack1Direction);
+        int divParam = trackParam(track, kParamTrack1ClockDiv);
+        int swingParam = trackParam(track, kParamTrack1Swing);
+        int splitParam = trackParam(track, kParamTrack1SplitPoint);
+        int sec1Param = trackParam(track, kParamTrack1Section1Reps);
+        int sec2Param = trackParam(track, kParamTrack1Section2Reps);
+        int fillParam = trackParam(track, kParamTrack1FillStart);
+        
+        parameters[runParam].name = trackParamNames[track][1];
         parameters[runParam].min = 0;
         parameters[runParam].max = 1;
         parameters[runParam].def = 0;
         parameters[runParam].unit = kNT_unitNone;
         parameters[runParam].scaling = kNT_scalingNone;
         
-        parameters[lenParam].name = lenNames[track];
+        parameters[lenParam].name = trackParamNames[track][2];
         parameters[lenParam].min = 1;
-        parameters[lenParam].max = 32;
+        parameters[lenParam].max = kMinSteps;  // Raised to Max Steps per instance
         parameters[lenParam].def = 16;
         parameters[lenParam].unit = kNT_unitNone;
         parameters[lenParam].scaling = kNT_scalingNone;
         
-        parameters[dirParam].name = dirNames[track];
+        parameters[dirParam].name = trackParamNames[track][3];
         parameters[dirParam].min = 0;
         parameters[dirParam].max = 2;
         parameters[dirParam].def = 0;
@@ -319,7 +790,7 @@ void initParameters(_NT_algorithm* self) {
         parameters[dirParam].scaling = kNT_scalingNone;
         parameters[dirParam].enumStrings = directionStrings;
         
-        parameters[divParam].name = divNames[track];
+        parameters[divParam].name = trackParamNames[track][4];
         parameters[divParam].min = 0;
         parameters[divParam].max = 30;
         parameters[divParam].def = 14;  // Default to /2
@@ -327,108 +798,273 @@ void initParameters(_NT_algorithm* self) {
         parameters[divParam].scaling = kNT_scalingNone;
         parameters[divParam].enumStrings = divisionStrings;
         
-        parameters[swingParam].name = swingNames[track];
+        parameters[swingParam].name = trackParamNames[track][5];
         parameters[swingParam].min = 0;
         parameters[swingParam].max = 100;
         parameters[swingParam].def = 0;
         parameters[swingParam].unit = kNT_unitNone;
         parameters[swingParam].scaling = kNT_scalingNone;
         
-        parameters[splitParam].name = splitNames[track];
+        parameters[splitParam].name = trackParamNames[track][6];
         parameters[splitParam].min = 0;
-        parameters[splitParam].max = 31;
+        parameters[splitParam].max = kMinSteps - 1;
         parameters[splitParam].def = 0;
         parameters[splitParam].unit = kNT_unitNone;
         parameters[splitParam].scaling = kNT_scalingNone;
         
-        parameters[sec1Param].name = sec1Names[track];
+        parameters[sec1Param].name = trackParamNames[track][7];
         parameters[sec1Param].min = 1;
         parameters[sec1Param].max = 99;
         parameters[sec1Param].def = 1;
         parameters[sec1Param].unit = kNT_unitNone;
         parameters[sec1Param].scaling = kNT_scalingNone;
         
-        parameters[sec2Param].name = sec2Names[track];
+        parameters[sec2Param].name = trackParamNames[track][8];
         parameters[sec2Param].min = 1;
         parameters[sec2Param].max = 99;
         parameters[sec2Param].def = 1;
         parameters[sec2Param].unit = kNT_unitNone;
         parameters[sec2Param].scaling = kNT_scalingNone;
         
-        parameters[fillParam].name = fillNames[track];
+        parameters[fillParam].name = trackParamNames[track][9];
         parameters[fillParam].min = 1;
-        parameters[fillParam].max = 32;
+        parameters[fillParam].max = kMinSteps;
         parameters[fillParam].def = 1;
         parameters[fillParam].unit = kNT_unitNone;
         parameters[fillParam].scaling = kNT_scalingNone;
+        
+        // Euclidean generator: Hits 0 plays the stored steps
+        int hitsParam = trackParam(track, kParamTrack1EuclidHits);
+        int rotateParam = trackParam(track, kParamTrack1EuclidRotate);
+        int accentParam = trackParam(track, kParamTrack1EuclidAccent);
+        
+        parameters[hitsParam].name = trackParamNames[track][10];
+        parameters[hitsParam].min = 0;
+        parameters[hitsParam].max = kMinSteps;  // Spread over the track Length
+        parameters[hitsParam].def = 0;   // Off
+        parameters[hitsParam].unit = kNT_unitNone;
+        parameters[hitsParam].scaling = kNT_scalingNone;
+        
+        parameters[rotateParam].name = trackParamNames[track][11];
+        parameters[rotateParam].min = 0;
+        parameters[rotateParam].max = kMinSteps - 1;
+        parameters[rotateParam].def = 0;
+        parameters[rotateParam].unit = kNT_unitNone;
+        parameters[rotateParam].scaling = kNT_scalingNone;
+        
+        parameters[accentParam].name = trackParamNames[track][12];
+        parameters[accentParam].min = 0;
+        parameters[accentParam].max = kMinSteps;  // Spread over the hits
+        parameters[accentParam].def = 0;   // No accents
+        parameters[accentParam].unit = kNT_unitNone;
+        parameters[accentParam].scaling = kNT_scalingNone;
+    }
+    
+    // Modulation inputs (after track 16 here; after the instance's last track in
+    // its own table). Depth 100% sweeps the target's whole range over 10V; an
+    // input set to none costs nothing.
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int base = modParam(kMaxTracks, mod);
+        snprintf(modNames[mod][0], sizeof(modNames[mod][0]), "Mod %d In", mod + 1);
+        snprintf(modNames[mod][1], sizeof(modNames[mod][1]), "Mod %d Target", mod + 1);
+        snprintf(modNames[mod][2], sizeof(modNames[mod][2]), "Mod %d Dest", mod + 1);
+        snprintf(modNames[mod][3], sizeof(modNames[mod][3]), "Mod %d Depth", mod + 1);
+        
+        parameters[base].name = modNames[mod][0];
+        parameters[base].min = 0;
+        parameters[base].max = 28;
+        parameters[base].def = 0;   // None
+        parameters[base].unit = kNT_unitCvInput;
+        parameters[base].scaling = kNT_scalingNone;
+        
+        parameters[base + 1].name = modNames[mod][1];
+        parameters[base + 1].min = 0;
+        parameters[base + 1].max = kNumModTargets - 1;
+        parameters[base + 1].def = kModLength;
+        parameters[base + 1].unit = kNT_unitEnum;
+        parameters[base + 1].scaling = kNT_scalingNone;
+        parameters[base + 1].enumStrings = modTargetStrings;
+        
+        parameters[base + 2].name = modNames[mod][2];
+        parameters[base + 2].min = 0;
+        parameters[base + 2].max = kMaxTracks;  // Lowered to the instance's tracks below
+        parameters[base + 2].def = 0;   // All
+        parameters[base + 2].unit = kNT_unitEnum;
+        parameters[base + 2].scaling = kNT_scalingNone;
+        parameters[base + 2].enumStrings = modDestStrings;
+        
+        parameters[base + 3].name = modNames[mod][3];
+        parameters[base + 3].min = -100;
+        parameters[base + 3].max = 100;
+        parameters[base + 3].def = 100;
+        parameters[base + 3].unit = kNT_unitPercent;
+        parameters[base + 3].scaling = kNT_scalingNone;
     }
     
-    self->parameters = parameters;
+    // MIDI note output (after the modulation inputs). Channel Off sends nothing.
+    int midiBase = midiParam(kMaxTracks);
+    parameters[midiBase + kMidiChannel].name = midiChannelName;
+    parameters[midiBase + kMidiChannel].min = 0;
+    parameters[midiBase + kMidiChannel].max = 16;
+    parameters[midiBase + kMidiChannel].def = 0;   // Off
+    parameters[midiBase + kMidiChannel].unit = kNT_unitEnum;
+    parameters[midiBase + kMidiChannel].scaling = kNT_scalingNone;
+    parameters[midiBase + kMidiChannel].enumStrings = midiChannelStrings;
+    
+    parameters[midiBase + kMidiDest].name = midiDestName;
+    parameters[midiBase + kMidiDest].min = 0;
+    parameters[midiBase + kMidiDest].max = 5;
+    parameters[midiBase + kMidiDest].def = 2;      // Breakout+USB
+    parameters[midiBase + kMidiDest].unit = kNT_unitEnum;
+    parameters[midiBase + kMidiDest].scaling = kNT_scalingNone;
+    parameters[midiBase + kMidiDest].enumStrings = midiDestStrings;
+    
+    parameters[midiBase + kMidiVelocity].name = midiVelocityName;
+    parameters[midiBase + kMidiVelocity].min = 1;
+    parameters[midiBase + kMidiVelocity].max = 127;
+    parameters[midiBase + kMidiVelocity].def = 100;
+    parameters[midiBase + kMidiVelocity].unit = kNT_unitNone;
+    parameters[midiBase + kMidiVelocity].scaling = kNT_scalingNone;
+    
+    parameters[midiBase + kMidiAccent].name = midiAccentName;
+    parameters[midiBase + kMidiAccent].min = 1;
+    parameters[midiBase + kMidiAccent].max = 127;
+    parameters[midiBase + kMidiAccent].def = 127;  // Accented (10V) hits
+    parameters[midiBase + kMidiAccent].unit = kNT_unitNone;
+    parameters[midiBase + kMidiAccent].scaling = kNT_scalingNone;
+    
+    for (int track = 0; track < kMaxTracks; track++) {
+        _NT_parameter& note = parameters[midiBase + kMidiNote1 + track];
+        note.name = trackParamNames[track][13];
+        note.min = 0;
+        note.max = 127;
+        note.def = defaultTrackNotes[track];
+        note.unit = kNT_unitNone;
+        note.scaling = kNT_scalingNone;
+    }
+    
+    // Step ranges follow this instance's Max Steps, so it gets its own copy of
+    // the table (placed after the track states, see calculateRequirements)
+    alg->modBase = modParam(alg->numTracks, 0);
+    alg->midiBase = midiParam(alg->numTracks);
+    _NT_parameter* table = (_NT_parameter*)(alg->tracks + alg->numTracks);
+    memcpy(table, parameters, alg->modBase * sizeof(_NT_parameter));
+    memcpy(table + alg->modBase, parameters + modParam(kMaxTracks, 0), kNumModInputs * 4 * sizeof(_NT_parameter));
+    memcpy(table + alg->midiBase, parameters + midiBase, (kMidiNote1 + alg->numTracks) * sizeof(_NT_parameter));
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        table[alg->modBase + (mod * 4) + 2].max = alg->numTracks;
+    }
+    for (int track = 0; track < alg->numTracks; track++) {
+        table[trackParam(track, kParamTrack1Length)].max = alg->maxSteps;
+        table[trackParam(track, kParamTrack1SplitPoint)].max = alg->maxSteps - 1;
+        table[trackParam(track, kParamTrack1FillStart)].max = alg->maxSteps;
+        table[trackParam(track, kParamTrack1EuclidHits)].max = alg->maxSteps;
+        table[trackParam(track, kParamTrack1EuclidRotate)].max = alg->maxSteps - 1;
+        table[trackParam(track, kParamTrack1EuclidAccent)].max = alg->maxSteps;
+    }
+    alg->parameters = table;
 }
 
 // =============================================================================
 // Parameter Pages
 // =============================================================================
 
-static uint8_t paramPageClock[] = { kParamClockIn, kParamResetIn, 0 };
-static uint8_t paramPageRouting[] = { 
-    kParamTrack1Out, kParamTrack2Out, kParamTrack3Out, kParamTrack4Out, kParamTrack5Out, kParamTrack6Out,
-    0 
-};
-static uint8_t paramPageTrack1[] = { 
-    kParamTrack1Run, kParamTrack1Length, kParamTrack1Direction, kParamTrack1ClockDiv, kParamTrack1Swing,
-    kParamTrack1SplitPoint, kParamTrack1Section1Reps, kParamTrack1Section2Reps, kParamTrack1FillStart, 0 
-};
-static uint8_t paramPageTrack2[] = { 
-    kParamTrack2Run, kParamTrack2Length, kParamTrack2Direction, kParamTrack2ClockDiv, kParamTrack2Swing,
-    kParamTrack2SplitPoint, kParamTrack2Section1Reps, kParamTrack2Section2Reps, kParamTrack2FillStart, 0 
-};
-static uint8_t paramPageTrack3[] = { 
-    kParamTrack3Run, kParamTrack3Length, kParamTrack3Direction, kParamTrack3ClockDiv, kParamTrack3Swing,
-    kParamTrack3SplitPoint, kParamTrack3Section1Reps, kParamTrack3Section2Reps, kParamTrack3FillStart, 0 
-};
-static uint8_t paramPageTrack4[] = { 
-    kParamTrack4Run, kParamTrack4Length, kParamTrack4Direction, kParamTrack4ClockDiv, kParamTrack4Swing,
-    kParamTrack4SplitPoint, kParamTrack4Section1Reps, kParamTrack4Section2Reps, kParamTrack4FillStart, 0 
-};
-static uint8_t paramPageTrack5[] = { 
-    kParamTrack5Run, kParamTrack5Length, kParamTrack5Direction, kParamTrack5ClockDiv, kParamTrack5Swing,
-    kParamTrack5SplitPoint, kParamTrack5Section1Reps, kParamTrack5Section2Reps, kParamTrack5FillStart, 0 
-};
-static uint8_t paramPageTrack6[] = { 
-    kParamTrack6Run, kParamTrack6Length, kParamTrack6Direction, kParamTrack6ClockDiv, kParamTrack6Swing,
-    kParamTrack6SplitPoint, kParamTrack6Section1Reps, kParamTrack6Section2Reps, kParamTrack6FillStart, 0 
-};
-
-static _NT_parameterPage pageArray[] = {
-    { .name = "Clock", .numParams = 2, .params = paramPageClock },
-    { .name = "Routing", .numParams = 6, .params = paramPageRouting },
-    { .name = "Track 1", .numParams = 9, .params = paramPageTrack1 },
-    { .name = "Track 2", .numParams = 9, .params = paramPageTrack2 },
-    { .name = "Track 3", .numParams = 9, .params = paramPageTrack3 },
-    { .name = "Track 4", .numParams = 9, .params = paramPageTrack4 },
-    { .name = "Track 5", .numParams = 9, .params = paramPageTrack5 },
-    { .name = "Track 6", .numParams = 9, .params = paramPageTrack6 }
-};
+static uint8_t paramPageClock[] = { kParamClockIn, kParamResetIn, kParamClockSource, 0 };
+static uint8_t paramPageInternalClock[] = { kParamInternalClock, kParamBpm, kParamPpqn, kParamTakeover, kParamClockOut, 0 };
+static uint8_t paramPageRandom[] = { kParamSeed, 0 };
+static uint8_t paramPageRouting[kMaxTracks];
+static uint8_t paramPageTracks[kMaxTracks][12];
 
-static _NT_parameterPages pages = {
-    .numPages = 8,
-    .pages = pageArray
-};
+// Pages live in the algorithm, since the number of tracks differs per instance
+void initPages(VTrig* alg) {
+    for (int track = 0; track < kMaxTracks; track++) {
+        paramPageRouting[track] = (uint8_t)trackOutParam(track);
+        for (int i = 0; i < 9; i++) {
+            paramPageTracks[track][i] = (uint8_t)trackParam(track, kParamTrack1Run + i);
+        }
+        for (int i = 0; i < 3; i++) {
+            paramPageTracks[track][9 + i] = (uint8_t)trackParam(track, kParamTrack1EuclidHits + i);
+        }
+        snprintf(trackPageNames[track], sizeof(trackPageNames[track]), "Track %d", track + 1);
+    }
+    
+    static const char* const fixedNames[] = { "Clock", "Internal Clock", "Probability", "Routing" };
+    static const uint8_t* const fixedParams[] = { paramPageClock, paramPageInternalClock, paramPageRandom, paramPageRouting };
+    static const int fixedCounts[] = { 3, 5, 1, 0 };
+    
+    for (int i = 0; i < 4 + alg->numTracks; i++) {
+        _NT_parameterPage& page = alg->pageArray[i];
+        memset(&page, 0, sizeof(page));
+        if (i < 4) {
+            page.name = fixedNames[i];
+            page.numParams = (i == 3) ? alg->numTracks : fixedCounts[i];
+            page.params = fixedParams[i];
+        } else {
+            page.name = trackPageNames[i - 4];
+            page.numParams = 12;
+            page.params = paramPageTracks[i - 4];
+        }
+    }
+    
+    // Modulation page; its parameters move with the track count
+    for (int i = 0; i < kNumModInputs * 4; i++) {
+        alg->modPageParams[i] = (uint8_t)(alg->modBase + i);
+    }
+    _NT_parameterPage& modPage = alg->pageArray[4 + alg->numTracks];
+    memset(&modPage, 0, sizeof(modPage));
+    modPage.name = "Modulation";
+    modPage.numParams = kNumModInputs * 4;
+    modPage.params = alg->modPageParams;
+    
+    // MIDI page after it
+    for (int i = 0; i < kMidiNote1 + alg->numTracks; i++) {
+        alg->midiPageParams[i] = (uint8_t)(alg->midiBase + i);
+    }
+    _NT_parameterPage& midiPage = alg->pageArray[5 + alg->numTracks];
+    memset(&midiPage, 0, sizeof(midiPage));
+    midiPage.name = "MIDI";
+    midiPage.numParams = kMidiNote1 + alg->numTracks;
+    midiPage.params = alg->midiPageParams;
+    
+    alg->pages.numPages = 6 + alg->numTracks;
+    alg->pages.pages = alg->pageArray;
+}
 
 // =============================================================================
 // Construction
 // =============================================================================
 
-void calculateRequirements(_NT_algorithmRequirements& req, const int32_t*) {
-    req.numParameters = kNumParameters;
-    req.sram = sizeof(VTrig);
+// Tracks specification, clamped to what the parameter layout supports
+static int specTracks(const int32_t* specs) {
+    int n = (specs != NULL) ? specs[0] : kDefaultTracks;
+    if (n < kDefaultTracks) n = kDefaultTracks;
+    if (n > kMaxTracks) n = kMaxTracks;
+    return n;
 }
 
-_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t*) {
-    VTrig* alg = new (ptrs.sram) VTrig();
+// Max Steps specification, clamped to what the step storage supports
+static int specSteps(const int32_t* specs) {
+    int n = (specs != NULL) ? specs[1] : kMinSteps;
+    if (n < kMinSteps) n = kMinSteps;
+    if (n > kMaxSteps) n = kMaxSteps;
+    return n;
+}
+
+void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specs) {
+    int n = specTracks(specs);
+    req.numParameters = numParametersFor(n);
+    // Object, track states, then the instance's parameter table
+    req.sram = sizeof(VTrig) + (n * sizeof(TrackState)) + (numParametersFor(n) * sizeof(_NT_parameter));
+    req.dram = StepMemory::bytesFor(n, specSteps(specs));
+}
+
+_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t* specs) {
+    int n = specTracks(specs);
+    int steps = specSteps(specs);
+    VTrig* alg = new (ptrs.sram) VTrig(n, (TrackState*)(ptrs.sram + sizeof(VTrig)), steps, StepMemory(ptrs.dram, n, steps));
     initParameters(alg);
-    alg->parameterPages = &pages;
+    initPages(alg);
+    alg->parameterPages = &alg->pages;
     return alg;
 }
 
@@ -436,41 +1072,75 @@ _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorith
 // Stub functions for Phase 1 - will implement in later phases
 // =============================================================================
 
+// The pass that ends in the fill jump: the last Section 1 repeat, going forward,
+// with the fill enabled (mirrors the fill test in walkTrack)
+static inline bool isFillPass(const TrackState& t, int direction, int trackLength, int splitPoint,
+                              int sec1Reps, int fillStart) {
+    return direction == 0 && !t.inSection2 &&
+           splitPoint > 0 && splitPoint < trackLength &&
+           fillStart > 0 && fillStart < splitPoint &&
+           sec1Reps > 1 && t.section1Counter == sec1Reps - 1;
+}
+
+// Advance a track and keep positionMask and the pass conditions in sync
 void VTrig::advanceTrack(int track, int direction, int trackLength, int splitPoint, 
                          int sec1Reps, int sec2Reps, int fillStart) {
+    int from = tracks[track].currentStep;
+    bool wrapped = walkTrack(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
+    int to = tracks[track].currentStep;
+    tracks[track].currentStep = from;
+    moveTo(track, to);
+    
+    if (wrapped) {
+        startPass(track, tracks[track].passCount + 1,
+                  isFillPass(tracks[track], direction, trackLength, splitPoint, sec1Reps, fillStart));
+    }
+}
+
+// One step of a track's playback state. Leaves positionMask alone, so
+// peekNextStep can use it to look ahead. Returns true when a pass ended and a
+// new one started (wrap, section repeat, section change, fill jump or pingpong turn).
+bool VTrig::walkTrack(int track, int direction, int trackLength, int splitPoint, 
+                      int sec1Reps, int sec2Reps, int fillStart) {
+    TrackState& t = tracks[track];
+    bool wrapped = false;
     // If no sections (splitPoint >= trackLength), use simple wrapping logic
     if (splitPoint >= trackLength) {
         if (direction == 0) {
             // Forward
-            currentStep[track]++;
-            if (currentStep[track] >= trackLength) {
-                currentStep[track] = 0;
+            t.currentStep++;
+            if (t.currentStep >= trackLength) {
+                t.currentStep = 0;
+                wrapped = true;
             }
         } else if (direction == 1) {
             // Backward
-            currentStep[track]--;
-            if (currentStep[track] < 0) {
-                currentStep[track] = trackLength - 1;
+            t.currentStep--;
+            if (t.currentStep < 0) {
+                t.currentStep = trackLength - 1;
+                wrapped = true;
             }
         } else if (direction == 2) {
             // Pingpong
-            if (pingpongForward[track]) {
-                currentStep[track]++;
-                if (currentStep[track] >= trackLength) {
-                    currentStep[track] = trackLength - 2;
-                    if (currentStep[track] < 0) currentStep[track] = 0;
-                    pingpongForward[track] = false;
+            if (t.pingpongForward) {
+                t.currentStep++;
+                if (t.currentStep >= trackLength) {
+                    t.currentStep = trackLength - 2;
+                    if (t.currentStep < 0) t.currentStep = 0;
+                    t.pingpongForward = false;
+                    wrapped = true;
                 }
             } else {
-                currentStep[track]--;
-                if (currentStep[track] < 0) {
-                    currentStep[track] = 1;
-                    if (currentStep[track] >= trackLength) currentStep[track] = trackLength - 1;
-                    pingpongForward[track] = true;
+                t.currentStep--;
+                if (t.currentStep < 0) {
+                    t.currentStep = 1;
+                    if (t.currentStep >= trackLength) t.currentStep = trackLength - 1;
+                    t.pingpongForward = true;
+                    wrapped = true;
                 }
             }
         }
-        return;
+        return wrapped;
     }
     
     // Section-based logic
@@ -478,274 +1148,839 @@ void VTrig::advanceTrack(int track, int direction, int trackLength, int splitPoi
     int section1End = (splitPoint > 0 && splitPoint < trackLength) ? splitPoint : trackLength;
     
     if (direction == 0) {  // Forward
-        currentStep[track]++;
+        t.currentStep++;
         
         // Check for fill trigger on last repetition of section 1
         // Only if sections are enabled (splitPoint < trackLength) AND fill is enabled (fillStart > 0)
         // AND we're actually repeating section 1 (sec1Reps > 1)
-        if (!inSection2[track] && 
+        if (!t.inSection2 && 
             splitPoint > 0 && 
             splitPoint < trackLength &&
             fillStart > 0 &&
             fillStart < splitPoint &&
             sec1Reps > 1 &&
-            section1Counter[track] == sec1Reps - 1 &&
-            currentStep[track] >= fillStart) {
+            t.section1Counter == sec1Reps - 1 &&
+            t.currentStep >= fillStart) {
             // Fill triggered! Jump to section 2
-            section1Counter[track] = 0;
-            inSection2[track] = true;
-            currentStep[track] = splitPoint;
+            t.section1Counter = 0;
+            t.inSection2 = true;
+            t.currentStep = splitPoint;
+            wrapped = true;
         }
         // Check if we've crossed a section boundary
-        else if (!inSection2[track] && currentStep[track] >= section1End) {
+        else if (!t.inSection2 && t.currentStep >= section1End) {
             // Completed section 1
-            section1Counter[track]++;
-            if (section1Counter[track] >= sec1Reps) {
+            wrapped = true;
+            t.section1Counter++;
+            if (t.section1Counter >= sec1Reps) {
                 // Move to section 2
-                section1Counter[track] = 0;
-                inSection2[track] = true;
+                t.section1Counter = 0;
+                t.inSection2 = true;
                 if (splitPoint > 0) {
-                    currentStep[track] = splitPoint;
+                    t.currentStep = splitPoint;
                 } else {
-                    currentStep[track] = 0;
+                    t.currentStep = 0;
                 }
             } else {
                 // Repeat section 1
-                currentStep[track] = 0;
+                t.currentStep = 0;
             }
-        } else if (inSection2[track] && currentStep[track] >= trackLength) {
+        } else if (t.inSection2 && t.currentStep >= trackLength) {
             // Completed section 2
-            section2Counter[track]++;
-            if (section2Counter[track] >= sec2Reps) {
+            wrapped = true;
+            t.section2Counter++;
+            if (t.section2Counter >= sec2Reps) {
                 // Back to section 1
-                section2Counter[track] = 0;
-                inSection2[track] = false;
+                t.section2Counter = 0;
+                t.inSection2 = false;
             }
-            currentStep[track] = (splitPoint > 0) ? splitPoint : 0;
-            if (!inSection2[track]) {
-                currentStep[track] = 0;
+            t.currentStep = (splitPoint > 0) ? splitPoint : 0;
+            if (!t.inSection2) {
+                t.currentStep = 0;
             }
         }
     } else if (direction == 1) {  // Backward
-        currentStep[track]--;
-        
-        if (inSection2[track] && currentStep[track] < splitPoint) {
-            section2Counter[track]++;
-            if (section2Counter[track] >= sec2Reps) {
-                section2Counter[track] = 0;
-                inSection2[track] = false;
-                currentStep[track] = section1End - 1;
+        t.currentStep--;
+        
+        if (t.inSection2 && t.currentStep < splitPoint) {
+            wrapped = true;
+            t.section2Counter++;
+            if (t.section2Counter >= sec2Reps) {
+                t.section2Counter = 0;
+                t.inSection2 = false;
+                t.currentStep = section1End - 1;
             } else {
-                currentStep[track] = trackLength - 1;
+                t.currentStep = trackLength - 1;
             }
-        } else if (!inSection2[track] && currentStep[track] < 0) {
-            section1Counter[track]++;
-            if (section1Counter[track] >= sec1Reps) {
-                section1Counter[track] = 0;
-                inSection2[track] = true;
-                currentStep[track] = trackLength - 1;
+        } else if (!t.inSection2 && t.currentStep < 0) {
+            wrapped = true;
+            t.section1Counter++;
+            if (t.section1Counter >= sec1Reps) {
+                t.section1Counter = 0;
+                t.inSection2 = true;
+                t.currentStep = trackLength - 1;
             } else {
-                currentStep[track] = section1End - 1;
+                t.currentStep = section1End - 1;
             }
         }
     } else if (direction == 2) {  // Pingpong
-        if (pingpongForward[track]) {
-            currentStep[track]++;
-            if (currentStep[track] >= trackLength) {
-                currentStep[track] = trackLength - 2;
-                if (currentStep[track] < 0) currentStep[track] = 0;
-                pingpongForward[track] = false;
+        if (t.pingpongForward) {
+            t.currentStep++;
+            if (t.currentStep >= trackLength) {
+                t.currentStep = trackLength - 2;
+                if (t.currentStep < 0) t.currentStep = 0;
+                t.pingpongForward = false;
+                wrapped = true;
             }
         } else {
-            currentStep[track]--;
-            if (currentStep[track] < 0) {
-                currentStep[track] = 1;
-                if (currentStep[track] >= trackLength) currentStep[track] = trackLength - 1;
-                pingpongForward[track] = true;
+            t.currentStep--;
+            if (t.currentStep < 0) {
+                t.currentStep = 1;
+                if (t.currentStep >= trackLength) t.currentStep = trackLength - 1;
+                t.pingpongForward = true;
+                wrapped = true;
             }
         }
     }
+    return wrapped;
+}
+
+void VTrig::resetTrack(int track) {
+    TrackState& t = tracks[track];
+    moveTo(track, 0);
+    t.pingpongForward = true;
+    t.section1Counter = 0;
+    t.section2Counter = 0;
+    t.inSection2 = false;
+    t.pendingHits = 0;
+    t.earlyStep = -1;
+    t.hitsLeft = 0;
+    
+    // Same seed, same rolls from the top of the pattern
+    t.rng.seed((uint32_t)v[kParamSeed], (uint32_t)track);
+    
+    // Conditions count passes from here (a single Section 1 pass cannot be the fill)
+    startPass(track, 0, false);
+}
+
+// Where the track will be after its next advance, without moving it.
+// walkTrack only touches these five fields, so save and put them back.
+// nextConds gets the conditions of the pass that step belongs to.
+int VTrig::peekNextStep(int track, int direction, int trackLength, int splitPoint,
+                        int sec1Reps, int sec2Reps, int fillStart, uint64_t& nextConds) {
+    TrackState& t = tracks[track];
+    int savedStep = t.currentStep;
+    bool savedForward = t.pingpongForward;
+    int savedSec1 = t.section1Counter;
+    int savedSec2 = t.section2Counter;
+    bool savedInSec2 = t.inSection2;
+    
+    bool wrapped = walkTrack(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
+    int next = t.currentStep;
+    nextConds = wrapped ? conditionsFor(t.passCount + 1,
+                                        isFillPass(t, direction, trackLength, splitPoint, sec1Reps, fillStart))
+                        : t.passConds;
+    
+    t.currentStep = savedStep;
+    t.pingpongForward = savedForward;
+    t.section1Counter = savedSec1;
+    t.section2Counter = savedSec2;
+    t.inSection2 = savedInSec2;
+    return next;
+}
+
+// Roll a step and, if it plays, schedule its hits base + swing + nudge samples
+// after this tick. step() has rendered the outputs up to the tick's frame, so
+// the delay counts from the tick itself: base is 0 for the step that just came
+// up and one step length for an early-nudged step scheduled a step ahead. gate
+// comes from the tick's trigger word; swingDelay is what swing adds to an
+// odd-numbered step.
+void VTrig::playStep(int track, int step, bool gate, int stepLen, int swingDelay, int base) {
+    TrackState& t = tracks[track];
+    // One roll per step, used or not, so the random stream stays on the step
+    // grid and editing one step does not change the rolls of the others
+    uint32_t roll = t.rng.next();
+    
+    if (!gate || step < 0 || step >= maxSteps) return;
+    uint16_t attr = t.stepAttr[step];
+    
+    // Probability: scale the roll to 0-99 with a multiply (constant time)
+    int chance = (int)(((roll >> 16) * 100u) >> 16);
+    if (chance >= stepProbability(attr)) return;
+    
+    // Ratchets split the step evenly, from the measured clock period
+    int ratchets = stepRatchets(attr);
+    int spacing = stepLen / ratchets;
+    
+    int delay = base;
+    
+    // Apply swing: delay odd-numbered steps by a percentage of half the clock period
+    if ((step % 2) == 1) {
+        delay += swingDelay;
+    }
+    
+    // Nudge, in 64ths of the step length (negative = early)
+    delay += (stepNudge(attr) * stepLen) / 64;
+    if (delay < 0) delay = 0;
+    
+    // Accented generated hits fire at 10V instead of 5V
+    float level = ((accentColumns[step] >> track) & 1u) ? 10.0f : 5.0f;
+    
+    if (base > 0) {
+        t.pendingHits = ratchets;
+        t.pendingSpacing = spacing;
+        t.pendingCountdown = delay;
+        t.pendingLevel = level;
+    } else {
+        startHits(track, ratchets, spacing, delay, level);
+    }
+}
+
+// Fire a step's hits: the first after delay samples, ratchets evenly spaced after it
+void VTrig::startHits(int track, int count, int spacing, int delay, float level) {
+    TrackState& t = tracks[track];
+    t.hitsLeft = count;
+    t.hitLevel = level;
+    t.hitSpacing = spacing;
+    t.hitCountdown = delay;
+    
+    // Keep a gap between ratchet hits so each one is a separate edge
+    t.hitLength = 240;  // ~5ms at 48kHz
+    if (count > 1 && t.hitLength > spacing / 2) {
+        t.hitLength = spacing / 2;
+    }
+    if (t.hitLength < 1) t.hitLength = 1;
+}
+
+// Move the tracks in steppedMask on by one step, then roll and schedule the
+// step each one lands on. Called on a tick's frame, with the outputs rendered
+// up to it.
+void VTrig::stepTracks(uint32_t steppedMask) {
+    // Move the stepped tracks
+    for (uint32_t m = steppedMask; m; m &= m - 1) {
+        int track = __builtin_ctz(m);
+        advanceTrack(track, played(trackParam(track, kParamTrack1Direction)),
+                     played(trackParam(track, kParamTrack1Length)), v[trackParam(track, kParamTrack1SplitPoint)],
+                     v[trackParam(track, kParamTrack1Section1Reps)], v[trackParam(track, kParamTrack1Section2Reps)],
+                     v[trackParam(track, kParamTrack1FillStart)]);
+    }
+    
+    // This tick's trigger word: bit t set = stepped track t landed on a gate
+    // whose condition holds on this pass. Tracks sitting on the same step are
+    // resolved together with one AND of that step's columns against the positions.
+    uint32_t gateMask = 0;
+    uint32_t remaining = steppedMask;
+    while (remaining) {
+        int s = tracks[__builtin_ctz(remaining)].currentStep;
+        uint32_t here = (s >= 0 && s < maxSteps) ? (positionMask[s] & remaining) : (remaining & -remaining);
+        if (s >= 0 && s < maxSteps) gateMask |= gateColumn(s) & activeColumns[s] & here;
+        remaining &= ~here;
+    }
+    
+    // Roll and schedule each stepped track's step
+    for (uint32_t m = steppedMask; m; m &= m - 1) {
+        int track = __builtin_ctz(m);
+        TrackState& t = tracks[track];
+        int clockDiv = played(trackParam(track, kParamTrack1ClockDiv));
+        int lastClockPeriod = ratios[clockDiv].lastClockPeriod;
+        int divisor = (clockDiv < 15) ? 16 - clockDiv : 1;
+        int multiplier = (clockDiv < 15) ? 1 : clockDiv - 14;
+        int swing = played(trackParam(track, kParamTrack1Swing));
+        
+        int currentStep = t.currentStep;
+        int stepLen = (clockDiv < 15) ? lastClockPeriod * divisor : lastClockPeriod / multiplier;
+        int swingDelay = (swing > 0 && lastClockPeriod > 0) ? (lastClockPeriod * swing) / 200 : 0;
+        
+        if (t.earlyStep >= 0 && currentStep == t.earlyStep) {
+            // Already rolled and scheduled from the previous tick
+        } else {
+            // The lookahead guessed wrong (direction or length changed): drop its hit
+            if (t.earlyStep >= 0) t.pendingHits = 0;
+            playStep(track, currentStep, (gateMask >> track) & 1u, stepLen, swingDelay, 0);
+        }
+        t.earlyStep = -1;
+        
+        // A step nudged early plays before its own tick, so schedule it from
+        // this one, using the measured step length as the lookahead. Its condition
+        // is tested against the pass it will play in, which may be the next one.
+        uint64_t nextConds;
+        int nextStep = peekNextStep(track, played(trackParam(track, kParamTrack1Direction)),
+                                    played(trackParam(track, kParamTrack1Length)), v[trackParam(track, kParamTrack1SplitPoint)],
+                                    v[trackParam(track, kParamTrack1Section1Reps)], v[trackParam(track, kParamTrack1Section2Reps)],
+                                    v[trackParam(track, kParamTrack1FillStart)], nextConds);
+        if (nextStep >= 0 && nextStep < maxSteps && hasGate(track, nextStep) &&
+            stepNudge(t.stepAttr[nextStep]) < 0 && ((nextConds >> t.stepCond[nextStep]) & 1u)) {
+            t.earlyStep = nextStep;
+            playStep(track, nextStep, true, stepLen, swingDelay, stepLen);
+        }
+    }
 }
 
+// Render trigger pulses frame by frame over [fromFrame, toFrame), so ratchet
+// hits land on their exact sample. Only tracks with something to fire need the
+// per-frame walk; the rest just hold 0V.
+void VTrig::renderTracks(float* busFrames, int numFrames, uint32_t runningMask, int fromFrame, int toFrame) {
+    if (toFrame <= fromFrame) return;
+    for (uint32_t m = runningMask; m; m &= m - 1) {
+        int track = __builtin_ctz(m);
+        TrackState& t = tracks[track];
+        int outputBus = v[trackOutParam(track)];
+        float* outBus = (outputBus > 0 && outputBus <= 28) ? busFrames + ((outputBus - 1) * numFrames) : NULL;
+        
+        if (t.idle()) {
+            if (outBus) {
+                for (int frame = fromFrame; frame < toFrame; frame++) outBus[frame] = 0.0f;
+            }
+            continue;
+        }
+        
+        for (int frame = fromFrame; frame < toFrame; frame++) {
+            if (t.pendingHits > 0) {
+                if (t.pendingCountdown <= 0) {
+                    startHits(track, t.pendingHits, t.pendingSpacing, 0, t.pendingLevel);
+                    t.pendingHits = 0;
+                } else {
+                    t.pendingCountdown--;
+                }
+            }
+            if (t.hitsLeft > 0) {
+                if (t.hitCountdown <= 0) {
+                    noteOn(track, frame, t.hitLevel);
+                    t.triggerCounter = t.hitLength;
+                    t.hitsLeft--;
+                    t.hitCountdown = t.hitSpacing;
+                }
+                t.hitCountdown--;
+            }
+            if (outBus) {
+                outBus[frame] = (t.triggerCounter > 0) ? t.hitLevel : 0.0f;  // 5V trigger, 10V accent
+            }
+            if (t.triggerCounter > 0) {
+                t.triggerCounter--;
+                if (t.triggerCounter == 0 && t.midiNote >= 0) noteOff(track, frame + 1);  // Pulse ends
+            }
+        }
+    }
+}
+
+// Rebuild a track's generated steps from its Euclid parameters. Runs once per
+// parameter change (from step(), see euclidDirty), never per tick.
+void VTrig::regenerate(int track) {
+    uint32_t bit = 1u << track;
+    int hits = v[trackParam(track, kParamTrack1EuclidHits)];
+    int length = v[trackParam(track, kParamTrack1Length)];
+    if (length > maxSteps) length = maxSteps;
+    
+    StepBits pattern, accents;
+    pattern.clear();
+    accents.clear();
+    if (hits > 0) {
+        euclidPattern(pattern, hits, length);
+        
+        // Accents are a second Euclidean pattern laid over the hits in order
+        int accentHits = v[trackParam(track, kParamTrack1EuclidAccent)];
+        if (accentHits > 0) {
+            StepBits accentPattern;
+            euclidPattern(accentPattern, accentHits, pattern.count());
+            int k = 0;
+            for (int step = 0; step < length; step++) {
+                if (pattern.get(step) && accentPattern.get(k++)) accents.set(step);
+            }
+        }
+        
+        int rotate = v[trackParam(track, kParamTrack1EuclidRotate)];
+        rotateSteps(pattern, length, rotate);
+        rotateSteps(accents, length, rotate);
+        generatedTracks |= bit;
+    } else {
+        generatedTracks &= ~bit;
+    }
+    
+    for (int step = 0; step < maxSteps; step++) {
+        genColumns[step] = (genColumns[step] & ~bit) | ((uint32_t)pattern.get(step) << track);
+        accentColumns[step] = (accentColumns[step] & ~bit) | ((uint32_t)accents.get(step) << track);
+    }
+}
+
+// UI side: copy a generated pattern into the track's editable steps and turn
+// the generator off. The stored steps match what is playing before Hits goes
+// to 0, so the switch-over is seamless. Steps past the Length are left alone;
+// accents are not kept.
+void VTrig::freezeTrack(int track) {
+    uint32_t bit = 1u << track;
+    if (!(generatedTracks & bit)) return;
+    int length = v[trackParam(track, kParamTrack1Length)];
+    for (int step = 0; step < length && step < maxSteps; step++) {
+        columns[step] = (columns[step] & ~bit) | (genColumns[step] & bit);
+    }
+    NT_setParameterFromUi(NT_algorithmIndex(this), trackParam(track, kParamTrack1EuclidHits) + NT_parameterOffset(), 0);
+}
+
+// =============================================================================
+// MIDI Transport
+// =============================================================================
+
+// MIDI Start: play from the top
+void VTrig::transportStart() {
+    for (int track = 0; track < numTracks; track++) {
+        if (v[trackParam(track, kParamTrack1Run)] == 0) continue;  // Stopped tracks keep their position
+        resetTrack(track);
+        ratios[played(trackParam(track, kParamTrack1ClockDiv))].reset();
+    }
+    midiClock.restart();
+    transportRunning = true;
+}
+
+// MIDI Stop: hold position, drop any delayed or early trigger and pending ratchets
+void VTrig::transportStop() {
+    transportRunning = false;
+    for (int track = 0; track < numTracks; track++) {
+        tracks[track].pendingHits = 0;
+        tracks[track].earlyStep = -1;
+        tracks[track].hitsLeft = 0;
+    }
+}
+
+// MIDI Continue: resume from the current (or seeked) position
+void VTrig::transportContinue() {
+    midiClock.restart();
+    transportRunning = true;
+}
+
+// MIDI Song Position Pointer: position is in 16th notes, one clock pulse each.
+// Each running track is put exactly where it would be after that many pulses
+// from reset, including clock division phase, section repeats and fill.
+void VTrig::seekToPosition(uint32_t position) {
+    midiClock.restart();
+    
+    for (int track = 0; track < numTracks; track++) {
+        if (v[trackParam(track, kParamTrack1Run)] == 0) continue;
+        
+        int clockDiv = played(trackParam(track, kParamTrack1ClockDiv));
+        int divisor = (clockDiv < 15) ? 16 - clockDiv : 1;
+        int multiplier = (clockDiv < 15) ? 1 : clockDiv - 14;
+        
+        resetTrack(track);
+        uint32_t advances = (position / divisor) * multiplier;
+        ratios[clockDiv].reset();
+        ratios[clockDiv].clockCounter = (divisor > 1) ? (int)(position % divisor) : 0;
+        
+        LoopPlan plan;
+        buildTrackLoop(plan, played(trackParam(track, kParamTrack1Direction)), played(trackParam(track, kParamTrack1Length)),
+                       v[trackParam(track, kParamTrack1SplitPoint)], v[trackParam(track, kParamTrack1Section1Reps)],
+                       v[trackParam(track, kParamTrack1Section2Reps)], v[trackParam(track, kParamTrack1FillStart)]);
+        LoopState st = plan.seek(advances);
+        
+        TrackState& t = tracks[track];
+        moveTo(track, st.step);
+        t.section1Counter = st.section1Counter;
+        t.section2Counter = st.section2Counter;
+        t.inSection2 = st.inSection2;
+        t.pingpongForward = st.pingpongForward;
+        startPass(track, st.passes, isFillPass(t, played(trackParam(track, kParamTrack1Direction)),
+                                               played(trackParam(track, kParamTrack1Length)),
+                                               v[trackParam(track, kParamTrack1SplitPoint)],
+                                               v[trackParam(track, kParamTrack1Section1Reps)],
+                                               v[trackParam(track, kParamTrack1FillStart)]));
+    }
+}
+
+// Read the modulation inputs (one mean per block) and fold their offsets into
+// modValues. With no input assigned this is a check per input: played() then
+// reads the parameters directly.
+void VTrig::applyModulation(const float* busFrames, int numFrames) {
+    bool any = false;
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int base = modBase + (mod * 4);
+        int bus = v[base] - 1;
+        if (bus < 0) {
+            mods[mod].offset = 0;
+            continue;
+        }
+        any = true;
+        
+        // Units per volt at 100% depth: the target's whole range over 10V
+        int target = v[base + 1];
+        float range = (target == kModLength) ? (float)(maxSteps - 1) : (target == kModDirection) ? 2.0f :
+                      (target == kModClockDiv) ? 30.0f : 100.0f;
+        float volts = ModInput::mean(busFrames + (bus * numFrames), numFrames);
+        mods[mod].update(volts * range * v[base + 3] / 1000.0f);
+    }
+    if (!any) {
+        modulated = false;
+        return;
+    }
+    
+    memcpy(modValues, v, numParametersFor(numTracks) * sizeof(int16_t));
+    static const int targetParams[kNumModTargets] = {
+        kParamTrack1Length, kParamTrack1Direction, kParamTrack1ClockDiv, kParamTrack1Swing
+    };
+    for (int mod = 0; mod < kNumModInputs; mod++) {
+        int offset = mods[mod].offset;
+        if (offset == 0) continue;
+        int base = modBase + (mod * 4);
+        int target = targetParams[v[base + 1]];
+        int dest = v[base + 2];  // 0 = all, then Track 1-16
+        for (int track = 0; track < numTracks; track++) {
+            if (dest == 0 || dest == track + 1) modulate(trackParam(track, target), offset);
+        }
+    }
+    modulated = true;
+}
+
+// Move one played setting, kept within its parameter's range
+void VTrig::modulate(int p, int offset) {
+    int value = modValues[p] + offset;
+    if (value < parameters[p].min) value = parameters[p].min;
+    if (value > parameters[p].max) value = parameters[p].max;
+    modValues[p] = (int16_t)value;
+}
+
+// Queue a track's note-on for a hit starting on this frame. A hit that lands
+// while the last one is still sounding (a retrigger) closes it first.
+void VTrig::noteOn(int track, int frame, float level) {
+    TrackState& t = tracks[track];
+    if (t.midiNote >= 0) noteOff(track, frame);
+    
+    int channel = v[midiBase + kMidiChannel];  // 0 = off, 1-16 = MIDI channels
+    if (channel == 0 || t.midiNote >= 0 || numMidiHits >= kMaxMidiHits) return;
+    
+    MidiHit& hit = midiHits[numMidiHits++];
+    hit.order = ((uint32_t)frame << 8) | ((uint32_t)track << 1) | 1u;
+    hit.status = (uint8_t)(0x90 | ((channel - 1) & 0x0F));
+    hit.note = (uint8_t)v[midiBase + kMidiNote1 + track];
+    hit.velocity = (uint8_t)v[midiBase + ((level > 5.0f) ? kMidiAccent : kMidiVelocity)];  // 10V = accent
+    
+    t.midiNote = (int8_t)hit.note;
+    t.midiStatus = hit.status;
+    soundingMask |= 1u << track;
+}
+
+// Queue the note-off for a track's sounding note, on the channel it started on.
+// If the queue is full the note stays on and the end of the block tries again.
+void VTrig::noteOff(int track, int frame) {
+    TrackState& t = tracks[track];
+    if (t.midiNote < 0 || numMidiHits >= kMaxMidiHits) return;
+    
+    MidiHit& hit = midiHits[numMidiHits++];
+    hit.order = ((uint32_t)frame << 8) | ((uint32_t)track << 1);
+    hit.status = t.midiStatus;
+    hit.note = (uint8_t)t.midiNote;
+    hit.velocity = 0;  // Note-on velocity 0 = note-off
+    
+    t.midiNote = -1;
+    soundingMask &= ~(1u << track);
+}
+
+// Send the block's queued notes in frame order, tracks in order within a frame.
+// Every note is a complete 3-byte message: USB, Internal and Select Bus carry
+// whole messages, so a status-less 2-byte note (running status) isn't valid there.
+void VTrig::sendMidiHits() {
+    if (numMidiHits == 0) return;
+    
+    // Queued track by track, each in frame order: a short insertion sort merges them
+    for (int i = 1; i < numMidiHits; i++) {
+        MidiHit hit = midiHits[i];
+        int j = i - 1;
+        while (j >= 0 && midiHits[j].order > hit.order) {
+            midiHits[j + 1] = midiHits[j];
+            j--;
+        }
+        midiHits[j + 1] = hit;
+    }
+    
+    uint32_t dest;
+    switch (v[midiBase + kMidiDest]) {
+        case 0: dest = kNT_destinationBreakout; break;
+        case 1: dest = kNT_destinationUSB; break;
+        case 2: dest = kNT_destinationBreakout | kNT_destinationUSB; break;
+        case 3: dest = kNT_destinationInternal; break;
+        case 4: dest = kNT_destinationSelectBus; break;
+        default: dest = kNT_destinationBreakout | kNT_destinationUSB | kNT_destinationInternal | kNT_destinationSelectBus; break;
+    }
+    
+    for (int i = 0; i < numMidiHits; i++) {
+        const MidiHit& hit = midiHits[i];
+        NT_sendMidi3ByteMessage(dest, hit.status, hit.note, hit.velocity);
+    }
+    numMidiHits = 0;
+}
+
+// =============================================================================
+// Audio Processing
+// =============================================================================
+
 void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     VTrig* a = static_cast<VTrig*>(self);
     int numFrames = numFramesBy4 * 4;
     
+    // Euclidean tracks whose parameters changed since the last block
+    uint32_t dirty = __atomic_exchange_n(&a->euclidDirty, 0u, __ATOMIC_ACQUIRE);
+    for (; dirty; dirty &= dirty - 1) {
+        int track = __builtin_ctz(dirty);
+        if (track < a->numTracks) a->regenerate(track);
+    }
+    
+    // Tracks whose trig conditions were edited or loaded since the last block
+    dirty = __atomic_exchange_n(&a->condDirty, 0u, __ATOMIC_ACQUIRE);
+    for (; dirty; dirty &= dirty - 1) {
+        int track = __builtin_ctz(dirty);
+        if (track < a->numTracks) a->refreshActive(track);
+    }
+    
+    // Modulation inputs, read before any track moves this block
+    a->applyModulation(busFrames, numFrames);
+    
     // Read clock and reset inputs
     int clockInput = self->v[kParamClockIn];     // 0 = none, 1-28 = bus
     int resetInput = self->v[kParamResetIn];     // 0 = none, 1-28 = bus
     
-    float clockIn = 0.0f;
     float resetIn = 0.0f;
     
-    if (clockInput > 0 && clockInput <= 28) {
-        float* clockBus = busFrames + ((clockInput - 1) * numFrames);
-        clockIn = clockBus[0];  // Sample first frame
-    }
-    
     if (resetInput > 0 && resetInput <= 28) {
         float* resetBus = busFrames + ((resetInput - 1) * numFrames);
         resetIn = resetBus[0];  // Sample first frame
     }
     
-    // Detect clock and reset edges (rising edge = > 2.5V)
-    bool clockTrig = (clockIn > 2.5f && a->lastClockIn <= 2.5f);
+    // Clock edges (rising edge = > 2.5V), each on its exact frame so the tracks
+    // step at the edge rather than at the block start
+    int tickFrames[kMaxTicks];
+    int numTicks = 0;
+    if (clockInput > 0 && clockInput <= 28) {
+        numTicks = findClockEdges(busFrames + ((clockInput - 1) * numFrames), numFrames, 2.5f, a->lastClockIn,
+                                  tickFrames, kMaxTicks);
+    }
     bool resetTrig = (resetIn > 2.5f && a->lastResetIn <= 2.5f);
     
-    a->lastClockIn = clockIn;
     a->lastResetIn = resetIn;
     
-    // Process each track
-    for (int track = 0; track < 6; track++) {
-        int outParam = kParamTrack1Out + track;
-        int runParam = kParamTrack1Run + (track * 9);
-        int lenParam = kParamTrack1Length + (track * 9);
-        int dirParam = kParamTrack1Direction + (track * 9);
-        int divParam = kParamTrack1ClockDiv + (track * 9);
-        int swingParam = kParamTrack1Swing + (track * 9);
-        int splitParam = kParamTrack1SplitPoint + (track * 9);
-        int sec1Param = kParamTrack1Section1Reps + (track * 9);
-        int sec2Param = kParamTrack1Section2Reps + (track * 9);
-        int fillParam = kParamTrack1FillStart + (track * 9);
-        
-        int outputBus = self->v[outParam];
-        int isRunning = self->v[runParam];
-        int trackLength = self->v[lenParam];
-        int direction = self->v[dirParam];
-        int clockDiv = self->v[divParam];
-        int swing = self->v[swingParam];
-        int splitPoint = self->v[splitParam];
-        int sec1Reps = self->v[sec1Param];
-        int sec2Reps = self->v[sec2Param];
-        int fillStart = self->v[fillParam];
-        
-        // Map clockDiv parameter to divisor/multiplier
-        int divisor = 1;
-        int multiplier = 1;
-        bool isDivision = (clockDiv < 15);
-        
-        if (isDivision) {
-            divisor = 16 - clockDiv;
+    // Clock source: 0=CV, 1=MIDI, 2=CV+MIDI (MIDI pulses count in blocks with no CV edge)
+    // MIDI ticks are always drained; each pulse is a tick on its own frame
+    int clockSource = self->v[kParamClockSource];
+    int pulseFrames[kMaxTicks];
+    int numPulses = a->midiClock.process(numFrames, pulseFrames, kMaxTicks);
+    if (clockSource == 0 || !a->transportRunning) numPulses = 0;
+    if (clockSource == 1) numTicks = 0;
+    bool midiPulse = false;
+    if (numPulses > 0 && numTicks == 0) {
+        for (int i = 0; i < numPulses; i++) tickFrames[i] = pulseFrames[i];
+        numTicks = numPulses;
+        midiPulse = true;
+    }
+    
+    // Int Clock: 0=Off, 1=Auto, 2=On (On ignores the external clock entirely)
+    int internalMode = self->v[kParamInternalClock];
+    if (internalMode == 2) {
+        numTicks = 0;
+        midiPulse = false;
+    }
+    bool clockTrig = (numTicks > 0);
+    if (clockTrig) {
+        uint32_t sinceLast = (a->sampleTime + tickFrames[0]) - a->lastExternalTime;
+        if (numTicks > 1) sinceLast = tickFrames[numTicks - 1] - tickFrames[numTicks - 2];
+        if ((a->externalSeen || numTicks > 1) && sinceLast > 100 && sinceLast < 96000) {
+            a->externalPeriod = (int)sinceLast;
+        }
+        if (midiPulse) {
+            a->externalPeriod = a->midiClock.pulsePeriod();
+        }
+        a->lastExternalTime = a->sampleTime + tickFrames[numTicks - 1];
+        a->externalSeen = true;
+    }
+    
+    // Internal clock: always when On; when Auto, from the moment the external clock
+    // has been missing for "Takeover" periods (or has never arrived) until it returns
+    bool useInternal = (internalMode == 2);
+    int firstFrame = 0;
+    if (internalMode == 1 && !clockTrig) {
+        if (a->internalClock.active || !a->externalSeen) {
+            useInternal = true;
         } else {
-            multiplier = clockDiv - 14;
+            uint32_t deadline = a->lastExternalTime + (uint32_t)(self->v[kParamTakeover] * a->externalPeriod);
+            if ((int32_t)(a->sampleTime + numFrames - deadline) > 0) {
+                useInternal = true;
+                firstFrame = (int32_t)(deadline - a->sampleTime) > 0 ? (int)(deadline - a->sampleTime) : 0;
+            }
         }
-        
-        // Skip if not running
-        if (isRunning == 0) continue;
-        
-        // Reset handling
-        if (resetTrig) {
-            a->currentStep[track] = 0;
-            a->pingpongForward[track] = true;
-            a->swingCounter[track] = 0;
-            a->section1Counter[track] = 0;
-            a->section2Counter[track] = 0;
-            a->inSection2[track] = false;
-            a->inFill[track] = false;
-            a->clockCounter[track] = 0;
-            a->internalClockCounter[track] = 0;
-            a->samplesSinceLastClock[track] = 0;
+    }
+    int internalFrames[kMaxTicks];
+    int numInternal = 0;
+    if (useInternal) {
+        if (!a->internalClock.active) {
+            a->internalClock.startAt(firstFrame, self->v[kParamBpm], self->v[kParamPpqn]);
         }
-        
-        // Track samples for multiplication
-        a->samplesSinceLastClock[track] += numFrames;
-        
-        // Clock handling with division/multiplication
-        bool stepped = false;
-        if (clockTrig) {
+        numInternal = a->internalClock.process(numFrames, self->v[kParamBpm], self->v[kParamPpqn],
+                                               internalFrames, kMaxTicks);
+    }
+    a->internalClock.active = useInternal;
+    
+    // Internal pulses only run with no external tick in the block: each is a tick
+    bool internalPulse = (numInternal > 0);
+    if (internalPulse) {
+        for (int i = 0; i < numInternal; i++) tickFrames[i] = internalFrames[i];
+        numTicks = numInternal;
+        clockTrig = true;
+    }
+    
+    // Group the running tracks by clock ratio: bit t of ratioTracks[r] = track t
+    // runs on Clock Div setting r
+    uint32_t ratioTracks[kNumClockRatios];
+    for (int r = 0; r < kNumClockRatios; r++) ratioTracks[r] = 0;
+    uint32_t runningMask = 0;
+    for (int track = 0; track < a->numTracks; track++) {
+        if (self->v[trackParam(track, kParamTrack1Run)] == 0) continue;  // Skip if not running
+        runningMask |= 1u << track;
+        ratioTracks[a->played(trackParam(track, kParamTrack1ClockDiv))] |= 1u << track;
+    }
+    
+    // Reset handling
+    if (resetTrig) {
+        for (uint32_t m = runningMask; m; m &= m - 1) {
+            a->resetTrack(__builtin_ctz(m));
+        }
+        for (int r = 0; r < kNumClockRatios; r++) {
+            if (ratioTracks[r]) a->ratios[r].reset();
+        }
+    }
+    
+    // Clock handling with division/multiplication, one tick at a time and once
+    // per ratio in use. Every track on a ratio that steps on a tick gets its bit
+    // in steppedMask; the outputs are rendered up to the tick's frame before the
+    // tracks move, so each step starts on its tick.
+    for (int r = 0; r < kNumClockRatios; r++) {
+        if (ratioTracks[r]) a->ratios[r].samplesSinceLastClock += numFrames;  // As of the end of the block
+    }
+    int segmentStart = 0;
+    for (int tick = 0; tick < numTicks; tick++) {
+        int frame = tickFrames[tick];
+        uint32_t steppedMask = 0;
+        for (int r = 0; r < kNumClockRatios; r++) {
+            if (ratioTracks[r] == 0) continue;
+            ClockRatio& ratio = a->ratios[r];
+            
             // Measure clock period for multiplication
-            if (a->samplesSinceLastClock[track] > 100 && a->samplesSinceLastClock[track] < 96000) {
-                a->lastClockPeriod[track] = a->samplesSinceLastClock[track];
+            int sinceClock = ratio.samplesSinceLastClock - (numFrames - frame);
+            if (sinceClock > 100 && sinceClock < 96000) {
+                ratio.lastClockPeriod = sinceClock;
+            }
+            if (midiPulse) {
+                ratio.lastClockPeriod = a->midiClock.pulsePeriod();  // PLL tempo, not block-quantized spacing
+            }
+            if (internalPulse) {
+                ratio.lastClockPeriod = (int)(InternalClock::period(self->v[kParamBpm], self->v[kParamPpqn]) + 0.5);
             }
-            a->samplesSinceLastClock[track] = 0;
-            a->internalClockCounter[track] = 0;
+            ratio.samplesSinceLastClock = numFrames - frame;
+            ratio.internalClockCounter = 0;
             
-            if (isDivision) {
+            if (r < 15) {
                 // Division: count clocks before advancing
-                a->clockCounter[track]++;
-                if (a->clockCounter[track] >= divisor) {
-                    a->clockCounter[track] = 0;
-                    a->advanceTrack(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
-                    stepped = true;
+                ratio.clockCounter++;
+                if (ratio.clockCounter >= 16 - r) {
+                    ratio.clockCounter = 0;
+                    steppedMask |= ratioTracks[r];
                 }
             } else {
                 // Multiplication: step on external clock
-                a->advanceTrack(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
-                stepped = true;
+                steppedMask |= ratioTracks[r];
             }
         }
         
-        // Internal clock multiplication - generate additional steps between external clocks
-        if (!isDivision && multiplier > 1 && !clockTrig && a->lastClockPeriod[track] > 0) {
-            int subdivisionPeriod = a->lastClockPeriod[track] / multiplier;
+        if (steppedMask) {
+            a->renderTracks(busFrames, numFrames, runningMask, segmentStart, frame);
+            segmentStart = frame;
+            a->stepTracks(steppedMask);
+        }
+    }
+    
+    // Internal clock multiplication - generate additional steps between external
+    // clocks, each on the frame where its subdivision falls (in frame order)
+    if (!clockTrig) {
+        int subFrames[kNumClockRatios];
+        uint32_t subTracks[kNumClockRatios];
+        int numSubs = 0;
+        for (int r = 15; r < kNumClockRatios; r++) {
+            ClockRatio& ratio = a->ratios[r];
+            int multiplier = r - 14;
+            if (ratioTracks[r] == 0 || multiplier < 2 || ratio.lastClockPeriod <= 0) continue;
             
-            if (subdivisionPeriod > numFrames && a->samplesSinceLastClock[track] >= subdivisionPeriod * (a->internalClockCounter[track] + 1)) {
-                a->internalClockCounter[track]++;
-                if (a->internalClockCounter[track] < multiplier) {
-                    a->advanceTrack(track, direction, trackLength, splitPoint, sec1Reps, sec2Reps, fillStart);
-                    stepped = true;
+            int subdivisionPeriod = ratio.lastClockPeriod / multiplier;
+            int due = subdivisionPeriod * (ratio.internalClockCounter + 1);
+            if (subdivisionPeriod > numFrames && ratio.samplesSinceLastClock >= due) {
+                ratio.internalClockCounter++;
+                if (ratio.internalClockCounter < multiplier) {
+                    int frame = due - (ratio.samplesSinceLastClock - numFrames);
+                    if (frame < 0) frame = 0;
+                    if (frame > numFrames - 1) frame = numFrames - 1;
+                    int i = numSubs++;
+                    while (i > 0 && subFrames[i - 1] > frame) {
+                        subFrames[i] = subFrames[i - 1];
+                        subTracks[i] = subTracks[i - 1];
+                        i--;
+                    }
+                    subFrames[i] = frame;
+                    subTracks[i] = ratioTracks[r];
                 }
             }
         }
-        
-        // After potential advancement, mark if current step should trigger
-        if (stepped) {
-            int currentStep = a->currentStep[track];
-            if (currentStep >= 0 && currentStep < 32 && a->steps[track][currentStep]) {
-                // Apply swing: delay odd-numbered steps
-                bool isOddStep = (currentStep % 2) == 1;
-                int swingDelay = 0;
-                
-                if (isOddStep && swing > 0 && a->lastClockPeriod[track] > 0) {
-                    // Swing delays by percentage of half the clock period
-                    swingDelay = (a->lastClockPeriod[track] * swing) / 200;
-                }
-                
-                // If no swing delay, trigger immediately
-                if (swingDelay == 0) {
-                    a->triggerCounter[track] = 240;  // ~5ms at 48kHz
-                } else {
-                    // Set swing counter to delay the trigger
-                    a->swingCounter[track] = swingDelay;
-                }
-            }
+        for (int i = 0; i < numSubs; i++) {
+            a->renderTracks(busFrames, numFrames, runningMask, segmentStart, subFrames[i]);
+            segmentStart = subFrames[i];
+            a->stepTracks(subTracks[i]);
         }
-        
-        // Handle swing delay countdown
-        if (a->swingCounter[track] > 0) {
-            a->swingCounter[track] -= numFrames;
-            if (a->swingCounter[track] <= 0) {
-                a->swingCounter[track] = 0;
-                a->triggerCounter[track] = 240;  // Trigger now after swing delay
-            }
+    }
+    
+    a->renderTracks(busFrames, numFrames, runningMask, segmentStart, numFrames);
+    
+    // Notes left on whose pulse has ended or stopped (the track stopped running,
+    // or the queue was full), then send the block's notes in one batch
+    for (uint32_t m = a->soundingMask; m; m &= m - 1) {
+        int track = __builtin_ctz(m);
+        if (a->tracks[track].triggerCounter == 0 || !((runningMask >> track) & 1u)) {
+            a->noteOff(track, numFrames);
         }
-        
-        // Countdown trigger pulses every buffer
-        if (a->triggerCounter[track] > 0) {
-            a->triggerCounter[track] -= numFrames;
-            if (a->triggerCounter[track] < 0) {
-                a->triggerCounter[track] = 0;
-            }
+    }
+    a->sendMidiHits();
+    
+    // Internal clock output: 5V pulses starting on the exact frame of each internal pulse
+    int clockOutBus = self->v[kParamClockOut];  // 0 = none, 1-28 = bus
+    float* clockOut = (clockOutBus > 0 && clockOutBus <= 28) ? busFrames + ((clockOutBus - 1) * numFrames) : NULL;
+    int nextPulse = 0;
+    for (int frame = 0; frame < numFrames; frame++) {
+        if (nextPulse < numInternal && internalFrames[nextPulse] == frame) {
+            a->clockOutCounter = 240;  // ~5ms at 48kHz
+            nextPulse++;
         }
-        
-        // Output trigger pulse
-        if (outputBus > 0 && outputBus <= 28) {
-            bool triggerActive = a->triggerCounter[track] > 0;
-            
-            // Write to all frames in the output bus
-            float* outBus = busFrames + ((outputBus - 1) * numFrames);
-            for (int frame = 0; frame < numFrames; frame++) {
-                outBus[frame] = triggerActive ? 5.0f : 0.0f;  // 5V trigger
-            }
+        if (clockOut) {
+            clockOut[frame] = (a->clockOutCounter > 0) ? 5.0f : 0.0f;
         }
+        if (a->clockOutCounter > 0) a->clockOutCounter--;
     }
+    
+    a->sampleTime += numFrames;
 }
 
 void parameterChanged(_NT_algorithm* self, int parameterIndex) {
     // Parameters are read-only from the plugin's perspective
     // All validation and constraints must be documented for the user
-    (void)self;
-    (void)parameterIndex;
+    VTrig* a = static_cast<VTrig*>(self);
+    
+    // New seed: restart every track's random stream so the change is heard right away
+    if (parameterIndex == kParamSeed) {
+        for (int track = 0; track < a->numTracks; track++) {
+            a->tracks[track].rng.seed((uint32_t)self->v[kParamSeed], (uint32_t)track);
+        }
+    }
+    
+    // Euclid parameter or Length changed: regenerate that track at the next block
+    for (int track = 0; track < a->numTracks; track++) {
+        if (parameterIndex == trackParam(track, kParamTrack1Length) ||
+            parameterIndex == trackParam(track, kParamTrack1EuclidHits) ||
+            parameterIndex == trackParam(track, kParamTrack1EuclidRotate) ||
+            parameterIndex == trackParam(track, kParamTrack1EuclidAccent)) {
+            __atomic_fetch_or(&a->euclidDirty, 1u << track, __ATOMIC_RELEASE);
+            break;
+        }
+    }
 }
 
 bool draw(_NT_algorithm* self) {
@@ -759,11 +1994,26 @@ bool draw(_NT_algorithm* self) {
     snprintf(info, sizeof(info), "T%d S%d", a->selectedTrack + 1, a->selectedStep + 1);
     NT_drawText(0, 0, info, 255);
     
-    // Show gate state for current selection
-    bool currentGateState = a->steps[a->selectedTrack][a->selectedStep];
+    // Show gate state for current selection ("EUC" = generated, Button 4 freezes it)
+    bool currentGateState = a->hasGate(a->selectedTrack, a->selectedStep);
     NT_drawText(60, 0, currentGateState ? "ON" : "off", currentGateState ? 255 : 100);
+    if ((a->generatedTracks >> a->selectedTrack) & 1u) {
+        NT_drawText(80, 0, "EUC", 200);
+    }
+    
+    // Probability, ratchets and nudge of the selected step
+    uint16_t selectedAttr = a->tracks[a->selectedTrack].stepAttr[a->selectedStep];
+    char attrText[32];
+    snprintf(attrText, sizeof(attrText), "P%d%% R%d N%+d%%", stepProbability(selectedAttr), stepRatchets(selectedAttr),
+             (stepNudge(selectedAttr) * 100) / 64);
+    NT_drawText(100, 0, attrText, 255);
     
-    // 6 tracks × 32 steps
+    // Trig condition of the selected step (blank = always)
+    NT_drawText(200, 0, conditionNames[a->tracks[a->selectedTrack].stepCond[a->selectedStep]], 255);
+    
+    // 6 tracks × 32 steps visible at once; with more tracks the grid scrolls
+    // to follow the selected track, and with more steps it shows the 32-step
+    // page holding the selected step
     // Screen: 256px wide, 64px tall
     // Step size: 256/32 = 8px per step
     // Track height: (64-8)/6 = ~9px per track (leave 8px for title)
@@ -771,16 +2021,25 @@ bool draw(_NT_algorithm* self) {
     int stepWidth = 8;
     int trackHeight = 9;
     int startY = 8;
+    int firstStep = (a->selectedStep / kPageSteps) * kPageSteps;
     
-    for (int track = 0; track < 6; track++) {
-        int y = startY + (track * trackHeight);
+    // Page position along the bottom edge
+    int numGridPages = (a->maxSteps + kPageSteps - 1) / kPageSteps;
+    if (numGridPages > 1) {
+        int page = firstStep / kPageSteps;
+        int pageWidth = 256 / numGridPages;
+        NT_drawShapeI(kNT_line, page * pageWidth, 63, ((page + 1) * pageWidth) - 2, 63, 128);
+    }
+    
+    for (int row = 0; row < 6; row++) {
+        int track = a->firstVisibleTrack + row;
+        if (track >= a->numTracks) break;
+        int y = startY + (row * trackHeight);
         
         // Get track parameters
-        int lenParam = kParamTrack1Length + (track * 9);
-        int splitParam = kParamTrack1SplitPoint + (track * 9);
-        int trackLength = self->v[lenParam];
-        int splitPoint = self->v[splitParam];
-        int currentStep = a->currentStep[track];
+        int trackLength = self->v[trackParam(track, kParamTrack1Length)];
+        int splitPoint = self->v[trackParam(track, kParamTrack1SplitPoint)];
+        int currentStep = a->tracks[track].currentStep;
         
         // Highlight selected track with a line on the left
         if (track == a->selectedTrack) {
@@ -788,14 +2047,15 @@ bool draw(_NT_algorithm* self) {
             NT_drawShapeI(kNT_line, 1, y, 1, y + trackHeight - 1, 255);
         }
         
-        // Draw split point line if active
-        if (splitPoint > 0 && splitPoint < trackLength) {
-            int splitX = splitPoint * stepWidth;
+        // Draw split point line if active (and on this page)
+        if (splitPoint > 0 && splitPoint < trackLength &&
+            splitPoint >= firstStep && splitPoint < firstStep + kPageSteps) {
+            int splitX = (splitPoint - firstStep) * stepWidth;
             NT_drawShapeI(kNT_line, splitX, y, splitX, y + trackHeight - 1, 200);
         }
         
-        for (int step = 0; step < 32; step++) {
-            int x = step * stepWidth;
+        for (int step = firstStep; step < firstStep + kPageSteps && step < a->maxSteps; step++) {
+            int x = (step - firstStep) * stepWidth;
             
             // Determine if this step is active (within track length)
             bool isActive = (step < trackLength);
@@ -804,15 +2064,35 @@ bool draw(_NT_algorithm* self) {
             if (!isActive) continue;
             
             // Get gate state for this track/step
-            bool hasGate = a->steps[track][step];
+            bool hasGate = a->hasGate(track, step);
             
             // Calculate center position
             int centerX = x + (stepWidth / 2);
             int centerY = y + (trackHeight / 2);
             
-            // If gate is active, draw filled 5x5 square
+            // If gate is active, draw filled 5x5 square (dimmer when it might not play).
+            // On a generated track with accents, unaccented hits are a smaller 3x3 square.
             if (hasGate) {
-                NT_drawShapeI(kNT_rectangle, centerX - 2, centerY - 2, centerX + 2, centerY + 2, 255);
+                uint16_t attr = a->tracks[track].stepAttr[step];
+                int brightness = 80 + (stepProbability(attr) * 175) / 100;
+                int nudgeX = stepNudge(attr) / 16;  // Nudged steps sit up to 2px off the grid
+                int size = 2;
+                if (((a->generatedTracks >> track) & 1u) && self->v[trackParam(track, kParamTrack1EuclidAccent)] > 0 &&
+                    !((a->accentColumns[step] >> track) & 1u)) {
+                    size = 1;
+                }
+                NT_drawShapeI(kNT_rectangle, centerX - size + nudgeX, centerY - size, centerX + size + nudgeX, centerY + size, brightness);
+                
+                // Ratchets: a dot above the square for each extra hit (up to 3)
+                int extraHits = stepRatchets(attr) - 1;
+                for (int i = 0; i < extraHits && i < 3; i++) {
+                    NT_drawShapeI(kNT_rectangle, centerX - 2 + (i * 2), centerY - 4, centerX - 2 + (i * 2), centerY - 4, 255);
+                }
+                
+                // Conditional steps get a dot at the top right
+                if (a->tracks[track].stepCond[step] != kCondNone) {
+                    NT_drawShapeI(kNT_rectangle, centerX + 3, centerY - 4, centerX + 3, centerY - 4, 255);
+                }
             } else {
                 // Just draw center pixel for inactive steps
                 NT_drawShapeI(kNT_rectangle, centerX, centerY, centerX, centerY, 255);
@@ -838,34 +2118,46 @@ bool draw(_NT_algorithm* self) {
 
 uint32_t hasCustomUi(_NT_algorithm* self) {
     (void)self;
-    return kNT_encoderL | kNT_encoderR | kNT_encoderButtonR;
+    return kNT_encoderL | kNT_encoderR | kNT_encoderButtonL | kNT_encoderButtonR | kNT_potL | kNT_potC | kNT_potR | kNT_button4;
 }
 
 void handleUi(_NT_algorithm* self, const _NT_uiData& data) {
     VTrig* a = static_cast<VTrig*>(self);
     
-    // Left encoder: select track (0-5)
+    // Left encoder: select track
     if (data.encoders[0] != 0) {
         int delta = data.encoders[0];
         a->selectedTrack += delta;
         
         // Wrap around
-        if (a->selectedTrack < 0) a->selectedTrack = 5;
-        if (a->selectedTrack > 5) a->selectedTrack = 0;
+        if (a->selectedTrack < 0) a->selectedTrack = a->numTracks - 1;
+        if (a->selectedTrack >= a->numTracks) a->selectedTrack = 0;
+        
+        // Scroll the grid so the selected track stays on screen
+        if (a->selectedTrack < a->firstVisibleTrack) a->firstVisibleTrack = a->selectedTrack;
+        if (a->selectedTrack > a->firstVisibleTrack + 5) a->firstVisibleTrack = a->selectedTrack - 5;
         
         // Clamp selected step to new track's length
-        int lenParam = kParamTrack1Length + (a->selectedTrack * 9);
+        int lenParam = trackParam(a->selectedTrack, kParamTrack1Length);
         if (a->selectedStep >= self->v[lenParam]) {
             a->selectedStep = self->v[lenParam] - 1;
         }
     }
     
     // Get current track length for encoder bounds
-    int lenParam = kParamTrack1Length + (a->selectedTrack * 9);
-    int trackLength = self->v[lenParam];
+    int trackLength = self->v[trackParam(a->selectedTrack, kParamTrack1Length)];
     
+    // Left encoder button held + right encoder: trig condition of the selected step
+    if ((data.controls & kNT_encoderButtonL) && data.encoders[1] != 0) {
+        TrackState& t = a->tracks[a->selectedTrack];
+        int cond = t.stepCond[a->selectedStep] + data.encoders[1];
+        if (cond < 0) cond = 0;
+        if (cond >= kNumConditions) cond = kNumConditions - 1;
+        t.stepCond[a->selectedStep] = (uint8_t)cond;
+        __atomic_fetch_or(&a->condDirty, 1u << a->selectedTrack, __ATOMIC_RELEASE);
+    }
     // Right encoder: select step (0 to trackLength-1)
-    if (data.encoders[1] != 0) {
+    else if (data.encoders[1] != 0) {
         int delta = data.encoders[1];
         a->selectedStep += delta;
         
@@ -874,17 +2166,69 @@ void handleUi(_NT_algorithm* self, const _NT_uiData& data) {
         if (a->selectedStep >= trackLength) a->selectedStep = 0;
     }
     
+    // New step or track: pots must catch the new step's values
+    if (data.encoders[0] != 0 || data.encoders[1] != 0) {
+        a->attrPotCaught[0] = false;
+        a->attrPotCaught[1] = false;
+        a->attrPotCaught[2] = false;
+    }
+    
+    uint16_t& attr = a->tracks[a->selectedTrack].stepAttr[a->selectedStep];
+    
+    // Left pot: probability of the selected step (0-100%), with catch
+    if (data.controls & kNT_potL) {
+        int probability = (int)(data.pots[0] * 100.0f + 0.5f);
+        int distance = probability - stepProbability(attr);
+        if (!a->attrPotCaught[0] && distance >= -2 && distance <= 2) {
+            a->attrPotCaught[0] = true;
+        }
+        if (a->attrPotCaught[0]) {
+            attr = makeStepAttr(probability, stepRatchets(attr), stepNudge(attr));
+        }
+    }
+    
+    // Centre pot: ratchets of the selected step (1-8 hits), with catch
+    if (data.controls & kNT_potC) {
+        int ratchets = 1 + (int)(data.pots[1] * 7.0f + 0.5f);
+        if (!a->attrPotCaught[1] && ratchets == stepRatchets(attr)) {
+            a->attrPotCaught[1] = true;
+        }
+        if (a->attrPotCaught[1]) {
+            attr = makeStepAttr(stepProbability(attr), ratchets, stepNudge(attr));
+        }
+    }
+    
+    // Right pot: microtiming nudge of the selected step (-50% to +48% of a step), with catch
+    if (data.controls & kNT_potR) {
+        int nudge = (int)(data.pots[2] * 63.0f + 0.5f) - 32;
+        int distance = nudge - stepNudge(attr);
+        if (!a->attrPotCaught[2] && distance >= -1 && distance <= 1) {
+            a->attrPotCaught[2] = true;
+        }
+        if (a->attrPotCaught[2]) {
+            attr = makeStepAttr(stepProbability(attr), stepRatchets(attr), nudge);
+        }
+    }
+    
     // Right encoder button: toggle gate
     uint16_t currentEncoderRButton = data.controls & kNT_encoderButtonR;
     uint16_t lastEncoderRButton = a->lastEncoderRButton & kNT_encoderButtonR;
     if (currentEncoderRButton && !lastEncoderRButton) {  // Rising edge
-        // Toggle the gate
+        // Toggle the gate (a generated track is frozen first, so the edit lands
+        // on the pattern you see)
         int track = a->selectedTrack;
         int step = a->selectedStep;
-        a->steps[track][step] = !a->steps[track][step];
+        a->freezeTrack(track);
+        a->toggleGate(track, step);
+    }
+    
+    // Button 4: freeze the selected track's generated pattern into its steps
+    if ((data.controls & kNT_button4) && !(a->lastButton4State & kNT_button4)) {
+        a->freezeTrack(a->selectedTrack);
     }
     
     a->lastEncoderRButton = data.controls;
+    a->lastButton4State = data.controls;
 }
 
 // =============================================================================
@@ -894,19 +2238,56 @@ void handleUi(_NT_algorithm* self, const _NT_uiData& data) {
 void serialise(_NT_algorithm* self, _NT_jsonStream& stream) {
     VTrig* a = (VTrig*)self;
     
-    // Save all step data as 2D array [6 tracks][32 steps]
+    // Each track saves its steps up to the last one that differs from an empty
+    // step, so a long instance with short patterns saves and loads like a short one
+    
+    // Save all step data as 2D array [tracks][steps]
     stream.addMemberName("steps");
     stream.openArray();
-    for (int track = 0; track < 6; track++) {
+    for (int track = 0; track < a->numTracks; track++) {
+        int used = a->maxSteps;
+        while (used > 0 && !a->storedGate(track, used - 1)) used--;
+        stream.openArray();
+        for (int step = 0; step < used; step++) {
+            stream.addBoolean(a->storedGate(track, step));
+        }
+        stream.closeArray();
+    }
+    stream.closeArray();
+    
+    // Probability, ratchets and nudge, packed as in stepAttr
+    stream.addMemberName("stepAttr");
+    stream.openArray();
+    for (int track = 0; track < a->numTracks; track++) {
+        const uint16_t* attr = a->tracks[track].stepAttr;
+        int used = a->maxSteps;
+        while (used > 0 && attr[used - 1] == kDefaultStepAttr) used--;
+        stream.openArray();
+        for (int step = 0; step < used; step++) {
+            stream.addNumber((int)attr[step]);
+        }
+        stream.closeArray();
+    }
+    stream.closeArray();
+    
+    // Trig conditions
+    stream.addMemberName("stepCond");
+    stream.openArray();
+    for (int track = 0; track < a->numTracks; track++) {
+        const uint8_t* cond = a->tracks[track].stepCond;
+        int used = a->maxSteps;
+        while (used > 0 && cond[used - 1] == kCondNone) used--;
         stream.openArray();
-        for (int step = 0; step < 32; step++) {
-            stream.addBoolean(a->steps[track][step]);
+        for (int step = 0; step < used; step++) {
+            stream.addNumber((int)cond[step]);
         }
         stream.closeArray();
     }
     stream.closeArray();
 }
 
+// Steps past the end of a saved track are empty. Steps past this instance's
+// Max Steps are read and dropped, so the parse stays in step with the preset.
 bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
     VTrig* a = (VTrig*)self;
     
@@ -918,18 +2299,62 @@ bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
         if (parse.matchName("steps")) {
             int numTracks = 0;
             if (parse.numberOfArrayElements(numTracks)) {
-                int tracksToLoad = (numTracks < 6) ? numTracks : 6;
+                int tracksToLoad = (numTracks < a->numTracks) ? numTracks : a->numTracks;
                 for (int track = 0; track < tracksToLoad; track++) {
                     int numSteps = 0;
                     if (parse.numberOfArrayElements(numSteps)) {
-                        int stepsToLoad = (numSteps < 32) ? numSteps : 32;
-                        for (int step = 0; step < stepsToLoad; step++) {
+                        for (int step = 0; step < numSteps; step++) {
                             bool value;
-                            if (parse.boolean(value)) {
-                                a->steps[track][step] = value;
+                            if (parse.boolean(value) && step < a->maxSteps && value != a->storedGate(track, step)) {
+                                a->toggleGate(track, step);
+                            }
+                        }
+                        for (int step = numSteps; step < a->maxSteps; step++) {
+                            if (a->storedGate(track, step)) a->toggleGate(track, step);
+                        }
+                    }
+                }
+            }
+        } else if (parse.matchName("stepAttr")) {
+            int numTracks = 0;
+            if (parse.numberOfArrayElements(numTracks)) {
+                int tracksToLoad = (numTracks < a->numTracks) ? numTracks : a->numTracks;
+                for (int track = 0; track < tracksToLoad; track++) {
+                    int numSteps = 0;
+                    if (parse.numberOfArrayElements(numSteps)) {
+                        for (int step = 0; step < numSteps; step++) {
+                            int value;
+                            if (parse.number(value) && step < a->maxSteps) {
+                                int probability = value & 0x7F;
+                                if (probability > 100) probability = 100;
+                                a->tracks[track].stepAttr[step] = makeStepAttr(probability, ((value >> 7) & 0x07) + 1,
+                                                                        ((int16_t)(uint16_t)value) >> 10);
+                            }
+                        }
+                        for (int step = numSteps; step < a->maxSteps; step++) {
+                            a->tracks[track].stepAttr[step] = kDefaultStepAttr;
+                        }
+                    }
+                }
+            }
+        } else if (parse.matchName("stepCond")) {
+            int numTracks = 0;
+            if (parse.numberOfArrayElements(numTracks)) {
+                int tracksToLoad = (numTracks < a->numTracks) ? numTracks : a->numTracks;
+                for (int track = 0; track < tracksToLoad; track++) {
+                    int numSteps = 0;
+                    if (parse.numberOfArrayElements(numSteps)) {
+                        for (int step = 0; step < numSteps; step++) {
+                            int value;
+                            if (parse.number(value) && step < a->maxSteps && value >= 0 && value < kNumConditions) {
+                                a->tracks[track].stepCond[step] = (uint8_t)value;
                             }
                         }
+                        for (int step = numSteps; step < a->maxSteps; step++) {
+                            a->tracks[track].stepCond[step] = kCondNone;
+                        }
                     }
+                    __atomic_fetch_or(&a->condDirty, 1u << track, __ATOMIC_RELEASE);
                 }
             }
         } else {
@@ -941,16 +2366,62 @@ bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
     return true;
 }
 
+void midiRealtime(_NT_algorithm* self, uint8_t byte) {
+    VTrig* a = static_cast<VTrig*>(self);
+    
+    if (byte == 0xF8) {
+        a->midiClock.receiveTick();  // Timing clock (24 PPQN)
+        return;
+    }
+    
+    // Transport only applies when following MIDI clock
+    if (self->v[kParamClockSource] == 0) return;
+    
+    switch (byte) {
+        case 0xFA: a->transportStart(); break;
+        case 0xFB: a->transportContinue(); break;
+        case 0xFC: a->transportStop(); break;
+    }
+}
+
+void midiMessage(_NT_algorithm* self, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    VTrig* a = static_cast<VTrig*>(self);
+    
+    // Song Position Pointer: 14-bit count of 16th notes since song start
+    if (byte0 == 0xF2 && self->v[kParamClockSource] != 0) {
+        uint32_t position = (byte1 & 0x7F) | ((uint32_t)(byte2 & 0x7F) << 7);
+        a->seekToPosition(position);
+    }
+}
+
 // =============================================================================
 // Plugin Factory
 // =============================================================================
 
+// Specifications for algorithm initialization
+static const _NT_specification specifications[] = {
+    {
+        .name = "Tracks",
+        .min = kDefaultTracks,
+        .max = kMaxTracks,
+        .def = kDefaultTracks,
+        .type = kNT_typeGeneric
+    },
+    {
+        .name = "Max Steps",
+        .min = kMinSteps,
+        .max = kMaxSteps,
+        .def = kMinSteps,
+        .type = kNT_typeGeneric
+    }
+};
+
 static const _NT_factory factory = {
     .guid = NT_MULTICHAR('V', 'T', 'R', 'G'),
     .name = "VTrig",
-    .description = "6-Track Trigger Sequencer",
-    .numSpecifications = 0,
-    .specifications = nullptr,
+    .description = "6-16 Track Trigger Sequencer",
+    .numSpecifications = 2,
+    .specifications = specifications,
     .calculateStaticRequirements = nullptr,
     .initialise = nullptr,
     .calculateRequirements = calculateRequirements,
@@ -958,8 +2429,8 @@ static const _NT_factory factory = {
     .parameterChanged = parameterChanged,
     .step = step,
     .draw = draw,
-    .midiRealtime = nullptr,
-    .midiMessage = nullptr,
+    .midiRealtime = midiRealtime,
+    .midiMessage = midiMessage,
     .tags = kNT_tagUtility,
     .hasCustomUi = hasCustomUi,
     .customUi = handleUi,
@@ -0,0 +1,593 @@
+// Shared sequencer core for VSeq, VTrig and V3Seq.
+// The clock followers, modulation inputs, pattern generators and Song Position
+// Pointer seek used to be pasted into each plugin; they live here so a fix to
+// one of them reaches all three. Each plugin's Makefile adds ../common to the
+// include path.
+
+#ifndef SEQ_COMMON_H
+#define SEQ_COMMON_H
+
+#include <distingnt/api.h>
+#include <cstdint>
+#include <cmath>
+
+// 24 PPQN MIDI clock follower.
+// midiRealtime() only counts incoming ticks. Once per block they are spread
+// evenly across the block and every 6th tick becomes a clock pulse (16th notes).
+// USB MIDI clock arrives in bursts, so the tempo comes from a PLL that filters
+// the tick timing instead of the raw spacing between ticks.
+struct MidiClockFollower {
+    static const int kTicksPerPulse = 6;
+    
+    int pendingTicks;           // Ticks received since the last block
+    int tickCount;              // Ticks since the last pulse (0-5)
+    uint32_t time;              // Sample time at the start of the current block
+    uint32_t lastTickTime;      // Sample time given to the last tick
+    uint32_t predictedTime;     // Where the PLL expects the next tick
+    float tickPeriod;           // Filtered samples per tick
+    bool haveTick;              // lastTickTime is valid
+    bool locked;                // PLL has a period estimate
+    
+    MidiClockFollower() {
+        pendingTicks = 0;
+        tickCount = 0;
+        time = 0;
+        lastTickTime = 0;
+        predictedTime = 0;
+        tickPeriod = 200.0f;  // 120 BPM at 48kHz
+        haveTick = false;
+        locked = false;
+    }
+    
+    void receiveTick() {
+        pendingTicks++;
+    }
+    
+    // Start/Continue/Song Position: the next tick is on a 16th note boundary
+    void restart() {
+        pendingTicks = 0;
+        tickCount = 0;
+    }
+    
+    // Feed one tick at sample time t through the PLL
+    void trackTick(uint32_t t) {
+        const float kAlpha = 0.1f;    // Phase correction gain
+        const float kBeta = 0.005f;   // Period correction gain
+        float minPeriod = NT_globals.sampleRate / 400.0f;  // 1000 BPM
+        float maxPeriod = NT_globals.sampleRate / 4.0f;    // 10 BPM
+        
+        // Clock stopped for a while: start over
+        if (haveTick && (float)(t - lastTickTime) > maxPeriod) {
+            locked = false;
+        }
+        
+        if (!locked) {
+            if (haveTick) {
+                float measured = (float)(t - lastTickTime);
+                if (measured < minPeriod) measured = minPeriod;
+                tickPeriod = measured;
+                predictedTime = t + (uint32_t)measured;
+                locked = true;
+            }
+        } else {
+            // Phase error, clamped so a burst of ticks cannot yank the tempo
+            float err = (float)(int32_t)(t - predictedTime);
+            if (err > tickPeriod) err = tickPeriod;
+            if (err < -tickPeriod) err = -tickPeriod;
+            
+            tickPeriod += kBeta * err;
+            if (tickPeriod < minPeriod) tickPeriod = minPeriod;
+            if (tickPeriod > maxPeriod) tickPeriod = maxPeriod;
+            predictedTime += (int32_t)(tickPeriod + (kAlpha * err) + 0.5f);
+        }
+        
+        lastTickTime = t;
+        haveTick = true;
+    }
+    
+    // Spread this block's ticks evenly over its frames.
+    // Writes the frame of each clock pulse to pulseFrames and returns how many there were.
+    int process(int numFrames, int* pulseFrames, int maxPulses) {
+        int n = pendingTicks;
+        pendingTicks = 0;
+        
+        int pulses = 0;
+        for (int i = 0; i < n; i++) {
+            int frame = (i * numFrames) / n;
+            trackTick(time + frame);
+            if (tickCount == 0 && pulses < maxPulses) {
+                pulseFrames[pulses++] = frame;
+            }
+            tickCount = (tickCount + 1) % kTicksPerPulse;
+        }
+        
+        time += numFrames;
+        return pulses;
+    }
+    
+    // Filtered samples per clock pulse
+    int pulsePeriod() const {
+        return (int)(tickPeriod * kTicksPerPulse);
+    }
+};
+
+// Free-running internal clock.
+// The phase accumulator is double precision (in pulses), so the tempo holds
+// over hours of running instead of drifting by a rounded samples-per-pulse.
+struct InternalClock {
+    double phase;               // Progress towards the next pulse at the start of the block (1.0 = due)
+    bool active;                // Currently driving the sequencer
+    
+    InternalClock() {
+        phase = 1.0;
+        active = false;
+    }
+    
+    // Samples per pulse; bpm10 is tenths of a BPM, ppqn is pulses per quarter note
+    static double period(int bpm10, int ppqn) {
+        return (600.0 * NT_globals.sampleRate) / ((double)bpm10 * ppqn);
+    }
+    
+    // Line the first pulse up with a frame of the coming block
+    void startAt(int frame, int bpm10, int ppqn) {
+        phase = 1.0 - (frame / period(bpm10, ppqn));
+    }
+    
+    // Advance by one block. Writes the frame of each pulse to pulseFrames and
+    // returns how many there were.
+    int process(int numFrames, int bpm10, int ppqn, int* pulseFrames, int maxPulses) {
+        double increment = 1.0 / period(bpm10, ppqn);
+        int pulses = 0;
+        for (;;) {
+            // First frame at which the phase reaches 1
+            double remaining = 1.0 - phase;
+            int frame = (remaining <= 0.0) ? 0 : (int)ceil(remaining / increment);
+            if (frame >= numFrames) break;
+            if (pulses < maxPulses) {
+                pulseFrames[pulses++] = frame;
+            }
+            phase -= 1.0;
+        }
+        phase += numFrames * increment;
+        return pulses;
+    }
+};
+
+// Most clock ticks taken from one source in one block
+static const int kMaxTicks = 8;
+
+// Find the rising edges of a clock input (crossing threshold) and write their
+// frames to edgeFrames. last is the input at the end of the previous block and
+// is updated for the next one. Returns how many edges were found.
+static inline int findClockEdges(const float* in, int numFrames, float threshold, float& last,
+                                 int* edgeFrames, int maxEdges) {
+    int edges = 0;
+    float prev = last;
+    for (int frame = 0; frame < numFrames; frame++) {
+        if (in[frame] > threshold && prev <= threshold && edges < maxEdges) {
+            edgeFrames[edges++] = frame;
+        }
+        prev = in[frame];
+    }
+    last = prev;
+    return edges;
+}
+
+// Step capacity, chosen by the "Max Steps" specification. The grid shows one
+// page of 32 steps at a time.
+static const int kMinSteps = 32;
+static const int kMaxSteps = 128;
+static const int kPageSteps = 32;
+
+// Steps of a pattern as bits, step 0 in bit 0 of the first word
+struct StepBits {
+    uint32_t w[kMaxSteps / 32];
+    
+    void clear() {
+        for (int i = 0; i < kMaxSteps / 32; i++) w[i] = 0;
+    }
+    bool get(int step) const {
+        return (w[step >> 5] >> (step & 31)) & 1u;
+    }
+    void set(int step) {
+        w[step >> 5] |= 1u << (step & 31);
+    }
+    int count() const {
+        int n = 0;
+        for (int i = 0; i < kMaxSteps / 32; i++) n += __builtin_popcount(w[i]);
+        return n;
+    }
+    // OR in the first len steps of src, starting at step pos
+    void place(const StepBits& src, int len, int pos) {
+        for (int i = 0; i < len; i++) {
+            if (src.get(i)) set(pos + i);
+        }
+    }
+};
+
+// Euclidean rhythm (Bjorklund's algorithm): `hits` onsets spread as evenly as
+// possible over `steps` steps. Strings of identical groups are paired off until
+// at most one remainder group is left; all groups of a kind are the same
+// string, so only one of each is kept. The result starts on a hit (E(3,8) = x..x..x.).
+static inline void euclidPattern(StepBits& out, int hits, int steps) {
+    out.clear();
+    if (steps <= 0 || hits <= 0) return;
+    if (steps > kMaxSteps) steps = kMaxSteps;
+    if (hits >= steps) {
+        for (int i = 0; i < steps; i++) out.set(i);
+        return;
+    }
+    
+    StepBits a, b;              // Group strings, first step in bit 0
+    a.clear();
+    b.clear();
+    a.set(0);
+    int lenA = 1, lenB = 1;
+    int countA = hits, countB = steps - hits;
+    while (countB > 1) {
+        int pairs = (countA < countB) ? countA : countB;
+        StepBits joined = a;
+        joined.place(b, lenB, lenA);
+        int joinedLen = lenA + lenB;
+        if (countA > countB) {
+            // Unpaired A groups become the remainder
+            b = a;
+            lenB = lenA;
+        }
+        countB = (countA > countB) ? countA - pairs : countB - pairs;
+        a = joined;
+        lenA = joinedLen;
+        countA = pairs;
+    }
+    
+    int pos = 0;
+    for (int i = 0; i < countA; i++, pos += lenA) out.place(a, lenA, pos);
+    for (int i = 0; i < countB; i++, pos += lenB) out.place(b, lenB, pos);
+}
+
+// Move a pattern of `steps` steps `rotate` steps later, wrapping at the end
+static inline void rotateSteps(StepBits& bits, int steps, int rotate) {
+    if (steps <= 0 || steps > kMaxSteps) return;
+    int r = rotate % steps;
+    if (r == 0) return;
+    StepBits from = bits;
+    bits.clear();
+    for (int i = 0; i < steps; i++) {
+        if (from.get(i)) bits.set((i + r) % steps);
+    }
+}
+
+// xorshift32: tiny, fast and real-time safe. Each track or sequencer has its
+// own, so a given seed always plays the same way from reset.
+struct XorShift32 {
+    uint32_t state;
+    
+    XorShift32() : state(0x9E3779B9u) {}
+    
+    void seed(uint32_t s) {
+        state = s ? s : 0x9E3779B9u;  // Zero would stick at zero
+    }
+    
+    // Seed one of several streams (a track) from a user Seed. The pair is hashed
+    // with splitmix32, so neighbouring Seeds and tracks start far apart and even
+    // the first number of each stream is well spread; no track of one Seed shares
+    // a stream with another track of a different Seed.
+    void seed(uint32_t userSeed, uint32_t stream) {
+        seed(splitmix32(splitmix32(userSeed) ^ stream));
+    }
+    
+    // splitmix32 finaliser: a bijection that spreads every input bit over the word
+    static uint32_t splitmix32(uint32_t x) {
+        x += 0x9E3779B9u;
+        x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+        x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+        return x ^ (x >> 16);
+    }
+    
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+// Modulation inputs: up to 4 CV inputs, each moving one playback setting by a
+// whole number of units. Each plugin lists its own targets.
+static const int kNumModInputs = 4;
+
+// Hysteresis of the modulation inputs, in units of the target (steps, clock
+// ratios, semitones, swing %). An offset only moves once the input is this far
+// past the halfway point to the next value, so a noisy CV sitting near a
+// boundary does not flip the playback order back and forth every block.
+static const float kModHysteresis = 0.25f;
+
+// One modulation input: the block mean of its CV, held as a whole-number offset
+struct ModInput {
+    int offset;                 // Held offset in target units (0 while unassigned)
+    
+    ModInput() : offset(0) {}
+    
+    // Mean of one block of an input bus, in volts
+    static float mean(const float* in, int numFrames) {
+        float sum = 0.0f;
+        for (int i = 0; i < numFrames; i++) sum += in[i];
+        return sum / numFrames;
+    }
+    
+    // New input position in target units: the offset follows it once it leaves
+    // the hysteresis band around the held value
+    void update(float units) {
+        if (units < offset + 0.5f + kModHysteresis && units > offset - 0.5f - kModHysteresis) return;
+        offset = (int)floorf(units + 0.5f);
+    }
+};
+
+// One run of passes through consecutive steps of a track's loop
+struct LoopSegment {
+    int first;              // Step of the first state in each pass
+    int length;             // States per pass
+    int delta;              // +1 forward, -1 backward
+    int passes;             // Number of passes
+    int counter;            // Section repeat counter during the first pass (+1 per pass)
+    bool inSection2;
+    bool pingpongForward;
+};
+
+// Playback state of a track after some number of advances from reset
+struct LoopState {
+    int step;
+    int section1Counter;
+    int section2Counter;
+    bool inSection2;
+    bool pingpongForward;
+    uint32_t passes;        // Passes completed (walkTrack wraps), for trig conditions
+};
+
+// A track's whole loop structure laid out from reset: segments before cycleStart
+// play once, the rest repeat forever. Song Position Pointer uses this to seek
+// arithmetically, so jumping to bar 500 costs the same as bar 1.
+struct LoopPlan {
+    LoopSegment segs[6];
+    int count;
+    int cycleStart;
+    bool leadInJoins;       // The first segment runs on into the second without a wrap
+    
+    LoopPlan() : count(0), cycleStart(0), leadInJoins(false) {}
+    
+    void add(int first, int length, int delta, int passes, int counter,
+             bool inSection2, bool pingpongForward = true) {
+        if (count >= 6 || passes <= 0 || length <= 0) return;
+        LoopSegment& s = segs[count++];
+        s.first = first;
+        s.length = length;
+        s.delta = delta;
+        s.passes = passes;
+        s.counter = counter;
+        s.inSection2 = inSection2;
+        s.pingpongForward = pingpongForward;
+    }
+    
+    // Segments added after this repeat
+    void startCycle() {
+        cycleStart = count;
+    }
+    
+    // True if a track in this state is on the first step of the repeating cycle,
+    // i.e. its last advance wrapped the loop
+    bool isCycleStart(int step, int section1Counter, int section2Counter,
+                      bool inSection2, bool pingpongForward) const {
+        if (cycleStart >= count) return false;
+        const LoopSegment& s = segs[cycleStart];
+        int counter = s.inSection2 ? section2Counter : section1Counter;
+        return step == s.first && counter == s.counter &&
+               inSection2 == s.inSection2 && pingpongForward == s.pingpongForward;
+    }
+    
+    // Every pass of every segment ends in a wrap, except a lead-in that joins on
+    LoopState seek(uint32_t advances) const {
+        LoopState st = { 0, 0, 0, false, true, 0 };
+        uint32_t n = advances;
+        uint32_t passes = 0;
+        
+        for (int i = 0; i < count; i++) {
+            if (i == cycleStart) {
+                uint32_t cycleLength = 0;
+                uint32_t cyclePasses = 0;
+                for (int j = cycleStart; j < count; j++) {
+                    cycleLength += (uint32_t)(segs[j].length * segs[j].passes);
+                    cyclePasses += (uint32_t)segs[j].passes;
+                }
+                if (cycleLength == 0) break;
+                passes += (n / cycleLength) * cyclePasses;
+                n %= cycleLength;
+            }
+            
+            const LoopSegment& s = segs[i];
+            uint32_t segmentLength = (uint32_t)(s.length * s.passes);
+            if (n < segmentLength) {
+                int pass = (int)(n / s.length);
+                int index = (int)(n % s.length);
+                st.step = s.first + (s.delta * index);
+                st.inSection2 = s.inSection2;
+                st.pingpongForward = s.pingpongForward;
+                if (s.inSection2) {
+                    st.section2Counter = s.counter + pass;
+                } else {
+                    st.section1Counter = s.counter + pass;
+                }
+                st.passes = passes + (uint32_t)pass;
+                if (leadInJoins && st.passes > 0) st.passes--;
+                return st;
+            }
+            n -= segmentLength;
+            passes += (uint32_t)s.passes;
+        }
+        return st;
+    }
+};
+
+// Lay out a VSeq CV sequencer's loop, mirroring VSeq::advanceSequencer() from
+// reset (step 0)
+static inline void buildCvLoop(LoopPlan& plan, int direction, int stepCount, int splitPoint,
+                               int sec1Reps, int sec2Reps) {
+    if (direction == 2) {
+        // Pingpong ignores sections. Without sections the end steps play twice,
+        // with sections only the last step does.
+        plan.startCycle();
+        plan.add(0, stepCount, 1, 1, 0, false, true);
+        if (splitPoint >= stepCount) {
+            plan.add(stepCount - 1, stepCount, -1, 1, 0, false, false);
+        } else {
+            plan.add(stepCount - 1, stepCount - 1, -1, 1, 0, false, false);
+        }
+        return;
+    }
+    
+    if (splitPoint >= stepCount) {
+        if (direction == 0) {
+            plan.startCycle();
+            plan.add(0, stepCount, 1, 1, 0, false);
+        } else {
+            plan.add(0, 1, -1, 1, 0, false);
+            plan.startCycle();
+            plan.add(stepCount - 1, stepCount, -1, 1, 0, false);
+        }
+        return;
+    }
+    
+    int sec2Length = stepCount - splitPoint;
+    if (direction == 0) {
+        plan.startCycle();
+        plan.add(0, splitPoint, 1, sec1Reps, 0, false);
+        plan.add(splitPoint, sec2Length, 1, sec2Reps, 0, true);
+    } else {
+        // Reset leaves us on the last step of the first section 1 pass
+        plan.add(0, 1, -1, 1, 0, false);
+        plan.startCycle();
+        plan.add(splitPoint - 1, splitPoint, -1, sec1Reps - 1, 1, false);
+        plan.add(stepCount - 1, sec2Length, -1, sec2Reps, 0, true);
+        plan.add(splitPoint - 1, splitPoint, -1, 1, 0, false);
+    }
+}
+
+// Lay out a trigger track's loop (VSeq gate track or VTrig track), mirroring
+// VSeq::advanceGateSequencer() and VTrig::walkTrack() from reset (step 0)
+static inline void buildTrackLoop(LoopPlan& plan, int direction, int trackLength, int splitPoint,
+                                  int sec1Reps, int sec2Reps, int fillStart) {
+    if (direction == 2) {
+        // Pingpong ignores sections and does not repeat the end steps
+        if (trackLength == 1) {
+            plan.startCycle();
+            plan.add(0, 1, 1, 1, 0, false, true);
+            plan.add(0, 1, -1, 1, 0, false, false);
+        } else {
+            // Step 0 after reset is part of the first sweep up
+            plan.add(0, 1, 1, 1, 0, false, true);
+            plan.leadInJoins = true;
+            plan.startCycle();
+            plan.add(1, trackLength - 1, 1, 1, 0, false, true);
+            plan.add(trackLength - 2, trackLength - 1, -1, 1, 0, false, false);
+        }
+        return;
+    }
+    
+    if (splitPoint >= trackLength) {
+        if (direction == 0) {
+            plan.startCycle();
+            plan.add(0, trackLength, 1, 1, 0, false);
+        } else {
+            plan.add(0, 1, -1, 1, 0, false);
+            plan.startCycle();
+            plan.add(trackLength - 1, trackLength, -1, 1, 0, false);
+        }
+        return;
+    }
+    
+    // Split 0 means section 1 is the whole track
+    int section1End = (splitPoint > 0) ? splitPoint : trackLength;
+    int sec2Length = trackLength - splitPoint;
+    
+    if (direction == 0) {
+        // The fill cuts the last section 1 pass short at the fill step
+        bool fill = (splitPoint > 0 && fillStart > 0 && fillStart < splitPoint && sec1Reps > 1);
+        plan.startCycle();
+        plan.add(0, section1End, 1, sec1Reps - 1, 0, false);
+        plan.add(0, fill ? fillStart : section1End, 1, 1, sec1Reps - 1, false);
+        plan.add(splitPoint, sec2Length, 1, sec2Reps, 0, true);
+    } else {
+        // Reset leaves us on the last step of the first section 1 pass
+        plan.add(0, 1, -1, 1, 0, false);
+        plan.startCycle();
+        plan.add(section1End - 1, section1End, -1, sec1Reps - 1, 1, false);
+        plan.add(trackLength - 1, sec2Length, -1, sec2Reps, 0, true);
+        plan.add(section1End - 1, section1End, -1, 1, 0, false);
+    }
+}
+
+// Lay out the V3Seq sequencer's loop from the first step, mirroring
+// V3Seq::advanceSequencer() followed by the First/Last Step clamp in step()
+static inline void buildLoop(LoopPlan& plan, int direction, int firstStep, int lastStep, int splitPoint,
+                             int sec1Reps, int sec2Reps) {
+    int startIndex = firstStep - 1;
+    int endIndex = lastStep - 1;
+    int stepCount = (endIndex - startIndex) + 1;
+    
+    if (direction == 2) {
+        // Pingpong ignores sections and plays both end steps twice
+        plan.startCycle();
+        plan.add(startIndex, stepCount, 1, 1, 0, false, true);
+        plan.add(endIndex, stepCount, -1, 1, 0, false, false);
+        return;
+    }
+    
+    if (splitPoint >= lastStep) {
+        if (direction == 0) {
+            plan.startCycle();
+            plan.add(startIndex, stepCount, 1, 1, 0, false);
+        } else {
+            plan.add(startIndex, 1, -1, 1, 0, false);
+            plan.startCycle();
+            plan.add(endIndex, stepCount, -1, 1, 0, false);
+        }
+        return;
+    }
+    
+    if (direction == 0) {
+        // A split at or before the first step leaves section 1 a single step
+        int sec1Length = splitPoint - startIndex;
+        if (sec1Length < 1) sec1Length = 1;
+        
+        // The first section 2 pass continues from where section 1 stopped;
+        // repeats restart at the split point (clamped up to the first step)
+        int sec2First = startIndex + sec1Length;
+        if (sec2First > endIndex) sec2First = endIndex;
+        int sec2Repeat = (splitPoint > startIndex) ? splitPoint : startIndex;
+        
+        plan.startCycle();
+        plan.add(startIndex, sec1Length, 1, sec1Reps, 0, false);
+        plan.add(sec2First, (endIndex - sec2First) + 1, 1, 1, 0, true);
+        plan.add(sec2Repeat, (endIndex - sec2Repeat) + 1, 1, sec2Reps - 1, 1, true);
+    } else {
+        int sec1First = (splitPoint - 1 > startIndex) ? splitPoint - 1 : startIndex;
+        int sec1Length = (sec1First - startIndex) + 1;
+        
+        // Reset leaves us on the last step of the first section 1 pass
+        plan.add(startIndex, 1, -1, 1, 0, false);
+        
+        if (splitPoint < startIndex) {
+            // Section 2 can never get below the split point, so it parks on the first step
+            plan.add(sec1First, sec1Length, -1, sec1Reps - 1, 1, false);
+            plan.add(endIndex, stepCount, -1, 1, 0, true);
+            plan.startCycle();
+            plan.add(startIndex, 1, -1, 1, 0, true);
+        } else {
+            plan.startCycle();
+            plan.add(sec1First, sec1Length, -1, sec1Reps - 1, 1, false);
+            plan.add(endIndex, (endIndex - splitPoint) + 1, -1, sec2Reps, 0, true);
+            plan.add(sec1First, sec1Length, -1, 1, 0, false);
+        }
+    }
+}
+
+#endif // SEQ_COMMON_H